@@ -33,6 +33,8 @@
 
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/OptionsTest.o" =>
     "test/cxx/Core/ApplicationPool/OptionsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/DemandPredictorTest.o" =>
+    "test/cxx/Core/ApplicationPool/DemandPredictorTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/ProcessTest.o" =>
     "test/cxx/Core/ApplicationPool/ProcessTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/PoolTest.o" =>
@@ -55,6 +57,8 @@
     "test/cxx/ServerKit/FileBufferedChannelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HeaderTableTest.o" =>
     "test/cxx/ServerKit/HeaderTableTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/TimerWheelTest.o" =>
+    "test/cxx/ServerKit/TimerWheelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ServerTest.o" =>
     "test/cxx/ServerKit/ServerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpServerTest.o" =>
@@ -110,8 +114,14 @@
     "test/cxx/DateParsingTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/UtilsTest.o" =>
     "test/cxx/UtilsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Algorithms/FindMinimumTest.o" =>
+    "test/cxx/Algorithms/FindMinimumTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Utils/StrIntUtilsTest.o" =>
     "test/cxx/Utils/StrIntUtilsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Utils/ShardedSharedMutexTest.o" =>
+    "test/cxx/Utils/ShardedSharedMutexTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ProcessManagement/ChildReaperTest.o" =>
+    "test/cxx/ProcessManagement/ChildReaperTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/IOUtilsTest.o" =>
     "test/cxx/IOUtilsTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/TemplateTest.o" =>
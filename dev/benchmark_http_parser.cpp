@@ -0,0 +1,143 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long http_parser takes to parse a typical browser request
+ * header, including downcasing the header names like HttpHeaderParser does.
+ *
+ * Compile from the source root with:
+ *
+ *   g++ -O2 -Isrc/cxx_supportlib -Isrc/cxx_supportlib/vendor-modified \
+ *     dev/benchmark_http_parser.cpp \
+ *     src/cxx_supportlib/ServerKit/http_parser.cpp \
+ *     src/cxx_supportlib/Utils/StrIntUtilsNoStrictAliasing.cpp \
+ *     -o /tmp/benchmark_http_parser
+ *
+ * Add -U__SSE2__ to the compiler flags to measure the scalar code paths
+ * instead of the SSE2 ones.
+ *
+ * Usage: benchmark_http_parser [ITERATIONS]
+ */
+
+#include <ServerKit/http_parser.h>
+#include <Utils/StrIntUtils.h>
+#include <sys/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+using namespace Passenger;
+
+static char lowerCaseBuffer[1024];
+static size_t headerBytes = 0;
+
+static int
+onHeaderField(http_parser *parser, const char *data, size_t len) {
+	if (len > sizeof(lowerCaseBuffer)) {
+		len = sizeof(lowerCaseBuffer);
+	}
+	convertLowerCase((const unsigned char *) data,
+		(unsigned char *) lowerCaseBuffer, len);
+	headerBytes += len;
+	return 0;
+}
+
+static int
+onData(http_parser *parser, const char *data, size_t len) {
+	headerBytes += len;
+	return 0;
+}
+
+static string
+createRequest() {
+	string cookie;
+	while (cookie.size() < 2400) {
+		cookie.append("_session_id_");
+		cookie.append(1, (char) ('a' + cookie.size() % 26));
+		cookie.append("=4f0e5bd0c9e14c2ab2f7d3a8e5c1b6d94f0e5bd0c9e14c2a; ");
+	}
+
+	return "GET /products/12345/reviews?page=2&sort=newest&utm_source=newsletter HTTP/1.1\r\n"
+		"Host: www.example.com\r\n"
+		"Connection: keep-alive\r\n"
+		"Cache-Control: max-age=0\r\n"
+		"Upgrade-Insecure-Requests: 1\r\n"
+		"User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 "
+			"(KHTML, like Gecko) Chrome/61.0.3163.100 Safari/537.36\r\n"
+		"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,"
+			"image/webp,image/apng,*/*;q=0.8\r\n"
+		"Referer: https://www.example.com/products/12345?ref=search\r\n"
+		"Accept-Encoding: gzip, deflate, br\r\n"
+		"Accept-Language: en-US,en;q=0.9,nl;q=0.8\r\n"
+		"Cookie: " + cookie + "\r\n"
+		"\r\n";
+}
+
+static double
+now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+int
+main(int argc, char *argv[]) {
+	unsigned int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+	string request = createRequest();
+	http_parser_settings settings;
+	http_parser parser;
+
+	memset(&settings, 0, sizeof(settings));
+	settings.on_url = onData;
+	settings.on_header_field = onHeaderField;
+	settings.on_header_value = onData;
+
+	double start = now();
+	for (unsigned int i = 0; i < iterations; i++) {
+		http_parser_init(&parser, HTTP_REQUEST);
+		size_t parsed = http_parser_execute(&parser, &settings,
+			request.data(), request.size());
+		if (parsed != request.size() || HTTP_PARSER_ERRNO(&parser) != HPE_OK) {
+			fprintf(stderr, "Parse error: %s\n",
+				http_errno_description(HTTP_PARSER_ERRNO(&parser)));
+			return 1;
+		}
+	}
+	double elapsed = now() - start;
+
+	printf("Request size    : %u bytes\n", (unsigned int) request.size());
+	#ifdef __SSE2__
+		printf("Code paths      : SSE2\n");
+	#else
+		printf("Code paths      : scalar\n");
+	#endif
+	printf("Iterations      : %u\n", iterations);
+	printf("Time per request: %.3f usec\n", elapsed * 1000000 / iterations);
+	printf("Throughput      : %.1f MB/sec\n",
+		(double) headerBytes / elapsed / 1024 / 1024);
+	return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Compares the libev and io_uring I/O engines of ServerKit (see
+ * `--io-engine`). For each engine, a ServerKit server accepts a number of
+ * concurrent clients over a Unix domain socket. Each client sends a fixed
+ * amount of data in small writes, and the server discards what it reads.
+ * This exercises the accept and read paths, which are the parts that the
+ * io_uring engine replaces.
+ *
+ * Build the Passenger test suite first (`rake test:cxx`) so that the
+ * libraries exist, then compile from the source root with:
+ *
+ *   g++ -O2 -Isrc/cxx_supportlib -Isrc/cxx_supportlib/vendor-copy \
+ *     -Isrc/cxx_supportlib/vendor-modified \
+ *     -Isrc/cxx_supportlib/vendor-modified/libev \
+ *     -Isrc/cxx_supportlib/vendor-copy/libuv/include \
+ *     dev/benchmark_io_engine.cpp src/cxx_supportlib/BackgroundEventLoop.cpp \
+ *     $(find buildout/common/libpassenger_common -name '*.o') \
+ *     buildout/common/libboost_oxt.a buildout/libev/.libs/libev.a \
+ *     buildout/libuv/.libs/libuv.a -lcrypto -lpthread -lrt -ldl \
+ *     -o /tmp/benchmark_io_engine
+ *
+ * Usage: benchmark_io_engine [CLIENTS] [MBYTES_PER_CLIENT] [WRITE_SIZE]
+ */
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/initialize.hpp>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Server.h>
+#include <LoggingKit/LoggingKit.h>
+#include <LoggingKit/Context.h>
+#include <FileDescriptor.h>
+#include <Utils/IOUtils.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+class DiscardServer: public Server<Client> {
+protected:
+	virtual Channel::Result onClientDataReceived(Client *client,
+		const MemoryKit::mbuf &buffer, int errcode)
+	{
+		if (errcode != 0 || buffer.empty()) {
+			disconnect(&client);
+		} else {
+			bytesReceived.fetch_add(buffer.size(), boost::memory_order_relaxed);
+		}
+		return Channel::Result(buffer.size(), false);
+	}
+
+public:
+	boost::atomic<unsigned long long> bytesReceived;
+
+	DiscardServer(Context *ctx, const ServerKit::BaseServerSchema &schema)
+		: Server<Client>(ctx, schema),
+		  bytesReceived(0)
+		{ }
+};
+
+static const char *socketFilename = "/tmp/passenger-benchmark-io-engine.sock";
+
+static double
+now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void
+sendData(int fd, unsigned long long total, unsigned int writeSize) {
+	string data(writeSize, 'x');
+	while (total > 0) {
+		size_t size = (total < writeSize) ? total : writeSize;
+		writeExact(fd, data.data(), size);
+		total -= size;
+	}
+}
+
+static void
+destroyServer(boost::scoped_ptr<DiscardServer> *server) {
+	server->reset();
+}
+
+static void
+getServerState(DiscardServer *server, DiscardServer::State *result) {
+	*result = server->serverState;
+}
+
+static bool
+benchmark(bool ioUring, unsigned int clients, unsigned long long bytesPerClient,
+	unsigned int writeSize)
+{
+	BackgroundEventLoop bg(false, true);
+	ServerKit::Context context(bg.safe, bg.libuv_loop);
+	ServerKit::BaseServerSchema schema;
+	boost::scoped_ptr<DiscardServer> server;
+	string error;
+
+	if (ioUring && !context.enableIoUring(&error)) {
+		printf("%-9s: not available: %s\n", "io_uring", error.c_str());
+		return false;
+	}
+
+	unlink(socketFilename);
+	FileDescriptor serverFd(createUnixServer(socketFilename, 1024), NULL, 0);
+	server.reset(new DiscardServer(&context, schema));
+	server->initialize();
+	server->listen(serverFd);
+	bg.start();
+
+	vector<FileDescriptor> fds;
+	boost::thread_group writers;
+	unsigned long long expected = (unsigned long long) clients * bytesPerClient;
+	double start = now();
+
+	for (unsigned int i = 0; i < clients; i++) {
+		fds.push_back(FileDescriptor(connectToUnixServer(socketFilename,
+			__FILE__, __LINE__), NULL, 0));
+		writers.create_thread(boost::bind(sendData, (int) fds.back(),
+			bytesPerClient, writeSize));
+	}
+	writers.join_all();
+	while (server->bytesReceived.load(boost::memory_order_relaxed) < expected) {
+		usleep(100);
+	}
+	double elapsed = now() - start;
+
+	fds.clear();
+	bg.safe->runSync(boost::bind(&DiscardServer::shutdown, server.get(), true));
+	DiscardServer::State state;
+	do {
+		usleep(1000);
+		bg.safe->runSync(boost::bind(getServerState, server.get(), &state));
+	} while (state != DiscardServer::FINISHED_SHUTDOWN);
+	bg.safe->runSync(boost::bind(destroyServer, &server));
+	bg.stop();
+	unlink(socketFilename);
+
+	printf("%-9s: %.3f sec, %.1f MB/sec, %.0f writes of %u bytes/sec\n",
+		ioUring ? "io_uring" : "libev", elapsed,
+		(double) expected / elapsed / 1024 / 1024,
+		(double) expected / writeSize / elapsed, writeSize);
+	return true;
+}
+
+int
+main(int argc, char *argv[]) {
+	unsigned int clients = (argc > 1) ? atoi(argv[1]) : 64;
+	unsigned long long bytesPerClient = ((argc > 2) ? atoi(argv[2]) : 16) * 1024ull * 1024;
+	unsigned int writeSize = (argc > 3) ? atoi(argv[3]) : 1024;
+
+	LoggingKit::initialize();
+	LoggingKit::setLevel(LoggingKit::CRIT);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+
+	printf("Clients        : %u\n", clients);
+	printf("Data per client: %llu MB\n", bytesPerClient / 1024 / 1024);
+	printf("Write size     : %u bytes\n", writeSize);
+	benchmark(false, clients, bytesPerClient, writeSize);
+	benchmark(true, clients, bytesPerClient, writeSize);
+	return 0;
+}
@@ -42,6 +42,21 @@ namespace ApplicationPool2 {
  */
 class AbstractSession {
 public:
+	enum InitiateStatus {
+		/** The session is initiated and fd() may be used for I/O. */
+		INITIATED,
+		/**
+		 * A connection attempt is pending. Call continueInitiate() once
+		 * fd() becomes writable.
+		 */
+		INITIATE_WAIT_WRITABLE,
+		/**
+		 * The app is not accepting connections right now, e.g. because its
+		 * accept backlog is full. Call continueInitiate() after a short delay.
+		 */
+		INITIATE_RETRY_LATER
+	};
+
 	virtual ~AbstractSession() {}
 
 	virtual void ref() const = 0;
@@ -57,6 +72,21 @@ public:
 
 	virtual void initiate(bool blocking = true) = 0;
 
+	/**
+	 * Initiates the session in non-blocking mode, without ever blocking the
+	 * calling thread. Unless INITIATED is returned, the caller must drive the
+	 * connection attempt with continueInitiate() as indicated by the returned
+	 * status. Closing the session aborts the connection attempt.
+	 */
+	virtual InitiateStatus beginInitiate() {
+		initiate(false);
+		return INITIATED;
+	}
+
+	virtual InitiateStatus continueInitiate() {
+		return INITIATED;
+	}
+
 	virtual void requestOOBW() { /* Do nothing */ }
 
 	/**
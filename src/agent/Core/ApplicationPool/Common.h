@@ -36,6 +36,8 @@
 #include <StaticString.h>
 #include <MemoryKit/palloc.h>
 #include <DataStructures/StringKeyTable.h>
+#include <Utils/Lock.h>
+#include <Utils/ShardedSharedMutex.h>
 #include <Utils/VariantMap.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/Config.h>
@@ -172,6 +174,12 @@ typedef StringKeyTable<GroupPtr> GroupMap;
 typedef boost::function<void (const ProcessPtr &process, DisableResult result)> DisableCallback;
 typedef boost::function<void ()> Callback;
 
+/** Lock types for Pool::syncher. */
+typedef boost::unique_lock<ShardedSharedMutex> PoolScopedLock;
+typedef boost::lock_guard<ShardedSharedMutex> PoolLockGuard;
+typedef boost::shared_lock<ShardedSharedMutex> PoolSharedLock;
+typedef GenericDynamicScopedLock<ShardedSharedMutex> PoolDynamicScopedLock;
+
 struct GetCallback {
 	void (*func)(const AbstractSessionPtr &session, const ExceptionPtr &e, void *userData);
 	mutable void *userData;
@@ -197,6 +205,35 @@ struct GetWaiter {
 	}
 };
 
+/**
+ * A per-thread routing hint for Pool::asyncGet(). It remembers which process
+ * the owning thread last checked out a session from, so that the next request
+ * from that thread is routed to the same process for as long as that process
+ * is idle. Because an idle process always has the lowest busyness, this does
+ * not change the load balancing behavior; it only changes how ties are broken,
+ * and it saves a scan over all processes in the common keep-alive case.
+ *
+ * The hint is only a pair of identifiers and is validated under the Pool lock
+ * on every use, so it never keeps Groups or Processes alive and it may safely
+ * become stale. It is not thread-safe: each thread must use its own instances.
+ */
+struct RoutingAffinity {
+	/** Index of the process inside Group::enabledProcesses. */
+	unsigned int processIndex;
+	/** Sticky session ID of the process, used to validate `processIndex`.
+	 * 0 means that this hint is empty.
+	 */
+	unsigned int stickySessionId;
+	/** Number of asyncGet() calls that were satisfied by this hint. */
+	unsigned long long hits;
+
+	RoutingAffinity()
+		: processIndex(0),
+		  stickySessionId(0),
+		  hits(0)
+		{ }
+};
+
 struct Ticket {
 	boost::mutex syncher;
 	boost::condition_variable cond;
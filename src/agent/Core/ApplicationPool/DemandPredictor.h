@@ -0,0 +1,224 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_DEMAND_PREDICTOR_H_
+#define _PASSENGER_APPLICATION_POOL2_DEMAND_PREDICTOR_H_
+
+#include <boost/atomic.hpp>
+#include <algorithm>
+#include <cmath>
+#include <Algorithms/MovingAverage.h>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+
+
+/**
+ * Predicts how many processes a Group needs in the near future, so that
+ * processes can be spawned ahead of demand instead of only after requests
+ * start queueing.
+ *
+ * The request arrival rate and the average service time (the time that a
+ * session is checked out) are sampled every `SAMPLE_INTERVAL`. The arrival
+ * rate is smoothed with an exponential moving average plus trend, which is
+ * used to forecast the arrival rate one sample interval plus one spawn time
+ * ahead. The number of processes needed to serve that forecasted load is then
+ * computed from an M/M/c queueing model (Erlang C): the smallest number of
+ * processes for which at most `MAX_WAIT_PERCENTAGE` percent of the requests
+ * would have to wait for a free session slot.
+ *
+ * `recordArrival()` and `recordCompletion()` are thread-safe and may be called
+ * under the shared Pool lock. All other methods must be called under the
+ * exclusive Pool lock.
+ */
+class DemandPredictor {
+public:
+	/** How often the arrival rate and service time are sampled, in microseconds. */
+	static const unsigned long long SAMPLE_INTERVAL = 5000000;
+	/** The maximum percentage of requests that may have to wait for a session slot. */
+	static const unsigned int MAX_WAIT_PERCENTAGE = 10;
+
+private:
+	boost::atomic<unsigned int> arrivals;
+	boost::atomic<unsigned int> completions;
+	boost::atomic<unsigned long long> totalServiceTime;
+
+	/** In requests per second. */
+	ExpMovingAverageWithTrend<500, 300> arrivalRate;
+	/** In seconds, or -1 if unknown. */
+	double serviceTime;
+	/** In seconds, or -1 if unknown. */
+	double spawnTime;
+	unsigned long long lastSampleTime;
+
+public:
+	DemandPredictor()
+		: arrivals(0),
+		  completions(0),
+		  totalServiceTime(0),
+		  serviceTime(-1),
+		  spawnTime(-1),
+		  lastSampleTime(0)
+		{ }
+
+	void recordArrival() {
+		arrivals.fetch_add(1, boost::memory_order_relaxed);
+	}
+
+	/**
+	 * @param usec The time that the session was checked out, in microseconds.
+	 */
+	void recordCompletion(unsigned long long usec) {
+		completions.fetch_add(1, boost::memory_order_relaxed);
+		totalServiceTime.fetch_add(usec, boost::memory_order_relaxed);
+	}
+
+	/**
+	 * @param usec The time that it took to spawn a process, in microseconds.
+	 */
+	void recordSpawnTime(unsigned long long usec) {
+		spawnTime = expMovingAverage(spawnTime, usec / 1000000.0, 0.3);
+	}
+
+	/**
+	 * Takes a sample of the arrivals and completions recorded since the
+	 * previous sample. The first call only marks the beginning of the
+	 * first sample interval.
+	 */
+	void sample(unsigned long long now) {
+		unsigned int nArrivals = arrivals.exchange(0, boost::memory_order_relaxed);
+		unsigned int nCompletions = completions.exchange(0, boost::memory_order_relaxed);
+		unsigned long long serviceTimeSum = totalServiceTime.exchange(0,
+			boost::memory_order_relaxed);
+
+		if (lastSampleTime != 0 && now > lastSampleTime) {
+			arrivalRate.update(nArrivals / ((now - lastSampleTime) / 1000000.0));
+			if (nCompletions > 0) {
+				serviceTime = expMovingAverage(serviceTime,
+					serviceTimeSum / 1000000.0 / nCompletions, 0.3);
+			}
+		}
+		lastSampleTime = now;
+	}
+
+	unsigned long long nextSampleTime() const {
+		return lastSampleTime + SAMPLE_INTERVAL;
+	}
+
+	/** Whether enough samples have been taken to make predictions. */
+	bool available() const {
+		return arrivalRate.available() && serviceTime >= 0;
+	}
+
+	/**
+	 * Forecasts the arrival rate (in requests per second) by the time that
+	 * a process, spawned after the next sample, would be ready.
+	 */
+	double forecastArrivalRate() const {
+		if (!arrivalRate.available()) {
+			return 0;
+		}
+		double interval = SAMPLE_INTERVAL / 1000000.0;
+		double horizon = interval + std::max(spawnTime, 0.0);
+		return std::max(arrivalRate.forecast(horizon / interval), 0.0);
+	}
+
+	/**
+	 * The forecasted offered load in Erlangs, i.e. the average number of
+	 * requests that are being served at the same time.
+	 */
+	double offeredLoad() const {
+		if (!available()) {
+			return 0;
+		}
+		return forecastArrivalRate() * serviceTime;
+	}
+
+	/**
+	 * Returns the probability that a request has to wait in an M/M/c queue
+	 * with the given number of servers and offered load (in Erlangs).
+	 */
+	static double erlangC(unsigned int servers, double load) {
+		if (servers <= load) {
+			return 1;
+		}
+
+		// Erlang B recursion; numerically stable for large numbers of servers.
+		double b = 1;
+		for (unsigned int n = 1; n <= servers; n++) {
+			b = load * b / (n + load * b);
+		}
+		return servers * b / (servers - load * (1 - b));
+	}
+
+	/**
+	 * Returns the smallest number of processes, each able to handle
+	 * `concurrency` sessions at the same time, that can serve the forecasted
+	 * load, capped at `limit`. Returns 0 if no load is forecasted, if no
+	 * prediction can be made yet, or if processes have unlimited concurrency
+	 * (`concurrency == 0`).
+	 */
+	unsigned int requiredProcesses(unsigned int concurrency, unsigned int limit) const {
+		double load = offeredLoad();
+		if (concurrency == 0 || load <= 0) {
+			return 0;
+		}
+
+		// Like erlangC(), but incrementally computed for every whole
+		// number of processes.
+		double b = 1;
+		unsigned int servers = 0;
+		for (unsigned int processes = 1; processes < limit; processes++) {
+			for (unsigned int i = 0; i < concurrency; i++) {
+				servers++;
+				b = load * b / (servers + load * b);
+			}
+			if (servers > load) {
+				double c = servers * b / (servers - load * (1 - b));
+				if (c * 100 <= MAX_WAIT_PERCENTAGE) {
+					return processes;
+				}
+			}
+		}
+		return limit;
+	}
+
+	template<typename Stream>
+	void inspectXml(Stream &stream) const {
+		stream << "<arrival_rate>" << arrivalRate.level() << "</arrival_rate>";
+		stream << "<arrival_rate_trend>" << arrivalRate.trend() << "</arrival_rate_trend>";
+		stream << "<forecasted_arrival_rate>" << forecastArrivalRate() << "</forecasted_arrival_rate>";
+		stream << "<service_time>" << serviceTime << "</service_time>";
+		stream << "<spawn_time>" << spawnTime << "</spawn_time>";
+	}
+};
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_DEMAND_PREDICTOR_H_ */
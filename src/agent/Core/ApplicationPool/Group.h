@@ -34,6 +34,7 @@
 #include <boost/bind.hpp>
 #include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/container/vector.hpp>
 #include <boost/atomic.hpp>
@@ -45,6 +46,7 @@
 #include <cstdlib>
 #include <cassert>
 #include <SmallVector.h>
+#include <Algorithms/FindMinimum.h>
 #include <MemoryKit/palloc.h>
 #include <Hooks.h>
 #include <Utils.h>
@@ -53,6 +55,7 @@
 #include <Core/ApplicationPool/BasicGroupInfo.h>
 #include <Core/ApplicationPool/Process.h>
 #include <Core/ApplicationPool/Options.h>
+#include <Core/ApplicationPool/DemandPredictor.h>
 #include <Core/SpawningKit/Factory.h>
 #include <Core/SpawningKit/UserSwitchingRules.h>
 #include <Shared/ApplicationPoolApiKey.h>
@@ -134,7 +137,9 @@ public:
 	 */
 	unsigned int restartsInitiated;
 	/**
-	 * The number of processes that are being spawned right now.
+	 * The number of processes that are being spawned right now. Each one is
+	 * being spawned by its own spawn loop thread; there are at most
+	 * `spawnConcurrency()` of them.
 	 *
 	 * Invariant:
 	 *     if processesBeingSpawned > 0: m_spawning
@@ -154,7 +159,7 @@ public:
 	 */
 	boost::atomic<boost::uint8_t> lifeStatus;
 	/**
-	 * Whether the spawner thread is currently working. Note that even
+	 * Whether a spawner thread is currently working. Note that even
 	 * if it's working, it doesn't necessarily mean that processes are
 	 * being spawned (i.e. that processesBeingSpawned > 0). After the
 	 * thread is done spawning a process, it will attempt to attach
@@ -182,11 +187,26 @@ public:
 	string alwaysRestartFile;
 	ProcessPtr nullProcess;
 
+	/**
+	 * Protects the session bookkeeping (the `sessions` counters of this
+	 * Group's Processes and Sockets, `Process::processed`, `Process::lastUsed`,
+	 * `enabledProcessBusynessLevels` and `nEnabledProcessesTotallyBusy`)
+	 * against concurrent modification by the routing fast path, which only
+	 * holds the Pool lock in shared mode.
+	 *
+	 * Code that holds the Pool lock exclusively does not need to take this
+	 * lock, because no fast path can be active at the same time. Code that
+	 * holds the Pool lock in shared mode may read all other Group state but
+	 * must not modify it, and must hold this lock while it reads or modifies
+	 * the session bookkeeping.
+	 */
+	boost::mutex routingSyncher;
+
 	/** This timer scans `detachedProcesses` periodically to see
 	 * whether any of the Processes can be shut down.
 	 */
 	bool detachedProcessesCheckerActive;
-	boost::condition_variable detachedProcessesCheckerCond;
+	boost::condition_variable_any detachedProcessesCheckerCond;
 	Callback shutdownCallback;
 	GroupPtr selfPointer;
 
@@ -203,6 +223,9 @@ public:
 
 	RouteResult route(const Options &options) const;
 	SessionPtr newSession(Process *process, unsigned long long now = 0);
+	SessionPtr getFast(const Options &newOptions, RoutingAffinity *affinity = NULL);
+	bool onSessionCloseFast(Process *process, Session *session);
+	void recordSessionCompletion(Session *session);
 	static void _onSessionInitiateFailure(Session *session);
 	static void _onSessionClose(Session *session);
 	OXT_FORCE_INLINE void onSessionInitiateFailure(Process *process, Session *session);
@@ -214,6 +237,11 @@ public:
 		unsigned int restartsInitiated);
 	void spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner, const Options &options,
 		unsigned int restartsInitiated);
+	void startSpawnThread();
+	unsigned int spawnConcurrency() const;
+	bool shouldSpawnConcurrently() const;
+	void possiblySpawnConcurrently();
+	bool predictiveSpawnWanted() const;
 	void finalizeRestart(GroupPtr self, Options oldOptions, Options newOptions,
 		RestartMethod method, SpawningKit::FactoryPtr spawningKitFactory,
 		unsigned int restartsInitiated, boost::container::vector<Callback> postLockActions);
@@ -224,6 +252,7 @@ public:
 	Process *findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const;
 	Process *findProcessWithLowestBusyness(const ProcessList &processes) const;
 	Process *findEnabledProcessWithLowestBusyness() const;
+	Process *findIdleProcessWithAffinity(const RoutingAffinity &affinity) const;
 
 	void addProcessToList(const ProcessPtr &process, ProcessList &destination);
 	void removeProcessFromList(const ProcessPtr &process, ProcessList &source);
@@ -235,6 +264,7 @@ public:
 
 	void startCheckingDetachedProcesses(bool immediately);
 	void detachedProcessesCheckerMain(GroupPtr self);
+	static void detachedProcessExited(boost::weak_ptr<Group> weakSelf);
 
 	/****** Out-of-band work ******/
 
@@ -254,6 +284,7 @@ public:
 
 	void resetOptions(const Options &newOptions, Options *destination = NULL);
 	void mergeOptions(const Options &other);
+	bool mergeOptionsIsNoop(const Options &other) const;
 
 	bool prepareHookScriptOptions(HookScriptOptions &hsOptions, const char *name);
 	void runAttachHooks(const ProcessPtr process) const;
@@ -414,6 +445,15 @@ public:
 	 */
 	SpawningKit::SpawnerPtr spawner;
 
+	/**
+	 * Only used if `options.predictiveSpawning` is set. `predictedProcesses`
+	 * is the number of processes that `demandPredictor` thinks this Group
+	 * will need in the near future, or 0 if it can't tell. It is updated by
+	 * `autoscale()`.
+	 */
+	DemandPredictor demandPredictor;
+	unsigned int predictedProcesses;
+
 
 	/****** Initialization and shutdown ******/
 
@@ -447,12 +487,15 @@ public:
 	void restart(const Options &options, RestartMethod method = RM_DEFAULT);
 	bool restarting() const;
 	bool needsRestart(const Options &options);
+	bool restartFileCheckThrottled(const Options &options) const;
 
 	SpawnResult spawn();
 	bool spawning() const;
 	bool shouldSpawn() const;
 	bool shouldSpawnForGetAction() const;
 	bool allowSpawn() const;
+	void autoscale(unsigned long long now,
+		boost::container::vector<Callback> &postLockActions);
 
 	/****** Process list management ******/
 
@@ -90,6 +90,19 @@ Group::mergeOptions(const Options &other) {
 	options.maxPreloaderIdleTime = other.maxPreloaderIdleTime;
 }
 
+/**
+ * Returns whether `mergeOptions(other)` would leave this Group's options
+ * unchanged. Used by the routing fast path, which is not allowed to
+ * modify the options.
+ */
+bool
+Group::mergeOptionsIsNoop(const Options &other) const {
+	return options.maxRequests == other.maxRequests
+		&& options.minProcesses == other.minProcesses
+		&& options.statThrottleRate == other.statThrottleRate
+		&& options.maxPreloaderIdleTime == other.maxPreloaderIdleTime;
+}
+
 /* Given a hook name like "queue_full_error", we return HookScriptOptions filled in with this name and a spec
  * (user settings that can be queried from agentsOptions using the external hook name that is prefixed with "hook_")
  *
@@ -24,6 +24,7 @@
  *  THE SOFTWARE.
  */
 #include <Core/ApplicationPool/Group.h>
+#include <ProcessManagement/ChildReaper.h>
 
 /*************************************************************************
  *
@@ -104,6 +105,7 @@ Group::findProcessWithLowestBusyness(const ProcessList &processes) const {
 
 /**
  * Cache-optimized version of findProcessWithLowestBusyness() for the common case.
+ * Busyness levels are never negative, so the scan stops at the first idle process.
  */
 Process *
 Group::findEnabledProcessWithLowestBusyness() const {
@@ -111,18 +113,38 @@ Group::findEnabledProcessWithLowestBusyness() const {
 		return NULL;
 	}
 
-	int leastBusyProcessIndex = -1;
-	int lowestBusyness = 0;
-	unsigned int i, size = enabledProcessBusynessLevels.size();
-	const int *enabledProcessBusynessLevels = &this->enabledProcessBusynessLevels[0];
+	unsigned int leastBusyProcessIndex = findFirstMinimumIndex(
+		&enabledProcessBusynessLevels[0],
+		enabledProcessBusynessLevels.size(),
+		0);
+	return enabledProcesses[leastBusyProcessIndex].get();
+}
 
-	for (i = 0; i < size; i++) {
-		if (leastBusyProcessIndex == -1 || enabledProcessBusynessLevels[i] < lowestBusyness) {
-			leastBusyProcessIndex = i;
-			lowestBusyness = enabledProcessBusynessLevels[i];
-		}
+/**
+ * Returns the enabled process that the given routing affinity hint refers to,
+ * but only if that process is idle and can be routed to. Returns NULL otherwise,
+ * e.g. if the hint is empty or stale. An idle process always has the lowest
+ * busyness, so routing to it is equivalent to routing to the result of
+ * findEnabledProcessWithLowestBusyness().
+ */
+Process *
+Group::findIdleProcessWithAffinity(const RoutingAffinity &affinity) const {
+	unsigned int i = affinity.processIndex;
+	if (affinity.stickySessionId == 0
+	 || i >= enabledProcessBusynessLevels.size()
+	 || enabledProcessBusynessLevels[i] != 0)
+	{
+		return NULL;
+	}
+
+	Process *process = enabledProcesses[i].get();
+	if (process->getStickySessionId() == affinity.stickySessionId
+	 && process->canBeRoutedTo())
+	{
+		return process;
+	} else {
+		return NULL;
 	}
-	return enabledProcesses[leastBusyProcessIndex].get();
 }
 
 /**
@@ -160,6 +182,12 @@ Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 			kill(process->getPid(), SIGINT);
 		}
 		callAbortLongRunningConnectionsCallback(process);
+		process->closeConnectionPools();
+		if (!process->isDummy()) {
+			// Wake up the detached processes checker as soon as the process exits.
+			ChildReaper::getInstance().notifyOnExit(process->getPid(),
+				boost::bind(detachedProcessExited, boost::weak_ptr<Group>(shared_from_this())));
+		}
 	} else {
 		P_BUG("Unknown destination list");
 	}
@@ -290,6 +318,17 @@ Group::startCheckingDetachedProcesses(bool immediately) {
 	}
 }
 
+/**
+ * Called by the ChildReaper thread when a detached process has exited.
+ */
+void
+Group::detachedProcessExited(boost::weak_ptr<Group> weakSelf) {
+	GroupPtr self = weakSelf.lock();
+	if (self != NULL) {
+		self->detachedProcessesCheckerCond.notify_all();
+	}
+}
+
 void
 Group::detachedProcessesCheckerMain(GroupPtr self) {
 	TRACE_POINT();
@@ -301,7 +340,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 		debug->messages->recv("Proceed with starting detached processes checker");
 	}
 
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	while (true) {
 		assert(detachedProcessesCheckerActive);
 
@@ -456,6 +495,9 @@ Group::attach(const ProcessPtr &process,
 	// Update GC sleep timer.
 	wakeUpGarbageCollector();
 
+	// Establish connections before the first requests arrive, but outside
+	// the lock because connecting is done through system calls.
+	postLockActions.push_back(boost::bind(&Process::fillConnectionPools, process));
 	postLockActions.push_back(boost::bind(&Group::runAttachHooks, this, process));
 
 	return AR_OK;
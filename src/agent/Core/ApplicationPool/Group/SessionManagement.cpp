@@ -93,6 +93,10 @@ Group::newSession(Process *process, unsigned long long now) {
 	SessionPtr session = process->newSession(now);
 	session->onInitiateFailure = _onSessionInitiateFailure;
 	session->onClose   = _onSessionClose;
+	if (OXT_UNLIKELY(options.predictiveSpawning)) {
+		demandPredictor.recordArrival();
+		session->checkoutTime = process->lastUsed;
+	}
 	if (process->enabled == Process::ENABLED) {
 		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
 		if (!wasTotallyBusy && process->isTotallyBusy()) {
@@ -102,6 +106,106 @@ Group::newSession(Process *process, unsigned long long now) {
 	return session;
 }
 
+void
+Group::recordSessionCompletion(Session *session) {
+	if (OXT_UNLIKELY(session->checkoutTime != 0)) {
+		unsigned long long now = SystemTime::getUsec();
+		if (now > session->checkoutTime) {
+			demandPredictor.recordCompletion(now - session->checkoutTime);
+		}
+	}
+}
+
+/* The routing fast path for get(). Only handles the common case in which
+ * an enabled process with spare capacity is available, and in which checking
+ * out a session changes nothing but the session bookkeeping: no restart is
+ * due, no spawning is needed, the options don't change and nobody is waiting.
+ * Returns NULL if the caller should fall back to get() under the exclusive
+ * Pool lock, in which case nothing has been modified.
+ *
+ * If `affinity` is given, then the process that it refers to is preferred
+ * as long as it is idle, and the hint is updated with the chosen process.
+ *
+ * Must be called while holding the Pool lock in shared mode.
+ */
+SessionPtr
+Group::getFast(const Options &newOptions, RoutingAffinity *affinity) {
+	if (OXT_UNLIKELY(newOptions.noop
+		|| !isAlive()
+		|| restarting()
+		|| enabledCount == 0
+		|| !getWaitlist.empty()
+		|| !processLowerLimitsSatisfied()
+		|| !mergeOptionsIsNoop(newOptions)
+		|| !restartFileCheckThrottled(newOptions)))
+	{
+		return SessionPtr();
+	}
+
+	boost::lock_guard<boost::mutex> l(routingSyncher);
+	Process *process = NULL;
+	if (affinity != NULL && newOptions.stickySessionId == 0) {
+		process = findIdleProcessWithAffinity(*affinity);
+		if (process != NULL) {
+			affinity->hits++;
+		}
+	}
+	if (process == NULL) {
+		process = route(newOptions).process;
+		if (process == NULL) {
+			return SessionPtr();
+		}
+	}
+
+	if (affinity != NULL) {
+		affinity->processIndex = process->getIndex();
+		affinity->stickySessionId = process->getStickySessionId();
+	}
+	return newSession(process, newOptions.currentTime);
+}
+
+/* The routing fast path for onSessionClose(). Only handles the common case
+ * in which closing a session changes nothing but the session bookkeeping:
+ * the process stays enabled, no OOBW is to be initiated, the process hasn't
+ * reached its maximum number of requests, nobody is waiting for a session
+ * and no capacity needs to be freed for another Group. Returns false if
+ * the caller should fall back to the slow path, in which case nothing has
+ * been modified.
+ */
+bool
+Group::onSessionCloseFast(Process *process, Session *session) {
+	Pool *pool = getPool();
+	PoolSharedLock lock(pool->syncher);
+
+	if (OXT_UNLIKELY(!isAlive()
+		|| process->enabled != Process::ENABLED
+		|| !getWaitlist.empty()
+		|| shouldInitiateOobw(process)))
+	{
+		return false;
+	}
+
+	boost::lock_guard<boost::mutex> l(routingSyncher);
+	if (options.maxRequests > 0 && process->processed + 1 >= options.maxRequests) {
+		return false;
+	}
+	if (process->sessions == 1
+	 && (!pool->getWaitlist.empty() || anotherGroupIsWaitingForCapacity()))
+	{
+		return false;
+	}
+
+	bool wasTotallyBusy = process->isTotallyBusy();
+	process->sessionClosed(session);
+	recordSessionCompletion(session);
+	enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
+	if (wasTotallyBusy) {
+		assert(nEnabledProcessesTotallyBusy >= 1);
+		nEnabledProcessesTotallyBusy--;
+	}
+	return true;
+}
+
 void
 Group::_onSessionInitiateFailure(Session *session) {
 	Process *process = session->getProcess();
@@ -123,7 +227,7 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -141,9 +245,13 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 OXT_FORCE_INLINE void
 Group::onSessionClose(Process *process, Session *session) {
 	TRACE_POINT();
+	if (OXT_LIKELY(onSessionCloseFast(process, session))) {
+		return;
+	}
+
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -154,6 +262,7 @@ Group::onSessionClose(Process *process, Session *session) {
 	/* Update statistics. */
 	bool wasTotallyBusy = process->isTotallyBusy();
 	process->sessionClosed(session);
+	recordSessionCompletion(session);
 	assert(process->getLifeStatus() == Process::ALIVE);
 	assert(process->enabled == Process::ENABLED
 		|| process->enabled == Process::DISABLING
@@ -53,6 +53,62 @@ Group::spawnThreadMain(GroupPtr self, SpawningKit::SpawnerPtr spawner,
 	spawnThreadRealMain(spawner, options, restartsInitiated);
 }
 
+void
+Group::startSpawnThread() {
+	interruptableThreads.create_thread(
+		boost::bind(&Group::spawnThreadMain,
+			this, shared_from_this(), spawner,
+			options.copyAndPersist().clearPerRequestFields(),
+			restartsInitiated),
+		"Group process spawner: " + info.name,
+		POOL_HELPER_THREAD_STACK_SIZE);
+	m_spawning = true;
+	processesBeingSpawned++;
+}
+
+unsigned int
+Group::spawnConcurrency() const {
+	return std::max(options.spawnConcurrency, 1u);
+}
+
+/**
+ * Whether an additional spawn loop thread should be started next to the
+ * ones that are already running. We only do that while there is demand
+ * that the in-flight spawns won't cover: either the lower limits aren't
+ * satisfied yet, or there are more get waiters than processes being spawned.
+ * In-flight spawns count towards `capacityUsed()`, so the group and pool
+ * limits (and thus `Pool::forceFreeCapacity()`) stay accurate.
+ */
+bool
+Group::shouldSpawnConcurrently() const {
+	return (unsigned int) processesBeingSpawned < spawnConcurrency()
+		&& !restarting()
+		&& !processUpperLimitsReached()
+		&& !poolAtFullCapacity()
+		&& !anotherGroupIsWaitingForCapacity()
+		&& (!processLowerLimitsSatisfied()
+			|| predictiveSpawnWanted()
+			|| getWaitlist.size() > (unsigned int) processesBeingSpawned);
+}
+
+void
+Group::possiblySpawnConcurrently() {
+	while (shouldSpawnConcurrently()) {
+		P_DEBUG("Spawning additional process concurrently for group " << info.name <<
+			": processesBeingSpawned=" << processesBeingSpawned);
+		startSpawnThread();
+	}
+}
+
+/**
+ * Whether predictive spawning wants more processes than the ones that
+ * exist or are being spawned.
+ */
+bool
+Group::predictiveSpawnWanted() const {
+	return predictedProcesses > capacityUsed();
+}
+
 void
 Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 	const Options &options, unsigned int restartsInitiated)
@@ -112,7 +168,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		UPDATE_TRACE_POINT();
 		ScopeGuard guard(boost::bind(Process::forceTriggerShutdownAndCleanup, process));
-		boost::unique_lock<boost::mutex> lock(pool->syncher);
+		PoolScopedLock lock(pool->syncher);
 
 		if (!isAlive()) {
 			if (process != NULL) {
@@ -144,8 +200,9 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 		assert(m_spawning);
 		assert(processesBeingSpawned > 0);
 
+		// Other spawn loop threads may still be working if
+		// spawnConcurrency() > 1.
 		processesBeingSpawned--;
-		assert(processesBeingSpawned == 0);
 
 		UPDATE_TRACE_POINT();
 		boost::container::vector<Callback> actions;
@@ -153,6 +210,12 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 			AttachResult result = attach(process, actions);
 			if (result == AR_OK) {
 				guard.clear();
+				if (options.predictiveSpawning
+				 && process->getSpawnEndTime() > process->getSpawnStartTime())
+				{
+					demandPredictor.recordSpawnTime(process->getSpawnEndTime()
+						- process->getSpawnStartTime());
+				}
 				if (getWaitlist.empty()) {
 					pool->assignSessionsToGetWaiters(actions);
 				} else {
@@ -178,17 +241,22 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 			done = true;
 		}
 
+		// Waiters that will be served by processes which other spawn loop
+		// threads are still working on don't need this thread to continue.
 		done = done
-			|| (processLowerLimitsSatisfied() && getWaitlist.empty())
+			|| (processLowerLimitsSatisfied()
+				&& !predictiveSpawnWanted()
+				&& getWaitlist.size() <= (unsigned int) processesBeingSpawned)
 			|| processUpperLimitsReached()
 			|| pool->atFullCapacityUnlocked();
-		m_spawning = !done;
 		if (done) {
 			P_DEBUG("Spawn loop done");
 		} else {
 			processesBeingSpawned++;
 			P_DEBUG("Continue spawning");
+			possiblySpawnConcurrently();
 		}
+		m_spawning = processesBeingSpawned > 0;
 
 		UPDATE_TRACE_POINT();
 		pool->fullVerifyInvariants();
@@ -238,7 +306,7 @@ Group::finalizeRestart(GroupPtr self,
 		debug->messages->recv("Finish restarting");
 	}
 
-	ScopedLock l(pool->syncher);
+	PoolScopedLock l(pool->syncher);
 	if (!isAlive()) {
 		P_DEBUG("Group " << getName() << " is shutting down, so aborting restart");
 		return;
@@ -407,16 +475,44 @@ Group::needsRestart(const Options &options) {
 	}
 }
 
+/**
+ * Returns whether `needsRestart(options)` would return false without
+ * having to stat() any files, i.e. whether we're still within the stat
+ * throttling window and always_restart.txt didn't exist the last time we
+ * checked. Used by the routing fast path, which is not allowed to modify
+ * the restart file bookkeeping.
+ */
+bool
+Group::restartFileCheckThrottled(const Options &options) const {
+	if (m_restarting) {
+		return true;
+	} else if (lastRestartFileCheckTime == 0 || alwaysRestartFileExists) {
+		return false;
+	} else {
+		time_t now;
+		if (options.currentTime != 0) {
+			now = options.currentTime / 1000000;
+		} else {
+			now = SystemTime::get();
+		}
+		return lastRestartFileCheckTime > now - (time_t) options.statThrottleRate;
+	}
+}
+
 /**
  * Attempts to increase the number of processes by one, while respecting the
  * resource limits. That is, this method will ensure that there are at least
  * `minProcesses` processes, but no more than `maxProcesses` processes, and no
  * more than `pool->max` processes in the entire pool.
+ *
+ * If `options.spawnConcurrency` > 1 and there is enough demand, then up to
+ * that many processes are spawned at the same time.
  */
 SpawnResult
 Group::spawn() {
 	assert(isAlive());
 	if (m_spawning) {
+		possiblySpawnConcurrently();
 		return SR_IN_PROGRESS;
 	} else if (restarting()) {
 		return SR_ERR_RESTARTING;
@@ -426,15 +522,8 @@ Group::spawn() {
 		return SR_ERR_POOL_AT_FULL_CAPACITY;
 	} else {
 		P_DEBUG("Requested spawning of new process for group " << info.name);
-		interruptableThreads.create_thread(
-			boost::bind(&Group::spawnThreadMain,
-				this, shared_from_this(), spawner,
-				options.copyAndPersist().clearPerRequestFields(),
-				restartsInitiated),
-			"Group process spawner: " + info.name,
-			POOL_HELPER_THREAD_STACK_SIZE);
-		m_spawning = true;
-		processesBeingSpawned++;
+		startSpawnThread();
+		possiblySpawnConcurrently();
 		return SR_OK;
 	}
 }
@@ -444,6 +533,63 @@ Group::spawning() const {
 	return m_spawning;
 }
 
+/**
+ * Called periodically by the garbage collector if `options.predictiveSpawning`
+ * is set. Updates the demand forecast, then either spawns processes ahead of
+ * the forecasted demand, or shuts down one surplus idle process. Shutting
+ * down at most one process per sample interval makes the group shrink
+ * gradually instead of all at once when the idle time is reached.
+ */
+void
+Group::autoscale(unsigned long long now,
+	boost::container::vector<Callback> &postLockActions)
+{
+	demandPredictor.sample(now);
+	if (enabledCount == 0 || restarting()) {
+		predictedProcesses = 0;
+		return;
+	}
+
+	// The queueing model doesn't apply to processes with unlimited concurrency.
+	int concurrency = enabledProcesses[0]->getConcurrency();
+	if (!demandPredictor.available() || concurrency == 0) {
+		predictedProcesses = 0;
+		return;
+	}
+
+	unsigned int limit = getPool()->max;
+	if (options.maxProcesses != 0) {
+		limit = std::min(limit, options.maxProcesses);
+	}
+	predictedProcesses = demandPredictor.requiredProcesses(concurrency, limit);
+
+	if (predictiveSpawnWanted()) {
+		P_DEBUG("Spawning ahead of demand for group " << info.name <<
+			": predicted processes = " << predictedProcesses <<
+			", capacity used = " << capacityUsed());
+		spawn();
+	} else if ((unsigned int) enabledCount > std::max(predictedProcesses, options.minProcesses)
+		&& processesBeingSpawned == 0
+		&& getWaitlist.empty())
+	{
+		ProcessPtr oldestIdleProcess;
+		foreach (const ProcessPtr &process, enabledProcesses) {
+			if (process->sessions == 0
+			 && now >= process->lastUsed + DemandPredictor::SAMPLE_INTERVAL
+			 && (oldestIdleProcess == NULL
+				|| process->lastUsed < oldestIdleProcess->lastUsed))
+			{
+				oldestIdleProcess = process;
+			}
+		}
+		if (oldestIdleProcess != NULL) {
+			P_DEBUG("Shutting down surplus process " << oldestIdleProcess->inspect() <<
+				": predicted processes = " << predictedProcesses);
+			detach(oldestIdleProcess, postLockActions);
+		}
+	}
+}
+
 /** Whether a new process should be spawned for this group. */
 bool
 Group::shouldSpawn() const {
@@ -132,6 +132,13 @@ Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
 	stream << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
 	stream << "<disable_wait_list_size>" << disableWaitlist.size() << "</disable_wait_list_size>";
 	stream << "<processes_being_spawned>" << processesBeingSpawned << "</processes_being_spawned>";
+	stream << "<spawn_concurrency>" << spawnConcurrency() << "</spawn_concurrency>";
+	if (options.predictiveSpawning) {
+		stream << "<predictive_spawning>";
+		demandPredictor.inspectXml(stream);
+		stream << "<predicted_processes>" << predictedProcesses << "</predicted_processes>";
+		stream << "</predictive_spawning>";
+	}
 	if (m_spawning) {
 		stream << "<spawning/>";
 	}
@@ -349,6 +349,22 @@ public:
 	 */
 	unsigned int maxProcesses;
 
+	/**
+	 * The maximum number of processes that the group may be spawning at the
+	 * same time. Spawning more than one process at a time speeds up scaling
+	 * out, at the cost of higher peak CPU and memory usage while booting.
+	 *
+	 * A value of 0 is treated as 1.
+	 */
+	unsigned int spawnConcurrency;
+
+	/**
+	 * Whether to spawn processes ahead of demand, and to shut down surplus
+	 * processes before they reach the idle timeout, based on a forecast of
+	 * the request arrival rate. See DemandPredictor.
+	 */
+	bool predictiveSpawning;
+
 	/** The number of seconds that preloader processes may stay alive idling. */
 	long maxPreloaderIdleTime;
 
@@ -492,6 +508,8 @@ public:
 
 		  minProcesses(1),
 		  maxProcesses(0),
+		  spawnConcurrency(1),
+		  predictiveSpawning(false),
 		  maxPreloaderIdleTime(-1),
 		  maxOutOfBandWorkInstances(1),
 		  maxRequestQueueSize(100),
@@ -631,6 +649,8 @@ public:
 		if (fields & PER_GROUP_POOL_OPTIONS) {
 			appendKeyValue3(vec, "min_processes",       minProcesses);
 			appendKeyValue3(vec, "max_processes",       maxProcesses);
+			appendKeyValue3(vec, "spawn_concurrency",   spawnConcurrency);
+			appendKeyValue4(vec, "predictive_spawning", predictiveSpawning);
 			appendKeyValue2(vec, "max_preloader_idle_time", maxPreloaderIdleTime);
 			appendKeyValue3(vec, "max_out_of_band_work_instances", maxOutOfBandWorkInstances);
 		}
@@ -158,7 +158,18 @@ public:
 	friend class Process;
 	friend struct tut::ApplicationPool2_PoolTest;
 
-	mutable boost::mutex syncher;
+	/**
+	 * The Pool lock. Protects the Pool and all its Groups, Processes and
+	 * Sockets. Almost all code paths take this lock exclusively.
+	 *
+	 * The only exception is the routing fast path (`asyncGetFast()` and
+	 * `Group::onSessionCloseFast()`), which handles the common case of checking
+	 * out a session from, or returning a session to, an enabled process with
+	 * spare capacity. That fast path only takes this lock in shared mode, plus
+	 * the Group's `routingSyncher`, so that requests for different Groups can
+	 * be routed in parallel. See `Group::routingSyncher` for the rules.
+	 */
+	mutable ShardedSharedMutex syncher;
 	unsigned int max;
 	unsigned long long maxIdleTime;
 	bool selfchecking;
@@ -298,7 +309,7 @@ public:
 		boost::container::vector<Callback> actions;
 	};
 
-	boost::condition_variable garbageCollectionCond;
+	boost::condition_variable_any garbageCollectionCond;
 
 	void initializeGarbageCollection();
 	static void garbageCollect(PoolPtr self);
@@ -308,6 +319,7 @@ public:
 	void garbageCollectProcessesInGroup(GarbageCollectorState &state,
 		const GroupPtr &group);
 	void maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group);
+	void maybeAutoscale(GarbageCollectorState &state, const GroupPtr &group);
 	unsigned long long realGarbageCollect();
 	void wakeupGarbageCollector();
 
@@ -331,6 +343,14 @@ public:
 		void *userData);
 
 
+	/****** Miscellaneous ******/
+
+	UnionStation::StopwatchLog *createAsyncGetStopwatchLog(const Options &options,
+		const Group *existingGroup) const;
+	bool asyncGetFast(const Options &options, const GetCallback &callback,
+		UnionStation::StopwatchLog **stopwatchLog, RoutingAffinity *affinity);
+
+
 	/****** Group data structure utilities ******/
 
 	struct DetachGroupWaitTicket {
@@ -449,7 +469,8 @@ public:
 
 	/****** Miscellaneous ******/
 
-	void asyncGet(const Options &options, const GetCallback &callback, bool lockNow = true, UnionStation::StopwatchLog **stopwatchLog = NULL);
+	void asyncGet(const Options &options, const GetCallback &callback, bool lockNow = true,
+		UnionStation::StopwatchLog **stopwatchLog = NULL, RoutingAffinity *affinity = NULL);
 	SessionPtr get(const Options &options, Ticket *ticket);
 	void setMax(unsigned int max);
 	void setMaxIdleTime(unsigned long long value);
@@ -51,7 +51,7 @@ void
 Pool::garbageCollect(PoolPtr self) {
 	TRACE_POINT();
 	{
-		ScopedLock lock(self->syncher);
+		PoolScopedLock lock(self->syncher);
 		self->garbageCollectionCond.timed_wait(lock,
 			posix_time::seconds(5));
 	}
@@ -60,7 +60,7 @@ Pool::garbageCollect(PoolPtr self) {
 			UPDATE_TRACE_POINT();
 			unsigned long long sleepTime = self->realGarbageCollect();
 			UPDATE_TRACE_POINT();
-			ScopedLock lock(self->syncher);
+			PoolScopedLock lock(self->syncher);
 			self->garbageCollectionCond.timed_wait(lock,
 				posix_time::microseconds(sleepTime));
 		} catch (const thread_interrupted &) {
@@ -138,10 +138,18 @@ Pool::maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group) {
 	}
 }
 
+void
+Pool::maybeAutoscale(GarbageCollectorState &state, const GroupPtr &group) {
+	if (state.now >= group->demandPredictor.nextSampleTime()) {
+		group->autoscale(state.now, state.actions);
+	}
+	maybeUpdateNextGcRuntime(state, group->demandPredictor.nextSampleTime());
+}
+
 unsigned long long
 Pool::realGarbageCollect() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	GarbageCollectorState state;
 	state.now = SystemTime::getUsec();
@@ -164,6 +172,11 @@ Pool::realGarbageCollect() {
 		// ...cleanup the spawner if it's been idle for more than preloaderIdleTime.
 		maybeCleanPreloader(state, group);
 
+		// ...spawn or shut down processes according to the predicted demand.
+		if (group->options.predictiveSpawning) {
+			maybeAutoscale(state, group);
+		}
+
 		g_it.next();
 	}
 
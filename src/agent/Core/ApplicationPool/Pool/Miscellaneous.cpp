@@ -38,11 +38,100 @@ using namespace std;
 using namespace boost;
 
 
+/****************************
+ *
+ * Private methods
+ *
+ ****************************/
+
+
+UnionStation::StopwatchLog *
+Pool::createAsyncGetStopwatchLog(const Options &options, const Group *existingGroup) const {
+	// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
+	// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
+	// but also indicates the server has headroom to handle the load).
+	Json::Value data;
+	if (!existingGroup) {
+		data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
+	} else {
+		char queueMaxStr[10];
+		int queueMax = existingGroup->options.maxRequestQueueSize;
+		if (queueMax > 0) {
+			snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
+		}
+		char message[50];
+		snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
+				(queueMax == 0 ? "inf" : queueMaxStr),
+				(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
+		data["message"] = message;
+	}
+	Json::Value json;
+	json["data"] = data;
+	json["data_type"] = "generic";
+	json["name"] = "Await available process";
+
+	return new UnionStation::StopwatchLog(options.transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+}
+
+/**
+ * The routing fast path for asyncGet(). Handles the common case in which
+ * the Group already exists and has an enabled process with spare capacity,
+ * while only holding the Pool lock in shared mode (plus the Group's
+ * routing lock). This allows requests for different Groups to be routed in
+ * parallel, and keeps the exclusive lock free for spawning, garbage
+ * collection and capacity rebalancing.
+ *
+ * Returns false if the request could not be handled here, in which case
+ * nothing has been modified and the caller must fall back to the slow path.
+ */
+bool
+Pool::asyncGetFast(const Options &options, const GetCallback &callback,
+	UnionStation::StopwatchLog **stopwatchLog, RoutingAffinity *affinity)
+{
+	PoolSharedLock lock(syncher);
+	if (OXT_UNLIKELY(lifeStatus != ALIVE && lifeStatus != PREPARED_FOR_SHUTDOWN)) {
+		return false;
+	}
+
+	Group *existingGroup = findMatchingGroup(options);
+	if (OXT_UNLIKELY(existingGroup == NULL)) {
+		return false;
+	}
+
+	SessionPtr session = existingGroup->getFast(options, affinity);
+	if (session == NULL) {
+		return false;
+	}
+
+	if (stopwatchLog != NULL) {
+		*stopwatchLog = createAsyncGetStopwatchLog(options, existingGroup);
+	}
+	lock.unlock();
+	P_TRACE(2, "asyncGet(appGroupName=" << options.getAppGroupName() <<
+		") finished using fast path");
+	callback(session, ExceptionPtr());
+	return true;
+}
+
+
+/****************************
+ *
+ * Public methods
+ *
+ ****************************/
+
+
 // 'lockNow == false' may only be used during unit tests. Normally we
 // should never call the callback while holding the lock.
 void
-Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow, UnionStation::StopwatchLog **stopwatchLog) {
-	DynamicScopedLock lock(syncher, lockNow);
+Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow,
+	UnionStation::StopwatchLog **stopwatchLog, RoutingAffinity *affinity)
+{
+	if (OXT_LIKELY(lockNow) && asyncGetFast(options, callback, stopwatchLog, affinity)) {
+		return;
+	}
+
+	PoolDynamicScopedLock lock(syncher, lockNow);
 
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 	verifyInvariants();
@@ -51,30 +140,7 @@ Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow
 
 	Group *existingGroup = findMatchingGroup(options);
 	if (stopwatchLog != NULL) {
-		// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
-		// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
-		// but also indicates the server has headroom to handle the load).
-		Json::Value data;
-		if (!existingGroup) {
-			data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
-		} else {
-			char queueMaxStr[10];
-			int queueMax = existingGroup->options.maxRequestQueueSize;
-			if (queueMax > 0) {
-				snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
-			}
-			char message[50];
-			snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
-					(queueMax == 0 ? "inf" : queueMaxStr),
-					(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
-			data["message"] = message;
-		}
-		Json::Value json;
-		json["data"] = data;
-		json["data_type"] = "generic";
-		json["name"] = "Await available process";
-
-		*stopwatchLog = new UnionStation::StopwatchLog(options.transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+		*stopwatchLog = createAsyncGetStopwatchLog(options, existingGroup);
 	}
 
 	if (OXT_LIKELY(existingGroup != NULL)) {
@@ -193,7 +259,7 @@ Pool::get(const Options &options, Ticket *ticket) {
 
 void
 Pool::setMax(unsigned int max) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	assert(max > 0);
 	fullVerifyInvariants();
 	bool bigger = max > this->max;
@@ -222,14 +288,14 @@ Pool::setMax(unsigned int max) {
 
 void
 Pool::setMaxIdleTime(unsigned long long value) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	maxIdleTime = value;
 	wakeupGarbageCollector();
 }
 
 void
 Pool::enableSelfChecking(bool enabled) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	selfchecking = enabled;
 }
 
@@ -238,7 +304,7 @@ Pool::enableSelfChecking(bool enabled) {
  */
 bool
 Pool::isSpawning(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	PoolDynamicScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -261,7 +327,7 @@ Pool::authorizeByUid(uid_t uid, bool lock) const {
 		return true;
 	}
 
-	DynamicScopedLock l(syncher, lock);
+	PoolDynamicScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -557,6 +557,7 @@ public:
 			lifeStatus = SHUTDOWN_TRIGGERED;
 			shutdownStartTime = now;
 		}
+		closeConnectionPools();
 		if (!dummy) {
 			syscalls::shutdown(adminSocket, SHUT_WR);
 		}
@@ -629,6 +630,18 @@ public:
 		return spawnerCreationTime;
 	}
 
+	unsigned long long getSpawnStartTime() const {
+		return spawnStartTime;
+	}
+
+	unsigned long long getSpawnEndTime() const {
+		return spawnEndTime;
+	}
+
+	int getConcurrency() const {
+		return concurrency;
+	}
+
 	bool isDummy() const {
 		return dummy;
 	}
@@ -794,6 +807,46 @@ public:
 		return SessionPtr(session, false);
 	}
 
+	/**
+	 * Fills the connection pools of the session sockets up to their target
+	 * sizes, so that the first requests after a spawn or restart don't have
+	 * to connect first. Never waits for the app to accept a connection.
+	 *
+	 * Thread-safe, so may be called outside the ApplicationPool lock.
+	 */
+	void fillConnectionPools() {
+		if (dummy || !isAlive()) {
+			return;
+		}
+
+		unsigned int added = 0;
+		SocketList::iterator it, end = sockets.end();
+		for (it = sockets.begin(); it != end; it++) {
+			if (it->protocol == "session" || it->protocol == "http_session") {
+				added += it->fillConnectionPool();
+			}
+		}
+		if (added > 0) {
+			P_DEBUG("Prewarmed " << added << " connections to process " << inspect());
+		}
+	}
+
+	/**
+	 * Closes the idle connections in the connection pools of all sockets,
+	 * and prevents new connections from being pooled or prewarmed. Idle
+	 * connections may occupy app threads that would otherwise keep the
+	 * process from shutting down, so this must be called before waiting
+	 * for the process to exit.
+	 *
+	 * Thread-safe, so may be called outside the ApplicationPool lock.
+	 */
+	void closeConnectionPools() {
+		SocketList::iterator it, end = sockets.end();
+		for (it = sockets.begin(); it != end; it++) {
+			it->closeConnectionPool();
+		}
+	}
+
 	void sessionClosed(Session *session) {
 		Socket *socket = session->getSocket();
 
@@ -891,6 +944,9 @@ public:
 				stream << "<protocol>" << escapeForXml(socket.protocol) << "</protocol>";
 				stream << "<concurrency>" << socket.concurrency << "</concurrency>";
 				stream << "<sessions>" << socket.sessions << "</sessions>";
+				stream << "<connection_pool_target>" << socket.connectionPoolTarget() << "</connection_pool_target>";
+				stream << "<idle_connections>" << socket.totalIdleConnections << "</idle_connections>";
+				stream << "<total_connections>" << socket.totalConnections << "</total_connections>";
 				stream << "</socket>";
 			}
 			stream << "</sockets>";
@@ -85,6 +85,8 @@ private:
 	Socket *socket;
 
 	Connection connection;
+	/** Non-NULL while a connection attempt started by beginInitiate() is pending. */
+	NConnect_State *connectState;
 	mutable boost::atomic<int> refcount;
 	bool closed;
 
@@ -95,6 +97,24 @@ private:
 		connection.fd = -1;
 	}
 
+	void abortConnect() {
+		delete connectState;
+		connectState = NULL;
+	}
+
+	InitiateStatus handleConnectStatus(ConnectStatus status) {
+		switch (status) {
+		case CONNECTED:
+			connection = socket->connectionEstablished(*connectState);
+			abortConnect();
+			return INITIATED;
+		case CONNECT_WAIT_WRITABLE:
+			return INITIATE_WAIT_WRITABLE;
+		default:
+			return INITIATE_RETRY_LATER;
+		}
+	}
+
 	void callOnInitiateFailure() {
 		if (OXT_LIKELY(onInitiateFailure != NULL)) {
 			onInitiateFailure(this);
@@ -117,15 +137,22 @@ private:
 public:
 	Callback onInitiateFailure;
 	Callback onClose;
+	/**
+	 * The time at which this session was checked out, in microseconds.
+	 * Only set if the Group is collecting statistics for predictive spawning.
+	 */
+	unsigned long long checkoutTime;
 
 	Session(Context *_context, const BasicProcessInfo *_processInfo, Socket *_socket)
 		: context(_context),
 		  processInfo(_processInfo),
 		  socket(_socket),
+		  connectState(NULL),
 		  refcount(1),
 		  closed(false),
 		  onInitiateFailure(NULL),
-		  onClose(NULL)
+		  onClose(NULL),
+		  checkoutTime(0)
 		{ }
 
 	~Session() {
@@ -134,6 +161,7 @@ public:
 		if (OXT_LIKELY(initiated())) {
 			deinitiate(false, false);
 		}
+		abortConnect();
 		if (OXT_LIKELY(!closed)) {
 			callOnClose();
 		}
@@ -196,13 +224,66 @@ public:
 		this->connection = connection;
 	}
 
+	virtual InitiateStatus beginInitiate() {
+		assert(!closed);
+		assert(!initiated());
+		assert(connectState == NULL);
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		Connection connection;
+
+		if (socket->checkoutIdleConnection(connection)) {
+			connection.fail = true;
+			if (connection.blocking) {
+				FdGuard g2(connection.fd, NULL, 0);
+				setNonBlocking(connection.fd);
+				g2.clear();
+				connection.blocking = false;
+			}
+			g.clear();
+			this->connection = connection;
+			// Make sure the next concurrent session finds an idle connection too.
+			if (!socket->hasIdleConnections()) {
+				socket->prewarmConnections(1);
+			}
+			return INITIATED;
+		}
+
+		connectState = new NConnect_State();
+		ScopeGuard g2(boost::bind(&Session::abortConnect, this));
+		InitiateStatus status = handleConnectStatus(
+			socket->beginConnect(*connectState));
+		g2.clear();
+		g.clear();
+		return status;
+	}
+
+	virtual InitiateStatus continueInitiate() {
+		assert(!closed);
+		assert(connectState != NULL);
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		ScopeGuard g2(boost::bind(&Session::abortConnect, this));
+		InitiateStatus status = handleConnectStatus(
+			socket->continueConnect(*connectState));
+		g2.clear();
+		g.clear();
+		return status;
+	}
+
 	bool initiated() const {
 		return connection.fd != -1;
 	}
 
+	/**
+	 * While a connection attempt started by beginInitiate() is pending,
+	 * returns the file descriptor of the socket that is being connected.
+	 */
 	virtual int fd() const {
 		assert(!closed);
-		return connection.fd;
+		if (OXT_UNLIKELY(connectState != NULL)) {
+			return Socket::getConnectingFd(*connectState);
+		} else {
+			return connection.fd;
+		}
 	}
 
 	/**
@@ -212,6 +293,7 @@ public:
 		if (OXT_LIKELY(initiated())) {
 			deinitiate(success, wantKeepAlive);
 		}
+		abortConnect();
 		if (OXT_LIKELY(!closed)) {
 			callOnClose();
 		}
@@ -71,6 +71,14 @@ struct Connection {
 	}
 };
 
+enum ConnectStatus {
+	CONNECTED,
+	/** The connection attempt is pending until the socket becomes writable. */
+	CONNECT_WAIT_WRITABLE,
+	/** The app is not accepting connections right now; try again later. */
+	CONNECT_RETRY_LATER
+};
+
 /**
  * Not thread-safe except for the connection pooling methods, so only use
  * within the ApplicationPool lock.
@@ -79,10 +87,24 @@ class Socket {
 private:
 	boost::mutex connectionPoolLock;
 	vector<Connection> idleConnections;
+	/**
+	 * Set by closeConnectionPool(). Once set, no connections are pooled or
+	 * prewarmed anymore. Protected by `connectionPoolLock`.
+	 */
+	bool poolClosed;
 
+	/**
+	 * The maximum number of connections that may be kept. Sockets with
+	 * unlimited concurrency (0) keep up to MAX_CONNECTION_POOL_TARGET
+	 * keep-alive connections. Before, such connections were never pooled.
+	 */
 	OXT_FORCE_INLINE
 	int connectionPoolLimit() const {
-		return concurrency;
+		if (concurrency == 0) {
+			return MAX_CONNECTION_POOL_TARGET;
+		} else {
+			return concurrency;
+		}
 	}
 
 	Connection connect() const {
@@ -96,7 +118,28 @@ private:
 		return connection;
 	}
 
+	/**
+	 * Transfers ownership of the file descriptor of a connection that was
+	 * established with beginConnect() to a Connection object, without
+	 * counting it in `totalConnections`.
+	 */
+	static Connection adoptConnectingFd(NConnect_State &state) {
+		Connection connection;
+		connection.fd = getConnectingFd(state);
+		connection.fail = true;
+		connection.wantKeepAlive = false;
+		connection.blocking = false;
+		if (state.type == SAT_UNIX) {
+			state.s_unix.fd.detach();
+		} else {
+			state.s_tcp.fd.detach();
+		}
+		return connection;
+	}
+
 public:
+	static const int MAX_CONNECTION_POOL_TARGET = 16;
+
 	// Socket properties. Read-only.
 	StaticString name;
 	StaticString address;
@@ -112,13 +155,15 @@ public:
 	int sessions;
 
 	Socket()
-		: pid(-1),
+		: poolClosed(false),
+		  pid(-1),
 		  concurrency(0)
 		{ }
 
 	Socket(pid_t _pid, const StaticString &_name, const StaticString &_address,
 		const StaticString &_protocol, int _concurrency)
-		: name(_name),
+		: poolClosed(false),
+		  name(_name),
 		  address(_address),
 		  protocol(_protocol),
 		  pid(_pid),
@@ -130,6 +175,7 @@ public:
 
 	Socket(const Socket &other)
 		: idleConnections(other.idleConnections),
+		  poolClosed(other.poolClosed),
 		  name(other.name),
 		  address(other.address),
 		  protocol(other.protocol),
@@ -144,6 +190,7 @@ public:
 		totalConnections = other.totalConnections;
 		totalIdleConnections = other.totalIdleConnections;
 		idleConnections = other.idleConnections;
+		poolClosed = other.poolClosed;
 		name = other.name;
 		address = other.address;
 		protocol = other.protocol;
@@ -180,10 +227,172 @@ public:
 		}
 	}
 
-	void checkinConnection(Connection &connection) {
+	/** Returns the file descriptor of a socket set up by beginConnect(). */
+	static int getConnectingFd(const NConnect_State &state) {
+		if (state.type == SAT_UNIX) {
+			return state.s_unix.fd;
+		} else {
+			return state.s_tcp.fd;
+		}
+	}
+
+	/**
+	 * Checks out a connection from the connection pool, if there is one.
+	 * Unlike checkoutConnection(), this never connects to the socket.
+	 */
+	bool checkoutIdleConnection(Connection &connection) {
+		boost::lock_guard<boost::mutex> l(connectionPoolLock);
+
+		if (idleConnections.empty()) {
+			return false;
+		}
+		P_TRACE(3, "Socket " << address << ": checking out connection from connection pool (" <<
+			idleConnections.size() << " -> " << (idleConnections.size() - 1) <<
+			" items). Current total number of connections: " << totalConnections);
+		connection = idleConnections.back();
+		idleConnections.pop_back();
+		totalIdleConnections--;
+		return true;
+	}
+
+	/**
+	 * Begins connecting to this socket without blocking. Drive the connection
+	 * attempt with continueConnect() and, once that returns CONNECTED, obtain
+	 * the Connection with connectionEstablished().
+	 *
+	 * If the state object is destroyed before the connection is established,
+	 * then the connection attempt is aborted.
+	 */
+	ConnectStatus beginConnect(NConnect_State &state) const {
+		P_TRACE(3, "Connecting to " << address << " (non-blocking)");
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(getConnectingFd(state), "App " << pid << " connection");
+		return continueConnect(state);
+	}
+
+	/**
+	 * Continues a connection attempt started by beginConnect().
+	 *
+	 * Unix domain sockets never report a pending connection attempt: if
+	 * the app's accept backlog is full, connect() fails with EAGAIN and must
+	 * simply be retried later. TCP connection attempts stay pending until the
+	 * socket becomes writable.
+	 *
+	 * @throws SystemException The connection attempt failed.
+	 */
+	ConnectStatus continueConnect(NConnect_State &state) const {
+		if (connectToServer(state)) {
+			return CONNECTED;
+		} else if (state.type == SAT_UNIX) {
+			return CONNECT_RETRY_LATER;
+		} else {
+			return CONNECT_WAIT_WRITABLE;
+		}
+	}
+
+	/**
+	 * Transfers ownership of a connection that was established with
+	 * beginConnect() to a Connection object. One MUST call checkinConnection()
+	 * when one's done using the Connection.
+	 */
+	Connection connectionEstablished(NConnect_State &state) {
+		Connection connection = adoptConnectingFd(state);
+		boost::lock_guard<boost::mutex> l(connectionPoolLock);
+		totalConnections++;
+		P_TRACE(3, "Socket " << address << ": there are now " <<
+			totalConnections << " total connections");
+		return connection;
+	}
+
+	/**
+	 * Adds up to `max` new connections to the connection pool, so that
+	 * subsequent sessions don't have to connect first. The total number of
+	 * connections is never grown beyond connectionPoolLimit(). Only
+	 * connection attempts that complete without blocking are kept; this
+	 * never waits for the app to accept a connection. Does nothing unless
+	 * canPrewarmConnections().
+	 *
+	 * @return The number of connections added to the pool.
+	 */
+	unsigned int prewarmConnections(unsigned int max) {
+		unsigned int added = 0;
+
+		while (added < max) {
+			{
+				boost::lock_guard<boost::mutex> l(connectionPoolLock);
+				if (poolClosed || !canPrewarmConnections()
+					|| totalConnections >= connectionPoolLimit())
+				{
+					break;
+				}
+				// Reserve the slot before connecting, so that concurrent
+				// callers cannot grow the pool beyond the limit.
+				totalConnections++;
+			}
+
+			NConnect_State state;
+			bool connected;
+			try {
+				connected = beginConnect(state) == CONNECTED;
+			} catch (const SystemException &e) {
+				P_DEBUG("Socket " << address << ": cannot prewarm a connection: " << e.what());
+				connected = false;
+			}
+			if (!connected) {
+				boost::lock_guard<boost::mutex> l(connectionPoolLock);
+				totalConnections--;
+				break;
+			}
+
+			// checkinConnection() closes the connection instead of pooling
+			// it if closeConnectionPool() was called in the mean time.
+			Connection connection = adoptConnectingFd(state);
+			connection.fail = false;
+			connection.wantKeepAlive = true;
+			if (checkinConnection(connection)) {
+				added++;
+			} else {
+				break;
+			}
+		}
+
+		if (added > 0) {
+			P_TRACE(3, "Socket " << address << ": prewarmed " << added << " connections");
+		}
+		return added;
+	}
+
+	/**
+	 * Tops up the connection pool to its target size (see
+	 * connectionPoolTarget()) using prewarmConnections().
+	 *
+	 * @return The number of connections added to the pool.
+	 */
+	unsigned int fillConnectionPool() {
+		int missing;
+		{
+			boost::lock_guard<boost::mutex> l(connectionPoolLock);
+			missing = connectionPoolTarget() - totalIdleConnections;
+		}
+		if (missing > 0) {
+			return prewarmConnections(missing);
+		} else {
+			return 0;
+		}
+	}
+
+	/**
+	 * Hands a connection back to the connection pool, or closes it if it
+	 * cannot be reused.
+	 *
+	 * @return Whether the connection was added to the connection pool.
+	 */
+	bool checkinConnection(Connection &connection) {
 		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 
-		if (connection.fail || !connection.wantKeepAlive || totalIdleConnections >= connectionPoolLimit()) {
+		if (poolClosed || connection.fail || !connection.wantKeepAlive
+			|| totalIdleConnections >= connectionPoolLimit())
+		{
 			totalConnections--;
 			assert(totalConnections >= 0);
 			P_TRACE(3, "Socket " << address << ": connection not checked back into "
@@ -191,33 +400,85 @@ public:
 				" connections in total");
 			l.unlock();
 			connection.close();
+			return false;
 		} else {
 			P_TRACE(3, "Socket " << address << ": checking in connection into connection pool (" <<
 				totalIdleConnections << " -> " << (totalIdleConnections + 1) <<
 				" items). Current total number of connections: " << totalConnections);
 			totalIdleConnections++;
 			idleConnections.push_back(connection);
+			return true;
 		}
 	}
 
-	void closeAllConnections() {
-		boost::unique_lock<boost::mutex> l(connectionPoolLock);
-		assert(sessions == 0);
-		assert(totalConnections == totalIdleConnections);
-		vector<Connection>::iterator it, end = idleConnections.end();
+	bool hasIdleConnections() {
+		boost::lock_guard<boost::mutex> l(connectionPoolLock);
+		return totalIdleConnections > 0;
+	}
+
+	/**
+	 * Closes all idle connections and stops pooling and prewarming
+	 * connections: connections that are checked in afterwards are closed.
+	 * This is called when the process is detached or shut down, because
+	 * the app may dedicate a handler thread to every connection, and an
+	 * idle connection keeps that thread from finishing.
+	 */
+	void closeConnectionPool() {
+		vector<Connection> connections;
+		{
+			boost::lock_guard<boost::mutex> l(connectionPoolLock);
+			poolClosed = true;
+			connections.swap(idleConnections);
+			totalConnections -= totalIdleConnections;
+			totalIdleConnections = 0;
+			assert(totalConnections >= 0);
+		}
 
-		for (it = idleConnections.begin(); it != end; it++) {
+		vector<Connection>::iterator it, end = connections.end();
+		for (it = connections.begin(); it != end; it++) {
 			try {
 				it->close();
 			} catch (const SystemException &e) {
 				P_ERROR("Cannot close a connection with socket " << address << ": " << e.what());
 			}
 		}
-		idleConnections.clear();
-		totalConnections = 0;
-		totalIdleConnections = 0;
+		if (!connections.empty()) {
+			P_TRACE(3, "Socket " << address << ": closed " << connections.size() <<
+				" idle connections");
+		}
+	}
+
+	void closeAllConnections() {
+		assert(sessions == 0);
+		// Connections that are still being prewarmed are closed
+		// by prewarmConnections() itself.
+		closeConnectionPool();
+	}
+
+
+	/**
+	 * Whether connections may be established before they are needed. Only
+	 * sockets with unlimited concurrency qualify: apps with a limited
+	 * concurrency, such as the Ruby request handler, dedicate a thread to
+	 * every accepted connection until it is closed, so prewarmed
+	 * connections would tie up those threads. Evented apps (e.g. Node.js)
+	 * keep idle connections around at no such cost.
+	 */
+	bool canPrewarmConnections() const {
+		return concurrency == 0;
 	}
 
+	/**
+	 * The number of idle connections that fillConnectionPool() aims for:
+	 * MAX_CONNECTION_POOL_TARGET if canPrewarmConnections(), 0 otherwise.
+	 */
+	int connectionPoolTarget() const {
+		if (canPrewarmConnections()) {
+			return MAX_CONNECTION_POOL_TARGET;
+		} else {
+			return 0;
+		}
+	}
 
 	bool isIdle() const {
 		return sessions == 0;
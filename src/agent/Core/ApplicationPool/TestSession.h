@@ -54,6 +54,7 @@ private:
 	SocketPair connection;
 	BufferedIO peerBufferedIO;
 	unsigned int stickySessionId;
+	unsigned int initiateRetries;
 	mutable bool closed;
 	mutable bool success;
 	mutable bool wantKeepAlive;
@@ -65,6 +66,7 @@ public:
 		  gupid("gupid-123"),
 		  protocol("session"),
 		  stickySessionId(0),
+		  initiateRetries(0),
 		  closed(false),
 		  success(false),
 		  wantKeepAlive(false)
@@ -172,6 +174,32 @@ public:
 		}
 	}
 
+	/**
+	 * Makes beginInitiate() and continueInitiate() ask the caller to retry
+	 * the given number of times before the session is initiated, as if the
+	 * app's accept backlog were full.
+	 */
+	void setInitiateRetries(unsigned int n) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		initiateRetries = n;
+	}
+
+	virtual InitiateStatus beginInitiate() {
+		return continueInitiate();
+	}
+
+	virtual InitiateStatus continueInitiate() {
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			if (initiateRetries > 0) {
+				initiateRetries--;
+				return INITIATE_RETRY_LATER;
+			}
+		}
+		initiate(false);
+		return INITIATED;
+	}
+
 	virtual void close(bool _success, bool _wantKeepAlive = false) {
 		boost::lock_guard<boost::mutex> l(syncher);
 		closed = true;
@@ -83,6 +83,7 @@
 #include <Core/Controller/Client.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/Controller/TurboCaching.h>
+#include <Core/SharedResponseCache.h>
 #include <Core/UnionStation/Context.h>
 
 namespace Passenger {
@@ -93,11 +94,6 @@ using namespace oxt;
 using namespace ApplicationPool2;
 
 
-namespace ServerKit {
-	extern const HashedStaticString HTTP_COOKIE;
-	extern const HashedStaticString HTTP_SET_COOKIE;
-}
-
 namespace Core {
 
 
@@ -114,10 +110,22 @@ private:
 	// If you change this value, make sure that Request::sessionCheckoutTry
 	// has enough bits.
 	static const unsigned int MAX_SESSION_CHECKOUT_TRY = 10;
+	// Request and response bodies with at least this many bytes remaining
+	// are forwarded with splice() if possible.
+	static const unsigned int MIN_SPLICE_SIZE = 64 * 1024;
+	// The maximum number of splice() calls per event loop iteration, so that
+	// a fast app and client do not starve other clients.
+	static const unsigned int SPLICE_BURST_COUNT = 16;
 
 	ControllerMainConfig mainConfig;
 	ControllerRequestConfigPtr requestConfig;
 	StringKeyTable< boost::shared_ptr<Options> > poolOptionsCache;
+	/**
+	 * Routing hints for the application pool, keyed by app group name.
+	 * Each Controller runs on its own event loop thread, so these let
+	 * that thread stick to the same (idle) application process.
+	 */
+	StringKeyTable<RoutingAffinity> routingAffinities;
 
 	HashedStaticString PASSENGER_APP_GROUP_NAME;
 	HashedStaticString PASSENGER_ENV_VARS;
@@ -131,23 +139,18 @@ private:
 	HashedStaticString REMOTE_PORT;
 	HashedStaticString REMOTE_USER;
 	HashedStaticString FLAGS;
-	HashedStaticString HTTP_COOKIE;
-	HashedStaticString HTTP_DATE;
-	HashedStaticString HTTP_HOST;
-	HashedStaticString HTTP_CONTENT_LENGTH;
-	HashedStaticString HTTP_CONTENT_TYPE;
-	HashedStaticString HTTP_EXPECT;
-	HashedStaticString HTTP_CONNECTION;
-	HashedStaticString HTTP_STATUS;
-	HashedStaticString HTTP_TRANSFER_ENCODING;
 
 	friend class TurboCaching<Request>;
 	friend class ResponseCache<Request>;
 	struct ev_check checkWatcher;
+	struct ev_prepare prepareWatcher;
 	TurboCaching<Request> turboCaching;
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		ServerKit::SplicePipePool splicePipePool;
+		boost::uint64_t totalBytesSpliced;
+	#endif
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		struct ev_prepare prepareWatcher;
 		ev_tstamp timeBeforeBlocking;
 	#endif
 
@@ -158,6 +161,11 @@ private:
 
 	void initializeFlags(Client *client, Request *req, RequestAnalysis &analysis);
 	bool respondFromTurboCache(Client *client, Request *req);
+	void writeTurboCacheResponse(Client **client, Request **req,
+		ResponseCache<Request>::Entry &entry);
+	void waitForTurboCacheFill(Client *client, Request *req);
+	void finishTurboCacheFill(Client *client, Request *req);
+	bool respondWithStaleTurboCacheEntry(Client **client, Request **req);
 	void initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis);
 	void fillPoolOptionsFromConfigCaches(Options &options, psg_pool_t *pool,
 		const ControllerRequestConfigPtr &requestConfigCache);
@@ -193,6 +201,7 @@ private:
 	/****** Stage: checkout session ******/
 
 	void checkoutSession(Client *client, Request *req);
+	RoutingAffinity *lookupRoutingAffinity(const HashedStaticString &appGroupName);
 	static void sessionCheckedOut(const AbstractSessionPtr &session,
 		const ExceptionPtr &e, void *userData);
 	void sessionCheckedOutFromAnotherThread(Client *client, Request *req,
@@ -201,6 +210,16 @@ private:
 		const AbstractSessionPtr &session, const ExceptionPtr &e);
 	void maybeSend100Continue(Client *client, Request *req);
 	void initiateSession(Client *client, Request *req);
+	void continueInitiatingSession(Client *client, Request *req);
+	void waitForAppConnection(Client *client, Request *req,
+		AbstractSession::InitiateStatus status);
+	void stopWaitingForAppConnection(Request *req);
+	static void onAppConnectionEvent(EV_P_ struct ev_io *io, int revents);
+	static void onAppConnectionRetryTimeout(EV_P_ struct ev_timer *timer, int revents);
+	static void onAppConnectionTimeout(EV_P_ struct ev_timer *timer, int revents);
+	void sessionInitiated(Client *client, Request *req);
+	void handleSessionInitiateError(Client *client, Request *req,
+		const StaticString &error);
 	static void checkoutSessionLater(Request *req);
 	void reportSessionCheckoutError(Client *client, Request *req,
 		const ExceptionPtr &e);
@@ -224,9 +243,9 @@ private:
 	void sendHeaderToAppWithSessionProtocol(Client *client, Request *req);
 	static void sendBodyToAppWhenAppSinkIdle(Channel *_channel, unsigned int size);
 	unsigned int determineHeaderSizeForSessionProtocol(Request *req,
-		SessionProtocolWorkingState &state, string delta_monotonic);
+		SessionProtocolWorkingState &state, const StaticString &delta_monotonic);
 	bool constructHeaderForSessionProtocol(Request *req, char * restrict buffer,
-		unsigned int &size, const SessionProtocolWorkingState &state, string delta_monotonic);
+		unsigned int &size, const SessionProtocolWorkingState &state, const StaticString &delta_monotonic);
 	void sendHeaderToAppWithHttpProtocol(Client *client, Request *req);
 	bool constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *buffers,
 		unsigned int maxbuffers, unsigned int & restrict_ref nbuffers,
@@ -244,6 +263,14 @@ private:
 	void startBodyChannel(Client *client, Request *req);
 	void stopBodyChannel(Client *client, Request *req);
 	void logAppSocketWriteError(Client *client, int errcode);
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		bool canSpliceRequestBody(Client *client, Request *req) const;
+		void beginSplicingRequestBody(Client *client, Request *req);
+		static void onRequestBodySplicingEvent(EV_P_ struct ev_io *io, int revents);
+		void spliceRequestBody(Client *client, Request *req);
+		void disconnectWithRequestBodySpliceError(Client **client, Request *req,
+			int errcode);
+	#endif
 
 
 	/****** Stage: forward application response to client ******/
@@ -286,6 +313,12 @@ private:
 	static void _outputDataFlushed(FileBufferedChannel *_channel);
 	void outputDataFlushed(Client *client, Request *req);
 	void handleAppResponseBodyEnd(Client *client, Request *req);
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		bool canSpliceAppResponseBody(Client *client, Request *req) const;
+		void beginSplicingAppResponseBody(Client *client, Request *req);
+		static void onResponseSplicingEvent(EV_P_ struct ev_io *io, int revents);
+		void spliceAppResponseBody(Client *client, Request *req);
+	#endif
 	OXT_FORCE_INLINE void keepAliveAppConnection(Client *client, Request *req);
 	void storeAppResponseInTurboCache(Client *client, Request *req);
 	void finalizeUnionStationWithSuccess(Client *client, Request *req);
@@ -295,14 +328,17 @@ private:
 
 	static Channel::Result onBodyBufferData(Channel *_channel,
 		const MemoryKit::mbuf &buffer, int errcode);
-	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		static void onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents);
-	#endif
+	static void onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents);
 	static void onEventLoopCheck(EV_P_ struct ev_check *w, int revents);
 
 
 	/****** Internal utility functions ******/
 
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		Request::Splicing *createSplicing(Client *client, Request *req,
+			int sourceFd, int sinkFd, void (*callback)(EV_P_ struct ev_io *io, int revents));
+		void destroySplicing(Request::Splicing *&splicing);
+	#endif
 	void disconnectWithClientSocketWriteError(Client **client, int e);
 	void disconnectWithAppSocketIncompleteResponseError(Client **client);
 	void disconnectWithAppSocketReadError(Client **client, int e);
@@ -351,6 +387,7 @@ protected:
 	virtual void onNextRequestEarlyReadError(Client *client, Request *req, int errcode);
 	virtual bool shouldDisconnectClientOnShutdown(Client *client);
 	virtual bool supportsUpgrade(Client *client, Request *req);
+	virtual bool isReadingRequestBodyDirectly(Client *client, Request *req);
 
 
 	/****** Marked virtual so that unit tests can mock these ******/
@@ -364,6 +401,7 @@ public:
 	ResourceLocator *resourceLocator;
 	PoolPtr appPool;
 	UnionStation::ContextPtr unionStationContext;
+	SharedResponseCachePtr sharedResponseCache;
 
 
 	/****** Initialization and shutdown ******/
@@ -391,6 +429,9 @@ public:
 	/****** State and configuration ******/
 
 	unsigned int getThreadNumber() const; // Thread-safe
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		boost::uint64_t getTotalBytesSpliced() const;
+	#endif
 	virtual Json::Value inspectStateAsJson() const;
 	virtual Json::Value inspectClientStateAsJson(const Client *client) const;
 	virtual Json::Value inspectRequestStateAsJson(const Request *req) const;
@@ -125,7 +125,7 @@ Controller::whenBufferingBody_onRequestBody(Client *client, Request *req,
 			header->hash = HashedStaticString("content-length",
 				sizeof("content-length") - 1).hash();
 
-			req->headers.erase(HTTP_TRANSFER_ENCODING);
+			req->headers.erase(ServerKit::KNOWN_HEADER_TRANSFER_ENCODING);
 			req->headers.insert(&header, req->pool);
 		}
 		req->endStopwatchLog(&req->stopwatchLogs.bufferingRequestBody);
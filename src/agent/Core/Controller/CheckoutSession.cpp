@@ -81,12 +81,22 @@ Controller::checkoutSession(Client *client, Request *req) {
 	#endif
 }
 
+RoutingAffinity *
+Controller::lookupRoutingAffinity(const HashedStaticString &appGroupName) {
+	RoutingAffinity *affinity;
+	if (!routingAffinities.lookup(appGroupName, &affinity)) {
+		affinity = &routingAffinities.insert(appGroupName, RoutingAffinity())->value;
+	}
+	return affinity;
+}
+
 void
 Controller::asyncGetFromApplicationPool(Request *req, ApplicationPool2::GetCallback callback) {
 	appPool->asyncGet(req->options, callback, true,
 		req->useUnionStation()
 		? &req->stopwatchLogs.getFromPool
-		: NULL);
+		: NULL,
+		lookupRoutingAffinity(req->options.getAppGroupName()));
 }
 
 void
@@ -157,7 +167,7 @@ Controller::maybeSend100Continue(Client *client, Request *req) {
 	if (httpVersion >= 1010 && req->hasBody() && !req->strip100ContinueHeader) {
 		// Apps with the "session" protocol don't respond with 100-Continue,
 		// so we do it for them.
-		const LString *value = req->headers.lookup(HTTP_EXPECT);
+		const LString *value = req->headers.lookup(ServerKit::KNOWN_HEADER_EXPECT);
 		if (value != NULL
 		 && psg_lstr_cmp(value, P_STATIC_STRING("100-continue"))
 		 && req->session->getProtocol() == P_STATIC_STRING("session"))
@@ -178,25 +188,135 @@ Controller::maybeSend100Continue(Client *client, Request *req) {
 void
 Controller::initiateSession(Client *client, Request *req) {
 	TRACE_POINT();
+	AbstractSession::InitiateStatus status;
+
 	req->sessionCheckoutTry++;
 	try {
-		req->session->initiate(false);
+		status = req->session->beginInitiate();
 	} catch (const SystemException &e2) {
-		if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
-			SKC_DEBUG(client, "Error checking out session (" << e2.what() <<
-				"); retrying (attempt " << req->sessionCheckoutTry << ")");
-			refRequest(req, __FILE__, __LINE__);
-			getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
-		} else {
-			string message = "could not initiate a session (";
-			message.append(e2.what());
-			message.append(")");
-			disconnectWithError(&client, message);
-		}
+		handleSessionInitiateError(client, req, e2.what());
 		return;
 	}
 
-	UPDATE_TRACE_POINT();
+	if (status == AbstractSession::INITIATED) {
+		sessionInitiated(client, req);
+	} else {
+		waitForAppConnection(client, req, status);
+	}
+}
+
+void
+Controller::continueInitiatingSession(Client *client, Request *req) {
+	TRACE_POINT();
+	AbstractSession::InitiateStatus status;
+
+	try {
+		status = req->session->continueInitiate();
+	} catch (const SystemException &e2) {
+		stopWaitingForAppConnection(req);
+		handleSessionInitiateError(client, req, e2.what());
+		return;
+	}
+
+	if (status == AbstractSession::INITIATED) {
+		stopWaitingForAppConnection(req);
+		sessionInitiated(client, req);
+	} else {
+		waitForAppConnection(client, req, status);
+	}
+}
+
+/**
+ * Waits, without blocking the event loop, until the connection attempt
+ * started by `req->session->beginInitiate()` can make progress. The
+ * attempt as a whole is bounded by the `app_connect_timeout` option.
+ */
+void
+Controller::waitForAppConnection(Client *client, Request *req,
+	AbstractSession::InitiateStatus status)
+{
+	Request::AppConnection *conn = req->appConnection;
+
+	if (conn == NULL) {
+		conn = (Request::AppConnection *) psg_palloc(req->pool,
+			sizeof(Request::AppConnection));
+		ev_io_init(&conn->watcher, onAppConnectionEvent, -1, EV_WRITE);
+		ev_timer_init(&conn->retryTimer, onAppConnectionRetryTimeout, 0, 0);
+		ev_timer_init(&conn->timeoutTimer, onAppConnectionTimeout, 0, 0);
+		conn->watcher.data = req;
+		conn->retryTimer.data = req;
+		conn->timeoutTimer.data = req;
+		req->appConnection = conn;
+	}
+
+	if (!ev_is_active(&conn->timeoutTimer)) {
+		SKC_DEBUG(client, "Waiting for the application to accept the connection");
+		conn->retryDelay = 0.001;
+		if (mainConfig.appConnectTimeout > 0) {
+			ev_timer_set(&conn->timeoutTimer, mainConfig.appConnectTimeout / 1000.0, 0);
+			ev_timer_start(getLoop(), &conn->timeoutTimer);
+		}
+	}
+
+	if (status == AbstractSession::INITIATE_WAIT_WRITABLE) {
+		ev_io_set(&conn->watcher, req->session->fd(), EV_WRITE);
+		ev_io_start(getLoop(), &conn->watcher);
+	} else {
+		ev_timer_set(&conn->retryTimer, conn->retryDelay, 0);
+		ev_timer_start(getLoop(), &conn->retryTimer);
+		conn->retryDelay = std::min<ev_tstamp>(conn->retryDelay * 2, 0.05);
+	}
+}
+
+void
+Controller::stopWaitingForAppConnection(Request *req) {
+	Request::AppConnection *conn = req->appConnection;
+	if (conn != NULL) {
+		ev_io_stop(getLoop(), &conn->watcher);
+		ev_timer_stop(getLoop(), &conn->retryTimer);
+		ev_timer_stop(getLoop(), &conn->timeoutTimer);
+	}
+}
+
+void
+Controller::onAppConnectionEvent(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectionEvent");
+
+	ev_io_stop(EV_A_ io);
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::onAppConnectionRetryTimeout(EV_P_ struct ev_timer *timer, int revents) {
+	Request *req = static_cast<Request *>(timer->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectionRetryTimeout");
+
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::onAppConnectionTimeout(EV_P_ struct ev_timer *timer, int revents) {
+	Request *req = static_cast<Request *>(timer->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectionTimeout");
+
+	self->stopWaitingForAppConnection(req);
+	// The process is merely too busy to accept connections, so we
+	// don't detach it, but we do try another one.
+	req->session->close(false);
+	self->handleSessionInitiateError(client, req,
+		"timed out connecting to the application");
+}
+
+void
+Controller::sessionInitiated(Client *client, Request *req) {
+	TRACE_POINT();
 	if (req->useUnionStation()) {
 		req->endStopwatchLog(&req->stopwatchLogs.getFromPool);
 		req->logMessage("Application PID: " +
@@ -215,6 +335,23 @@ Controller::initiateSession(Client *client, Request *req) {
 	sendHeaderToApp(client, req);
 }
 
+void
+Controller::handleSessionInitiateError(Client *client, Request *req,
+	const StaticString &error)
+{
+	if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
+		SKC_DEBUG(client, "Error checking out session (" << error <<
+			"); retrying (attempt " << req->sessionCheckoutTry << ")");
+		refRequest(req, __FILE__, __LINE__);
+		getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
+	} else {
+		string message = "could not initiate a session (";
+		message.append(error.data(), error.size());
+		message.append(")");
+		disconnectWithError(&client, message);
+	}
+}
+
 void
 Controller::checkoutSessionLater(Request *req) {
 	Client *client = static_cast<Client *>(req->client);
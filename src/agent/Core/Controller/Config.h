@@ -78,6 +78,10 @@ private:
 		add("thread_number", UINT_TYPE, REQUIRED | READ_ONLY);
 		add("multi_app", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
 		add("turbocaching", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
+		add("turbocache_max_entries", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_ENTRIES);
+		add("turbocache_max_memory", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_MEMORY);
+		add("turbocache_max_body_size", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+		add("turbocache_shared", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
 		add("integration_mode", STRING_TYPE, OPTIONAL | READ_ONLY, DEFAULT_INTEGRATION_MODE);
 
 		add("user_switching", BOOL_TYPE, OPTIONAL, true);
@@ -85,6 +89,7 @@ private:
 		add("show_version_in_header", BOOL_TYPE, OPTIONAL, true);
 		add("data_buffer_dir", STRING_TYPE, OPTIONAL, getSystemTempDir());
 		add("response_buffer_high_watermark", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+		add("app_connect_timeout", UINT_TYPE, OPTIONAL, DEFAULT_APP_CONNECT_TIMEOUT);
 		add("sticky_sessions", BOOL_TYPE, OPTIONAL, false);
 		add("core_graceful_exit", BOOL_TYPE, OPTIONAL, true);
 		add("benchmark_mode", STRING_TYPE, OPTIONAL);
@@ -109,6 +114,8 @@ private:
 		add("meteor_app_settings", STRING_TYPE, OPTIONAL);
 		add("app_file_descriptor_ulimit", UINT_TYPE, OPTIONAL);
 		add("min_instances", UINT_TYPE, OPTIONAL, 1);
+		add("spawn_concurrency", UINT_TYPE, OPTIONAL, DEFAULT_SPAWN_CONCURRENCY);
+		add("predictive_spawning", BOOL_TYPE, OPTIONAL, false);
 		add("max_preloader_idle_time", UINT_TYPE, OPTIONAL, DEFAULT_MAX_PRELOADER_IDLE_TIME);
 		add("max_request_queue_size", UINT_TYPE, OPTIONAL, DEFAULT_MAX_REQUEST_QUEUE_SIZE);
 		add("force_max_concurrent_requests_per_process", INT_TYPE, OPTIONAL, -1);
@@ -153,6 +160,9 @@ private:
 		if (mode == BM_UNKNOWN) {
 			errors.push_back(Error("'{{benchmark_mode}}' is not set to a valid value"));
 		}
+		if (config["turbocache_max_entries"].asUInt() == 0) {
+			errors.push_back(Error("'{{turbocache_max_entries}}' must be at least 1"));
+		}
 	}
 
 	static void validateMultiAppMode(const ConfigKit::Store &config,
@@ -248,6 +258,7 @@ public:
 	unsigned int threadNumber;
 	unsigned int statThrottleRate;
 	unsigned int responseBufferHighWatermark;
+	unsigned int appConnectTimeout;
 	StaticString integrationMode;
 	StaticString serverLogName;
 	ControllerBenchmarkMode benchmarkMode: 3;
@@ -264,6 +275,7 @@ public:
 		  threadNumber(config["thread_number"].asUInt()),
 		  statThrottleRate(config["stat_throttle_rate"].asUInt()),
 		  responseBufferHighWatermark(config["response_buffer_high_watermark"].asUInt()),
+		  appConnectTimeout(config["app_connect_timeout"].asUInt()),
 		  integrationMode(psg_pstrdup(pool, config["integration_mode"].asString())),
 		  serverLogName(createServerLogName()),
 		  benchmarkMode(parseControllerBenchmarkMode(config["benchmark_mode"].asString())),
@@ -292,6 +304,7 @@ public:
 		std::swap(threadNumber, other.threadNumber);
 		std::swap(statThrottleRate, other.statThrottleRate);
 		std::swap(responseBufferHighWatermark, other.responseBufferHighWatermark);
+		std::swap(appConnectTimeout, other.appConnectTimeout);
 		std::swap(integrationMode, other.integrationMode);
 		std::swap(serverLogName, other.serverLogName);
 		SWAP_BITFIELD(ControllerBenchmarkMode, benchmarkMode);
@@ -338,6 +351,7 @@ public:
 	StaticString meteorAppSettings;
 	unsigned int fileDescriptorUlimit;
 	unsigned int minInstances;
+	unsigned int spawnConcurrency;
 	unsigned int maxPreloaderIdleTime;
 	unsigned int maxRequestQueueSize;
 	unsigned int maxRequests;
@@ -346,6 +360,7 @@ public:
 	bool showVersionInHeader: 1;
 	bool abortWebsocketsOnProcessShutdown;
 	bool loadShellEnvvars;
+	bool predictiveSpawning;
 
 	/*******************/
 	/*******************/
@@ -372,6 +387,7 @@ public:
 		  meteorAppSettings(psg_pstrdup(pool, config["meteor_app_settings"].asString())),
 		  fileDescriptorUlimit(config["app_file_descriptor_ulimit"].asUInt()),
 		  minInstances(config["min_instances"].asUInt()),
+		  spawnConcurrency(config["spawn_concurrency"].asUInt()),
 		  maxPreloaderIdleTime(config["max_preloader_idle_time"].asUInt()),
 		  maxRequestQueueSize(config["max_request_queue_size"].asUInt()),
 		  maxRequests(config["max_requests"].asUInt()),
@@ -379,7 +395,8 @@ public:
 		  singleAppMode(!config["multi_app"].asBool()),
 		  showVersionInHeader(config["show_version_in_header"].asBool()),
 		  abortWebsocketsOnProcessShutdown(config["abort_websockets_on_process_shutdown"].asBool()),
-		  loadShellEnvvars(config["load_shell_envvars"].asBool())
+		  loadShellEnvvars(config["load_shell_envvars"].asBool()),
+		  predictiveSpawning(config["predictive_spawning"].asBool())
 
 		  /*******************/
 		{ }
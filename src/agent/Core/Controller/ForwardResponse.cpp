@@ -165,6 +165,10 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 						SKC_TRACE(client, 2, "End of application response body reached");
 						handleAppResponseBodyEnd(client, req);
 						endRequest(&client, &req);
+					#ifdef SERVER_KIT_HAVE_SPLICE
+						} else if (canSpliceAppResponseBody(client, req)) {
+							beginSplicingAppResponseBody(client, req);
+					#endif
 					} else {
 						maybeThrottleAppSource(client, req);
 					}
@@ -204,8 +208,13 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 			SKC_TRACE(client, 3, "Processing " << buffer.size() <<
 				" bytes of application data: \"" << cEscapeString(StaticString(
 					buffer.start, buffer.size())) << "\"");
+			// Unless we need the dechunked data, the parser may skip over all
+			// chunks in the buffer, so that we forward the buffer in one go
+			// instead of one chunk at a time.
+			bool needChunkData = req->dechunkResponse
+				|| (turboCaching.isEnabled() && !req->cacheKey.empty());
 			ServerKit::HttpChunkedEvent event(createAppResponseChunkedBodyParser(req)
-				.feed(buffer));
+				.feed(buffer, needChunkData));
 			resp->bodyAlreadyRead += event.consumed;
 
 			if (req->dechunkResponse) {
@@ -319,6 +328,10 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	ssize_t bytesWritten;
 	bool oobw;
 
+	if (resp->statusCode >= 500 && respondWithStaleTurboCacheEntry(&client, &req)) {
+		return;
+	}
+
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeOnRequestHeaderSent = ev_now(getLoop());
 		reportLargeTimeDiff(client,
@@ -329,8 +342,8 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 
 	// Localize hash table operations for better CPU caching.
 	oobw = resp->secureHeaders.lookup(PASSENGER_REQUEST_OOB_WORK) != NULL;
-	resp->date = resp->headers.lookup(HTTP_DATE);
-	resp->setCookie = resp->headers.lookup(ServerKit::HTTP_SET_COOKIE);
+	resp->date = resp->headers.lookup(ServerKit::KNOWN_HEADER_DATE);
+	resp->setCookie = resp->headers.lookup(ServerKit::KNOWN_HEADER_SET_COOKIE);
 	if (resp->setCookie != NULL) {
 		// Move the Set-Cookie header from resp->headers to resp->setCookie;
 		// remove Set-Cookie from resp->headers without deallocating it.
@@ -342,23 +355,23 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 
 		P_ASSERT_EQ(resp->setCookie->size, 0);
 		psg_lstr_append(resp->setCookie, req->pool, "x", 1);
-		resp->headers.erase(ServerKit::HTTP_SET_COOKIE);
+		resp->headers.erase(ServerKit::KNOWN_HEADER_SET_COOKIE);
 
 		resp->setCookie = copy;
 	}
-	resp->headers.erase(HTTP_CONNECTION);
-	resp->headers.erase(HTTP_STATUS);
+	resp->headers.erase(ServerKit::KNOWN_HEADER_CONNECTION);
+	resp->headers.erase(ServerKit::KNOWN_HEADER_STATUS);
 	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
-		resp->headers.erase(HTTP_CONTENT_LENGTH);
+		resp->headers.erase(ServerKit::KNOWN_HEADER_CONTENT_LENGTH);
 	}
 	if (resp->bodyType == AppResponse::RBT_CHUNKED) {
-		resp->headers.erase(HTTP_TRANSFER_ENCODING);
+		resp->headers.erase(ServerKit::KNOWN_HEADER_TRANSFER_ENCODING);
 		if (req->dechunkResponse) {
 			req->wantKeepAlive = false;
 		}
 	}
-	if (resp->headers.lookup(ServerKit::HTTP_X_SENDFILE) != NULL
-	 || resp->headers.lookup(ServerKit::HTTP_X_ACCEL_REDIRECT) != NULL)
+	if (resp->headers.lookup(ServerKit::KNOWN_HEADER_X_SENDFILE) != NULL
+	 || resp->headers.lookup(ServerKit::KNOWN_HEADER_X_ACCEL_REDIRECT) != NULL)
 	{
 		// If X-Sendfile or X-Accel-Redirect is set, then HttpHeaderParser
 		// treats the app response as having no body, and removes the
@@ -406,13 +419,13 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		 && turboCaching.responseCache.prepareRequestForStoring(req))
 		{
 			if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
-			 && resp->aux.bodyInfo.contentLength > ResponseCache<Request>::MAX_BODY_SIZE)
+			 && resp->aux.bodyInfo.contentLength > turboCaching.responseCache.getMaxBodySize())
 			{
 				SKC_DEBUG(client, "Response body larger than " <<
-					ResponseCache<Request>::MAX_BODY_SIZE <<
+					turboCaching.responseCache.getMaxBodySize() <<
 					" bytes, so response is not eligible for turbocaching");
 				// Decrease store success ratio.
-				turboCaching.responseCache.incStores();
+				turboCaching.responseCache.incStores(req);
 				req->cacheKey = HashedStaticString();
 			}
 		} else if (turboCaching.responseCache.requestAllowsInvalidating(req)) {
@@ -423,7 +436,7 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		} else {
 			SKC_TRACE(client, 2, "Turbocache: response not eligible for turbocaching");
 			// Decrease store success ratio.
-			turboCaching.responseCache.incStores();
+			turboCaching.responseCache.incStores(req);
 			req->cacheKey = HashedStaticString();
 		}
 	}
@@ -939,7 +952,7 @@ Controller::markHeaderBuffersForTurboCaching(Client *client, Request *req,
 				ResponseCache<Request>::MAX_HEADER_SIZE <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
-			turboCaching.responseCache.incStores();
+			turboCaching.responseCache.incStores(req);
 			req->cacheKey = HashedStaticString();
 		} else {
 			req->appResponse.headerCacheBuffers = buffers;
@@ -995,12 +1008,12 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 {
 	if (!req->ended() && turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		unsigned int totalSize = req->appResponse.bodyCacheBuffer.size + buffer.size();
-		if (totalSize > ResponseCache<Request>::MAX_BODY_SIZE) {
+		if (totalSize > turboCaching.responseCache.getMaxBodySize()) {
 			SKC_DEBUG(client, "Response body larger than " <<
-				ResponseCache<Request>::MAX_HEADER_SIZE <<
+				turboCaching.responseCache.getMaxBodySize() <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
-			turboCaching.responseCache.incStores();
+			turboCaching.responseCache.incStores(req);
 			req->cacheKey = HashedStaticString();
 			psg_lstr_deinit(&req->appResponse.bodyCacheBuffer);
 		} else {
@@ -1078,10 +1091,138 @@ Controller::outputDataFlushed(Client *client, Request *req) {
 	}
 }
 
+#ifdef SERVER_KIT_HAVE_SPLICE
+
+/**
+ * Whether the rest of the response body can be moved from the app socket
+ * to the client socket with splice(), without passing through user space.
+ * That is only possible if we don't need to look at the data, and if
+ * everything we wrote to the client so far has reached the kernel.
+ */
+bool
+Controller::canSpliceAppResponseBody(Client *client, Request *req) const {
+	const AppResponse *resp = &req->appResponse;
+	return resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH
+		&& resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead >= MIN_SPLICE_SIZE
+		&& req->cacheKey.empty()
+		&& mainConfig.benchmarkMode == BM_NONE
+		&& client->output.getTotalBytesBuffered() == 0
+		&& client->output.getState() == Channel::IDLE
+		&& !client->output.ended()
+		// With io_uring, a read may be in flight on the app socket.
+		&& !getContext()->usingIoUring();
+}
+
+void
+Controller::beginSplicingAppResponseBody(Client *client, Request *req) {
+	Request::Splicing *splicing = createSplicing(client, req,
+		req->appSource.getFd(), client->getFd(), onResponseSplicingEvent);
+	if (splicing == NULL) {
+		maybeThrottleAppSource(client, req);
+		return;
+	}
+
+	SKC_TRACE(client, 2, "Splicing the rest of the application response body"
+		" to the client");
+	req->appSource.stop();
+	req->responseSplicing = splicing;
+	ev_io_start(getLoop(), &splicing->sourceWatcher);
+}
+
+void
+Controller::onResponseSplicingEvent(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+
+	ev_io_stop(EV_A_ io);
+	self->refRequest(req, __FILE__, __LINE__);
+	self->spliceAppResponseBody(client, req);
+	self->unrefRequest(req, __FILE__, __LINE__);
+}
+
+void
+Controller::spliceAppResponseBody(Client *client, Request *req) {
+	TRACE_POINT();
+	Request::Splicing *splicing = req->responseSplicing;
+	AppResponse *resp = &req->appResponse;
+	ssize_t ret;
+	int e;
+
+	for (unsigned int i = 0; i < SPLICE_BURST_COUNT; i++) {
+		if (splicing->bytesInPipe > 0) {
+			do {
+				ret = splice(splicing->pipe.readEnd, NULL, client->getFd(), NULL,
+					splicing->bytesInPipe, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+			if (ret == -1) {
+				e = errno;
+				if (e == EAGAIN || e == EWOULDBLOCK) {
+					ev_io_start(getLoop(), &splicing->sinkWatcher);
+				} else {
+					UPDATE_TRACE_POINT();
+					disconnectWithClientSocketWriteError(&client, e);
+				}
+				return;
+			}
+			splicing->bytesInPipe -= ret;
+			totalBytesSpliced += ret;
+
+		} else if (resp->bodyFullyRead()) {
+			UPDATE_TRACE_POINT();
+			SKC_TRACE(client, 2, "End of application response body reached");
+			destroySplicing(req->responseSplicing);
+			handleAppResponseBodyEnd(client, req);
+			endRequest(&client, &req);
+			return;
+
+		} else {
+			boost::uint64_t remaining = resp->aux.bodyInfo.contentLength
+				- resp->bodyAlreadyRead;
+			do {
+				ret = splice(req->appSource.getFd(), NULL, splicing->pipe.writeEnd, NULL,
+					std::min<boost::uint64_t>(remaining, ServerKit::SplicePipePool::PIPE_SIZE),
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+			if (ret == -1) {
+				e = errno;
+				if (e == EAGAIN || e == EWOULDBLOCK) {
+					ev_io_start(getLoop(), &splicing->sourceWatcher);
+				} else {
+					UPDATE_TRACE_POINT();
+					endRequestWithAppSocketReadError(&client, &req, e);
+				}
+				return;
+			} else if (ret == 0) {
+				UPDATE_TRACE_POINT();
+				SKC_WARN(client, "Application sent EOF before finishing response body: " <<
+					resp->bodyAlreadyRead << " bytes already read, " <<
+					resp->aux.bodyInfo.contentLength << " bytes expected");
+				endRequestWithAppSocketIncompleteResponse(&client, &req);
+				return;
+			}
+			resp->bodyAlreadyRead += ret;
+			splicing->bytesInPipe += ret;
+		}
+	}
+
+	// Give other clients a chance before continuing.
+	if (splicing->bytesInPipe > 0) {
+		ev_io_start(getLoop(), &splicing->sinkWatcher);
+	} else {
+		ev_io_start(getLoop(), &splicing->sourceWatcher);
+	}
+}
+
+#endif /* SERVER_KIT_HAVE_SPLICE */
+
 void
 Controller::handleAppResponseBodyEnd(Client *client, Request *req) {
 	keepAliveAppConnection(client, req);
 	storeAppResponseInTurboCache(client, req);
+	if (req->turboCacheFillState == Request::TCF_FILLING) {
+		finishTurboCacheFill(client, req);
+	}
 	finalizeUnionStationWithSuccess(client, req);
 	assert(!req->ended());
 }
@@ -1127,18 +1268,19 @@ Controller::storeAppResponseInTurboCache(Client *client, Request *req) {
 			SKC_DEBUG(client, "Storing app response in turbocache");
 			SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
-			gatherBuffers(entry.body->httpHeaderData,
-				ResponseCache<Request>::MAX_HEADER_SIZE,
+			gatherBuffers(entry.body->getHttpHeaderData(),
+				entry.body->httpHeaderSize,
 				resp->headerCacheBuffers, resp->nHeaderCacheBuffers);
 
-			char *pos = entry.body->httpBodyData;
-			const char *end = entry.body->httpBodyData
-				+ ResponseCache<Request>::MAX_BODY_SIZE;
+			char *pos = entry.body->getHttpBodyData();
+			const char *end = entry.body->getHttpBodyData()
+				+ entry.body->httpBodySize;
 			const LString::Part *part = resp->bodyCacheBuffer.start;
 			while (part != NULL) {
 				pos = appendData(pos, end, part->data, part->size);
 				part = part->next;
 			}
+			turboCaching.responseCache.commit(entry);
 		} else {
 			SKC_DEBUG(client, "Could not store app response for turbocaching");
 		}
@@ -60,14 +60,15 @@ Controller::onBodyBufferData(Channel *_channel, const MemoryKit::mbuf &buffer, i
 	return self->whenSendingRequest_onRequestBody(client, req, buffer, errcode);
 }
 
-#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-	void
-	Controller::onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents) {
-		Controller *self = static_cast<Controller *>(w->data);
+void
+Controller::onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents) {
+	Controller *self = static_cast<Controller *>(w->data);
+	self->turboCaching.beforeBlocking();
+	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		ev_now_update(EV_A);
 		self->timeBeforeBlocking = ev_now(EV_A);
-	}
-#endif
+	#endif
+}
 
 void
 Controller::onEventLoopCheck(EV_P_ struct ev_check *w, int revents) {
@@ -131,6 +132,7 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->stickySession = false;
 	req->sessionCheckoutTry = 0;
 	req->halfClosePolicy = Request::HALF_CLOSE_POLICY_UNINITIALIZED;
+	req->turboCacheFillState = Request::TCF_NONE;
 	req->appResponseInitialized = false;
 	req->strip100ContinueHeader = false;
 	req->hasPragmaHeader = false;
@@ -141,6 +143,12 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->cacheControl = NULL;
 	req->varyCookie = NULL;
 	req->envvars = NULL;
+	req->nextTurboCacheWaiter = NULL;
+	req->appConnection = NULL;
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		req->requestBodySplicing = NULL;
+		req->responseSplicing = NULL;
+	#endif
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timedAppPoolGet = false;
@@ -154,6 +162,15 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 
 void
 Controller::deinitializeRequest(Client *client, Request *req) {
+	if (req->turboCacheFillState == Request::TCF_FILLING) {
+		finishTurboCacheFill(client, req);
+	}
+	stopWaitingForAppConnection(req);
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		destroySplicing(req->requestBodySplicing);
+		destroySplicing(req->responseSplicing);
+	#endif
+
 	req->session.reset();
 	req->config.reset();
 
@@ -285,6 +302,18 @@ Controller::supportsUpgrade(Client *client, Request *req) {
 	return true;
 }
 
+bool
+Controller::isReadingRequestBodyDirectly(Client *client, Request *req) {
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		// While the pipe contains data, we're waiting for the app
+		// instead of the client.
+		return req->requestBodySplicing != NULL
+			&& req->requestBodySplicing->bytesInPipe == 0;
+	#else
+		return false;
+	#endif
+}
+
 
 /****************************
  *
@@ -110,28 +110,136 @@ Controller::respondFromTurboCache(Client *client, Request *req) {
 	SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
 	if (turboCaching.responseCache.requestAllowsFetching(req)) {
-		ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetch(req,
-			ev_now(getLoop())));
+		if (turboCaching.shouldBypass(req->cacheKey.hash())) {
+			SKC_TRACE(client, 2, "Turbocaching: bypassing cache for key \"" <<
+				cEscapeString(req->cacheKey) << "\" because of poor statistics");
+			turboCaching.recordBypass(req->cacheKey);
+			req->cacheKey = HashedStaticString();
+			return false;
+		}
+
+		ev_tstamp now = ev_now(getLoop());
+		ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetch(req, now));
 		if (entry.valid()) {
 			SKC_TRACE(client, 2, "Turbocaching: cache hit (key \"" <<
 				cEscapeString(req->cacheKey) << "\")");
-			turboCaching.writeResponse(this, client, req, entry);
-			if (!req->ended()) {
-				endRequest(&client, &req);
-			}
+			writeTurboCacheResponse(&client, &req, entry);
 			return true;
-		} else {
-			SKC_TRACE(client, 2, "Turbocaching: cache miss: " <<
-				entry.getCacheMissReasonString() <<
-				" (key \"" << cEscapeString(req->cacheKey) << "\")");
+		}
+
+		SKC_TRACE(client, 2, "Turbocaching: cache miss: " <<
+			entry.getCacheMissReasonString() <<
+			" (key \"" << cEscapeString(req->cacheKey) << "\")");
+		if (req->method != HTTP_GET || req->hasBody()) {
 			return false;
 		}
+
+		if (turboCaching.lookupFill(req->cacheKey) != NULL) {
+			// Another request is already fetching this response from the app.
+			entry = turboCaching.responseCache.fetchStale(req, now,
+				ResponseCache<Request>::STALE_WHILE_REVALIDATE);
+			if (entry.valid()) {
+				SKC_TRACE(client, 2, "Turbocaching: serving stale response"
+					" while another request revalidates it");
+				turboCaching.staleResponses++;
+				writeTurboCacheResponse(&client, &req, entry);
+				return true;
+			} else {
+				req->turboCacheFillState = Request::TCF_SHOULD_WAIT;
+			}
+		} else if (entry.cacheMissReason == ResponseCache<Request>::Entry::NOT_FRESH) {
+			// The response was cacheable before, so it probably will be
+			// again. Let concurrent requests for it wait for this one.
+			turboCaching.beginFill(req);
+		}
+		return false;
 	} else {
 		SKC_TRACE(client, 2, "Turbocaching: request not eligible for caching");
 		return false;
 	}
 }
 
+void
+Controller::writeTurboCacheResponse(Client **client, Request **req,
+	ResponseCache<Request>::Entry &entry)
+{
+	turboCaching.writeResponse(this, *client, *req, entry);
+	if (!(*req)->ended()) {
+		endRequest(client, req);
+	}
+}
+
+void
+Controller::waitForTurboCacheFill(Client *client, Request *req) {
+	Request *filler = turboCaching.lookupFill(req->cacheKey);
+	if (filler == NULL) {
+		req->turboCacheFillState = Request::TCF_NONE;
+		checkoutSession(client, req);
+	} else {
+		SKC_TRACE(client, 2, "Turbocaching: waiting for another request"
+			" to fetch the response");
+		refRequest(req, __FILE__, __LINE__);
+		turboCaching.waitForFill(filler, req);
+	}
+}
+
+/**
+ * Called when a filling request is done, whether or not it managed to
+ * store a response. Waiting requests are answered from the cache if
+ * possible. Otherwise they go to the application on their own.
+ */
+void
+Controller::finishTurboCacheFill(Client *client, Request *req) {
+	Request *waiter = turboCaching.endFill(req);
+	while (waiter != NULL) {
+		Request *next = waiter->nextTurboCacheWaiter;
+		Client *waiterClient = static_cast<Client *>(waiter->client);
+		Request *waiterReq = waiter;
+
+		waiter->nextTurboCacheWaiter = NULL;
+		waiter->turboCacheFillState = Request::TCF_NONE;
+		if (!waiter->ended()) {
+			ResponseCache<Request>::Entry entry;
+			if (turboCaching.isEnabled()) {
+				entry = turboCaching.responseCache.fetch(waiter, ev_now(getLoop()));
+			}
+			if (entry.valid()) {
+				SKC_TRACE(waiterClient, 2, "Turbocaching: cache hit after waiting");
+				writeTurboCacheResponse(&waiterClient, &waiterReq, entry);
+			} else {
+				checkoutSession(waiterClient, waiter);
+			}
+		}
+		unrefRequest(waiter, __FILE__, __LINE__);
+		waiter = next;
+	}
+}
+
+/**
+ * Serves a stale turbocache entry instead of an error response, if the
+ * entry's stale-if-error period allows that.
+ */
+bool
+Controller::respondWithStaleTurboCacheEntry(Client **client, Request **req) {
+	Request *r = *req;
+	if (r->responseBegun || !turboCaching.isEnabled() || r->cacheKey.empty()
+	 || !turboCaching.responseCache.requestAllowsFetching(r))
+	{
+		return false;
+	}
+
+	ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetchStale(r,
+		ev_now(getLoop()), ResponseCache<Request>::STALE_IF_ERROR));
+	if (entry.valid()) {
+		SKC_DEBUG(*client, "Turbocaching: serving stale response instead of an error");
+		turboCaching.staleResponses++;
+		writeTurboCacheResponse(client, req, entry);
+		return true;
+	} else {
+		return false;
+	}
+}
+
 void
 Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis) {
 	boost::shared_ptr<Options> *options;
@@ -196,6 +304,8 @@ Controller::fillPoolOptionsFromConfigCaches(Options &options,
 	options.defaultUser = requestConfig->defaultUser;
 	options.defaultGroup = requestConfig->defaultGroup;
 	options.minProcesses = requestConfig->minInstances;
+	options.spawnConcurrency = requestConfig->spawnConcurrency;
+	options.predictiveSpawning = requestConfig->predictiveSpawning;
 	options.maxPreloaderIdleTime = requestConfig->maxPreloaderIdleTime;
 	options.maxRequestQueueSize = requestConfig->maxRequestQueueSize;
 	options.abortWebsocketsOnProcessShutdown = requestConfig->abortWebsocketsOnProcessShutdown;
@@ -362,6 +472,8 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	fillPoolOption(req, options.group, "!~PASSENGER_GROUP");
 	fillPoolOption(req, options.minProcesses, "!~PASSENGER_MIN_PROCESSES");
 	fillPoolOption(req, options.maxProcesses, "!~PASSENGER_MAX_PROCESSES");
+	fillPoolOption(req, options.spawnConcurrency, "!~PASSENGER_SPAWN_CONCURRENCY");
+	fillPoolOption(req, options.predictiveSpawning, "!~PASSENGER_PREDICTIVE_SPAWNING");
 	fillPoolOption(req, options.spawnMethod, "!~PASSENGER_SPAWN_METHOD");
 	fillPoolOption(req, options.startCommand, "!~PASSENGER_START_COMMAND");
 	fillPoolOptionSecToMsec(req, options.startTimeout, "!~PASSENGER_START_TIMEOUT");
@@ -425,7 +537,7 @@ Controller::setStickySessionId(Client *client, Request *req) {
 		// TODO: This is not entirely correct. Clients MAY send multiple Cookie
 		// headers, although this is in practice extremely rare.
 		// http://stackoverflow.com/questions/16305814/are-multiple-cookie-headers-allowed-in-an-http-request
-		const LString *cookieHeader = req->headers.lookup(HTTP_COOKIE);
+		const LString *cookieHeader = req->headers.lookup(ServerKit::KNOWN_HEADER_COOKIE);
 		if (cookieHeader != NULL && cookieHeader->size > 0) {
 			const LString *cookieName = getStickySessionCookieName(req);
 			vector< pair<StaticString, StaticString> > cookies;
@@ -482,7 +594,7 @@ Controller::onRequestBegin(Client *client, Request *req) {
 			mainConfig.stickySessions);
 		req->showVersionInHeader = getBoolOption(req, PASSENGER_SHOW_VERSION_IN_HEADER,
 			req->config->showVersionInHeader);
-		req->host = req->headers.lookup(HTTP_HOST);
+		req->host = req->headers.lookup(ServerKit::KNOWN_HEADER_HOST);
 
 		/***************/
 		/***************/
@@ -506,7 +618,9 @@ Controller::onRequestBegin(Client *client, Request *req) {
 		setStickySessionId(client, req);
 	}
 
-	if (!req->hasBody() || !req->requestBodyBuffering) {
+	if (req->turboCacheFillState == Request::TCF_SHOULD_WAIT) {
+		waitForTurboCacheFill(client, req);
+	} else if (!req->hasBody() || !req->requestBodyBuffering) {
 		req->requestBodyBuffering = false;
 		checkoutSession(client, req);
 	} else {
@@ -52,6 +52,7 @@ Controller::Controller(ServerKit::Context *context, const ControllerSchema &sche
 	  mainConfig(config),
 	  requestConfig(new ControllerRequestConfig(config)),
 	  poolOptionsCache(4),
+	  routingAffinities(4),
 
 	  PASSENGER_APP_GROUP_NAME("!~PASSENGER_APP_GROUP_NAME"),
 	  PASSENGER_ENV_VARS("!~PASSENGER_ENV_VARS"),
@@ -65,15 +66,6 @@ Controller::Controller(ServerKit::Context *context, const ControllerSchema &sche
 	  REMOTE_PORT("!~REMOTE_PORT"),
 	  REMOTE_USER("!~REMOTE_USER"),
 	  FLAGS("!~FLAGS"),
-	  HTTP_COOKIE("cookie"),
-	  HTTP_DATE("date"),
-	  HTTP_HOST("host"),
-	  HTTP_CONTENT_LENGTH("content-length"),
-	  HTTP_CONTENT_TYPE("content-type"),
-	  HTTP_EXPECT("expect"),
-	  HTTP_CONNECTION("connection"),
-	  HTTP_STATUS("status"),
-	  HTTP_TRANSFER_ENCODING("transfer-encoding"),
 
 	  turboCaching(),
 	  resourceLocator(NULL)
@@ -84,17 +76,21 @@ Controller::Controller(ServerKit::Context *context, const ControllerSchema &sche
 	ev_check_start(getLoop(), &checkWatcher);
 	checkWatcher.data = this;
 
-	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		ev_prepare_init(&prepareWatcher, onEventLoopPrepare);
-		ev_prepare_start(getLoop(), &prepareWatcher);
-		prepareWatcher.data = this;
+	ev_prepare_init(&prepareWatcher, onEventLoopPrepare);
+	ev_prepare_start(getLoop(), &prepareWatcher);
+	prepareWatcher.data = this;
 
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		totalBytesSpliced = 0;
+	#endif
+	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		timeBeforeBlocking = 0;
 	#endif
 }
 
 Controller::~Controller() {
 	ev_check_stop(getLoop(), &checkWatcher);
+	ev_prepare_stop(getLoop(), &prepareWatcher);
 }
 
 void
@@ -111,7 +107,14 @@ Controller::initialize() {
 	}
 
 	ParentClass::initialize();
-	turboCaching.initialize(config["turbocaching"].asBool());
+	turboCaching.initialize(config["turbocaching"].asBool(),
+		&getContext()->mbuf_pool,
+		config["turbocache_max_entries"].asUInt(),
+		config["turbocache_max_memory"].asUInt(),
+		config["turbocache_max_body_size"].asUInt());
+	if (sharedResponseCache != NULL) {
+		turboCaching.responseCache.useSharedCache(sharedResponseCache.get());
+	}
 	getContext()->defaultFileBufferedChannelConfig.bufferDir =
 		config["data_buffer_dir"].asString();
 
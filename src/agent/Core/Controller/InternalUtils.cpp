@@ -45,6 +45,47 @@ using namespace boost;
  ****************************/
 
 
+#ifdef SERVER_KIT_HAVE_SPLICE
+
+/**
+ * Prepares for moving body data from `sourceFd` to `sinkFd` through a pipe
+ * with splice(). The watchers are initialized but not started. Returns NULL
+ * if no pipe could be obtained, in which case the caller should keep
+ * forwarding the body through user space.
+ */
+Request::Splicing *
+Controller::createSplicing(Client *client, Request *req, int sourceFd, int sinkFd,
+	void (*callback)(EV_P_ struct ev_io *io, int revents))
+{
+	Request::Splicing *splicing = (Request::Splicing *)
+		psg_palloc(req->pool, sizeof(Request::Splicing));
+	if (!splicePipePool.acquire(splicing->pipe)) {
+		int e = errno;
+		SKC_DEBUG(client, "Cannot create a pipe for splicing: " <<
+			strerror(e) << " (errno=" << e << ")");
+		return NULL;
+	}
+
+	splicing->bytesInPipe = 0;
+	ev_io_init(&splicing->sourceWatcher, callback, sourceFd, EV_READ);
+	ev_io_init(&splicing->sinkWatcher, callback, sinkFd, EV_WRITE);
+	splicing->sourceWatcher.data = req;
+	splicing->sinkWatcher.data = req;
+	return splicing;
+}
+
+void
+Controller::destroySplicing(Request::Splicing *&splicing) {
+	if (splicing != NULL) {
+		ev_io_stop(getLoop(), &splicing->sourceWatcher);
+		ev_io_stop(getLoop(), &splicing->sinkWatcher);
+		splicePipePool.release(splicing->pipe, splicing->bytesInPipe == 0);
+		splicing = NULL;
+	}
+}
+
+#endif /* SERVER_KIT_HAVE_SPLICE */
+
 void
 Controller::disconnectWithClientSocketWriteError(Client **client, int e) {
 	stringstream message;
@@ -124,6 +165,10 @@ Controller::endRequestWithSimpleResponse(Client **c, Request **r,
 	Request *req = *r;
 	ServerKit::HeaderTable headers;
 
+	if (code >= 500 && respondWithStaleTurboCacheEntry(c, r)) {
+		return;
+	}
+
 	headers.insert(req->pool, "cache-control", "no-cache, no-store, must-revalidate");
 	writeSimpleResponse(client, code, &headers, body);
 	endRequest(c, r);
@@ -133,7 +178,7 @@ void
 Controller::endRequestAsBadGateway(Client **client, Request **req) {
 	if ((*req)->responseBegun) {
 		disconnectWithError(client, "bad gateway");
-	} else {
+	} else if (!respondWithStaleTurboCacheEntry(client, req)) {
 		ServerKit::HeaderTable headers;
 		headers.insert((*req)->pool, "cache-control", "no-cache, no-store, must-revalidate");
 		writeSimpleResponse(*client, 502, &headers, "<h1>Bad Gateway</h1>");
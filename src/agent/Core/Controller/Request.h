@@ -33,6 +33,7 @@
 #include <ServerKit/HttpRequest.h>
 #include <ServerKit/FdSinkChannel.h>
 #include <ServerKit/FdSourceChannel.h>
+#include <ServerKit/SplicePipePool.h>
 #include <LoggingKit/LoggingKit.h>
 #include <Core/ApplicationPool/Pool.h>
 #include <Core/UnionStation/Context.h>
@@ -67,6 +68,43 @@ public:
 		HALF_CLOSE_PERFORMED
 	};
 
+	enum TurboCacheFillState {
+		TCF_NONE,
+		// Fetching a response from the app that replaces an expired
+		// turbocache entry. Other requests for the same key wait for it.
+		TCF_FILLING,
+		// Will wait for another request's fill instead of checking out
+		// a session.
+		TCF_SHOULD_WAIT,
+		TCF_WAITING
+	};
+
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		/**
+		 * State for forwarding a body from one socket to another with
+		 * splice(). Only allocated, from the request pool, when that fast
+		 * path is used.
+		 */
+		struct Splicing {
+			ServerKit::SplicePipePool::Pipe pipe;
+			boost::uint64_t bytesInPipe;
+			struct ev_io sourceWatcher;
+			struct ev_io sinkWatcher;
+		};
+	#endif
+
+	/**
+	 * State for connecting to the app without blocking the event loop.
+	 * Only allocated, from the request pool, when a session could not
+	 * be initiated right away.
+	 */
+	struct AppConnection {
+		struct ev_io watcher;
+		struct ev_timer retryTimer;
+		struct ev_timer timeoutTimer;
+		ev_tstamp retryDelay;
+	};
+
 	ev_tstamp startedAt;
 
 	State state: 3;
@@ -79,6 +117,7 @@ public:
 	// Range: 0..MAX_SESSION_CHECKOUT_TRY
 	boost::uint8_t sessionCheckoutTry: 4;
 	HalfClosePolicy halfClosePolicy: 2;
+	TurboCacheFillState turboCacheFillState: 2;
 	bool appResponseInitialized: 1;
 	bool strip100ContinueHeader: 1;
 	bool hasPragmaHeader: 1;
@@ -112,6 +151,22 @@ public:
 	//
 	// This value is guaranteed to be contiguous.
 	LString *envvars;
+	// For a filling request, the first request waiting for it. For a
+	// waiting request, the next request waiting for the same fill.
+	Request *nextTurboCacheWaiter;
+	// The cache key hash under which a filling request is registered.
+	// `cacheKey` itself is cleared if the response is not cacheable.
+	boost::uint32_t turboCacheFillHash;
+
+	// Non-NULL once connecting to the app had to wait.
+	AppConnection *appConnection;
+
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		// Non-NULL while the request body is being spliced to the app.
+		Splicing *requestBodySplicing;
+		// Non-NULL while the response body is being spliced to the client.
+		Splicing *responseSplicing;
+	#endif
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		bool timedAppPoolGet;
@@ -157,14 +157,20 @@ Controller::sendHeaderToAppWithSessionProtocol(Client *client, Request *req) {
 	SessionProtocolWorkingState state;
 
 	// Workaround for Ruby < 2.1 support.
-	std::string deltaMonotonic;
+	// Formatted into a stack buffer so that this doesn't allocate memory.
+	char deltaMonotonicBuf[sizeof("-18446744073709551615")];
+	StaticString deltaMonotonic;
 	unsigned long long now = SystemTime::getUsec();
 	MonotonicTimeUsec monotonicNow = SystemTime::getMonotonicUsec();
 	if (now > monotonicNow) {
-		deltaMonotonic = boost::to_string(now - monotonicNow);
+		deltaMonotonic = StaticString(deltaMonotonicBuf,
+			integerToOtherBase<unsigned long long, 10>(now - monotonicNow,
+				deltaMonotonicBuf, sizeof(deltaMonotonicBuf)));
 	} else {
-		long long diff = monotonicNow - now;
-		deltaMonotonic = boost::to_string(-diff);
+		deltaMonotonicBuf[0] = '-';
+		deltaMonotonic = StaticString(deltaMonotonicBuf,
+			1 + integerToOtherBase<unsigned long long, 10>(monotonicNow - now,
+				deltaMonotonicBuf + 1, sizeof(deltaMonotonicBuf) - 1));
 	}
 
 	unsigned int bufferSize = determineHeaderSizeForSessionProtocol(req,
@@ -318,7 +324,7 @@ httpHeaderToScgiUpperCase(unsigned char *data, unsigned int size) {
 
 unsigned int
 Controller::determineHeaderSizeForSessionProtocol(Request *req,
-	SessionProtocolWorkingState &state, string delta_monotonic)
+	SessionProtocolWorkingState &state, const StaticString &delta_monotonic)
 {
 	unsigned int dataSize = sizeof(boost::uint32_t);
 
@@ -336,9 +342,9 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 	state.remoteAddr  = req->secureHeaders.lookup(REMOTE_ADDR);
 	state.remotePort  = req->secureHeaders.lookup(REMOTE_PORT);
 	state.remoteUser  = req->secureHeaders.lookup(REMOTE_USER);
-	state.contentType   = req->headers.lookup(HTTP_CONTENT_TYPE);
+	state.contentType   = req->headers.lookup(ServerKit::KNOWN_HEADER_CONTENT_TYPE);
 	if (req->hasBody()) {
-		state.contentLength = req->headers.lookup(HTTP_CONTENT_LENGTH);
+		state.contentLength = req->headers.lookup(ServerKit::KNOWN_HEADER_CONTENT_LENGTH);
 	} else {
 		state.contentLength = NULL;
 	}
@@ -475,7 +481,7 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 
 bool
 Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buffer,
-	unsigned int &size, const SessionProtocolWorkingState &state, string delta_monotonic)
+	unsigned int &size, const SessionProtocolWorkingState &state, const StaticString &delta_monotonic)
 {
 	char *pos = buffer;
 	const char *end = buffer + size;
@@ -583,16 +589,10 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 	while (*it != NULL) {
 		// This header-skipping is not accounted for in determineHeaderSizeForSessionProtocol(), but
 		// since we are only reducing the size it just wastes some mem bytes.
-		if ((
-				(it->header->hash == HTTP_CONTENT_LENGTH.hash()
-						|| it->header->hash == HTTP_CONTENT_TYPE.hash()
-						|| it->header->hash == HTTP_CONNECTION.hash()
-				) && (psg_lstr_cmp(&it->header->key, P_STATIC_STRING("content-type"))
-						|| psg_lstr_cmp(&it->header->key, P_STATIC_STRING("content-length"))
-						|| psg_lstr_cmp(&it->header->key, P_STATIC_STRING("connection"))
-				)
-			) || containsNonAlphaNumDash(it->header->key)
-		   )
+		if (it->header->knownId == ServerKit::KNOWN_HEADER_CONTENT_LENGTH
+		 || it->header->knownId == ServerKit::KNOWN_HEADER_CONTENT_TYPE
+		 || it->header->knownId == ServerKit::KNOWN_HEADER_CONNECTION
+		 || containsNonAlphaNumDash(it->header->key))
 		{
 			it.next();
 			continue;
@@ -720,7 +720,7 @@ Controller::constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *bu
 	if (!cache.cached) {
 		cache.methodStr  = http_method_str(req->method);
 		cache.remoteAddr = req->secureHeaders.lookup(REMOTE_ADDR);
-		cache.setCookie  = req->headers.lookup(ServerKit::HTTP_SET_COOKIE);
+		cache.setCookie  = req->headers.lookup(ServerKit::KNOWN_HEADER_SET_COOKIE);
 		cache.cached     = true;
 	}
 
@@ -772,10 +772,8 @@ Controller::constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *bu
 	}
 
 	while (*it != NULL) {
-		if ((it->header->hash == HTTP_CONNECTION.hash()
-		  || it->header->hash == ServerKit::HTTP_SET_COOKIE.hash())
-		 && (psg_lstr_cmp(&it->header->key, P_STATIC_STRING("connection"))
-		  || psg_lstr_cmp(&it->header->key, ServerKit::HTTP_SET_COOKIE)))
+		if (it->header->knownId == ServerKit::KNOWN_HEADER_CONNECTION
+		 || it->header->knownId == ServerKit::KNOWN_HEADER_SET_COOKIE)
 		{
 			it.next();
 			continue;
@@ -1026,6 +1024,11 @@ Controller::whenSendingRequest_onRequestBody(Client *client, Request *req,
 				stopBodyChannel(client, req);
 			}
 		}
+		#ifdef SERVER_KIT_HAVE_SPLICE
+			else if (canSpliceRequestBody(client, req)) {
+				beginSplicingRequestBody(client, req);
+			}
+		#endif
 		return Channel::Result(buffer.size(), false);
 	} else if (errcode == 0 || errcode == ECONNRESET) {
 		// EOF
@@ -1076,6 +1079,150 @@ Controller::resumeRequestBodyChannelWhenAppSinkIdle(Channel *_channel,
 	}
 }
 
+#ifdef SERVER_KIT_HAVE_SPLICE
+
+/**
+ * Whether the rest of the request body can be moved from the client socket
+ * to the app socket with splice(). Buffered request bodies don't qualify
+ * because they have to pass through the FileBufferedChannel anyway.
+ */
+bool
+Controller::canSpliceRequestBody(Client *client, Request *req) const {
+	return req->bodyType == Request::RBT_CONTENT_LENGTH
+		&& !req->requestBodyBuffering
+		&& req->aux.bodyInfo.contentLength - req->bodyAlreadyRead >= MIN_SPLICE_SIZE
+		&& req->appSink.acceptingInput()
+		// With io_uring, a read may be in flight on the client socket.
+		&& !getContext()->usingIoUring();
+}
+
+void
+Controller::beginSplicingRequestBody(Client *client, Request *req) {
+	Request::Splicing *splicing = createSplicing(client, req,
+		client->getFd(), req->session->fd(), onRequestBodySplicingEvent);
+	if (splicing == NULL) {
+		return;
+	}
+
+	SKC_TRACE(client, 2, "Splicing the rest of the client request body"
+		" to the application");
+	// This makes HttpServer stop reading from the client socket. We resume
+	// the body channel once the body has been fully spliced, after which
+	// it is fed EOF just like in the non-spliced case.
+	stopBodyChannel(client, req);
+	req->requestBodySplicing = splicing;
+	ev_io_start(getLoop(), &splicing->sourceWatcher);
+}
+
+void
+Controller::onRequestBodySplicingEvent(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+
+	ev_io_stop(EV_A_ io);
+	self->refRequest(req, __FILE__, __LINE__);
+	self->spliceRequestBody(client, req);
+	self->unrefRequest(req, __FILE__, __LINE__);
+}
+
+void
+Controller::spliceRequestBody(Client *client, Request *req) {
+	TRACE_POINT();
+	Request::Splicing *splicing = req->requestBodySplicing;
+	ssize_t ret;
+	int e;
+
+	for (unsigned int i = 0; i < SPLICE_BURST_COUNT; i++) {
+		if (splicing->bytesInPipe > 0) {
+			do {
+				ret = splice(splicing->pipe.readEnd, NULL, req->session->fd(), NULL,
+					splicing->bytesInPipe, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+			if (ret == -1) {
+				e = errno;
+				if (e == EAGAIN || e == EWOULDBLOCK) {
+					ev_io_start(getLoop(), &splicing->sinkWatcher);
+				} else {
+					// Like in the non-spliced case, we let ForwardResponse.cpp
+					// forward whatever the application has responded with.
+					UPDATE_TRACE_POINT();
+					logAppSocketWriteError(client, e);
+					destroySplicing(req->requestBodySplicing);
+					req->state = Request::WAITING_FOR_APP_OUTPUT;
+				}
+				return;
+			}
+			splicing->bytesInPipe -= ret;
+			totalBytesSpliced += ret;
+			// The app was the one being waited for, so the client gets a
+			// full client_body_timeout once the pipe has been drained.
+			rearmRequestBodyTimeout(client);
+
+		} else if (req->bodyFullyRead()) {
+			UPDATE_TRACE_POINT();
+			SKC_TRACE(client, 2, "End of spliced request body reached");
+			destroySplicing(req->requestBodySplicing);
+			startBodyChannel(client, req);
+			return;
+
+		} else {
+			boost::uint64_t remaining = req->aux.bodyInfo.contentLength
+				- req->bodyAlreadyRead;
+			do {
+				ret = splice(client->getFd(), NULL, splicing->pipe.writeEnd, NULL,
+					std::min<boost::uint64_t>(remaining, ServerKit::SplicePipePool::PIPE_SIZE),
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+			if (ret == -1) {
+				e = errno;
+				if (e == EAGAIN || e == EWOULDBLOCK) {
+					ev_io_start(getLoop(), &splicing->sourceWatcher);
+				} else {
+					UPDATE_TRACE_POINT();
+					disconnectWithRequestBodySpliceError(&client, req, e);
+				}
+				return;
+			} else if (ret == 0) {
+				UPDATE_TRACE_POINT();
+				SKC_DEBUG(client, "Client sent EOF before finishing request body: " <<
+					req->bodyAlreadyRead << " bytes already read, " <<
+					req->aux.bodyInfo.contentLength << " bytes expected");
+				disconnectWithRequestBodySpliceError(&client, req,
+					ServerKit::UNEXPECTED_EOF);
+				return;
+			}
+			req->bodyAlreadyRead += ret;
+			req->lastDataReceiveTime = ev_now(getLoop());
+			rearmRequestBodyTimeout(client);
+			totalBytesConsumed += ret;
+			splicing->bytesInPipe += ret;
+		}
+	}
+
+	// Give other clients a chance before continuing.
+	if (splicing->bytesInPipe > 0) {
+		ev_io_start(getLoop(), &splicing->sinkWatcher);
+	} else {
+		ev_io_start(getLoop(), &splicing->sourceWatcher);
+	}
+}
+
+void
+Controller::disconnectWithRequestBodySpliceError(Client **client, Request *req,
+	int errcode)
+{
+	const unsigned int BUFSIZE = 1024;
+	char *message = (char *) psg_pnalloc(req->pool, BUFSIZE);
+	int size = snprintf(message, BUFSIZE,
+		"error reading request body: %s (errno=%d)",
+		ServerKit::getErrorDesc(errcode), errcode);
+	destroySplicing(req->requestBodySplicing);
+	disconnectWithError(client, StaticString(message, size));
+}
+
+#endif /* SERVER_KIT_HAVE_SPLICE */
+
 void
 Controller::startBodyChannel(Client *client, Request *req) {
 	if (req->requestBodyBuffering) {
@@ -51,6 +51,13 @@ Controller::getThreadNumber() const {
 	return mainConfig.threadNumber;
 }
 
+#ifdef SERVER_KIT_HAVE_SPLICE
+boost::uint64_t
+Controller::getTotalBytesSpliced() const {
+	return totalBytesSpliced;
+}
+#endif
+
 Json::Value
 Controller::inspectStateAsJson() const {
 	Json::Value doc = ParentClass::inspectStateAsJson();
@@ -62,8 +69,39 @@ Controller::inspectStateAsJson() const {
 		subdoc["stores"] = turboCaching.responseCache.getStores();
 		subdoc["store_successes"] = turboCaching.responseCache.getStoreSuccesses();
 		subdoc["store_success_ratio"] = turboCaching.responseCache.getStoreSuccessRatio();
+		subdoc["rejections"] = turboCaching.responseCache.getRejections();
+		subdoc["evictions"] = turboCaching.responseCache.getEvictions();
+		subdoc["coalesced_requests"] = turboCaching.coalescedRequests;
+		subdoc["stale_responses"] = turboCaching.staleResponses;
+		subdoc["bypassed_requests"] = turboCaching.bypassedRequests;
+		subdoc["bypassed_keys"] = turboCaching.inspectBypassedKeysAsJson();
+		subdoc["entries"] = turboCaching.responseCache.getEntryCount();
+		subdoc["memory_usage"] = (Json::UInt64) turboCaching.responseCache.getMemoryUsage();
+		if (sharedResponseCache != NULL) {
+			Json::Value shared;
+			shared["entries"] = sharedResponseCache->getEntryCount();
+			shared["memory_usage"] = (Json::UInt64) sharedResponseCache->getMemoryUsage();
+			shared["evictions"] = sharedResponseCache->getEvictions();
+			shared["retired"] = sharedResponseCache->getRetiredCount();
+			subdoc["shared"] = shared;
+		}
 		doc["turbocaching"] = subdoc;
 	}
+
+	StringKeyTable<RoutingAffinity>::ConstIterator it(routingAffinities);
+	unsigned long long routingAffinityHits = 0;
+	while (*it != NULL) {
+		routingAffinityHits += it.getValue().hits;
+		it.next();
+	}
+	doc["routing_affinity_hits"] = (Json::UInt64) routingAffinityHits;
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		doc["total_bytes_spliced"] = byteSizeToJson(totalBytesSpliced);
+	#endif
+	if (getContext()->defaultFileBufferedChannelConfig.memoryBudget != NULL) {
+		doc["file_buffer_memory_budget"] = getContext()->
+			defaultFileBufferedChannelConfig.memoryBudget->inspectStateAsJson();
+	}
 	return doc;
 }
 
@@ -93,6 +131,13 @@ Controller::inspectRequestStateAsJson(const Request *req) const {
 	flags["dechunk_response"] = req->dechunkResponse;
 	flags["request_body_buffering"] = req->requestBodyBuffering;
 	flags["https"] = req->https;
+	flags["waiting_for_app_connection"] = req->appConnection != NULL
+		&& (ev_is_active(&req->appConnection->watcher)
+			|| ev_is_active(&req->appConnection->retryTimer));
+	#ifdef SERVER_KIT_HAVE_SPLICE
+		flags["splicing_request_body"] = req->requestBodySplicing != NULL;
+		flags["splicing_response"] = req->responseSplicing != NULL;
+	#endif
 	doc["flags"] = flags;
 
 	if (req->requestBodyBuffering) {
@@ -31,11 +31,13 @@
 #include <ctime>
 #include <cstddef>
 #include <cassert>
+#include <map>
 #include <MemoryKit/mbuf.h>
 #include <ServerKit/Context.h>
 #include <Constants.h>
 #include <LoggingKit/LoggingKit.h>
 #include <Utils/StrIntUtils.h>
+#include <jsoncpp/json.h>
 #include <Core/ResponseCache.h>
 
 namespace Passenger {
@@ -50,13 +52,16 @@ class TurboCaching {
 public:
 	/** The interval of the timer while we're in the ENABLED state. */
 	static const unsigned int ENABLED_TIMEOUT = 2;
-	/** The interval of the timer while we're in the TEMPORARILY_DISABLED state. */
-	static const unsigned int TEMPORARY_DISABLE_TIMEOUT = 10;
-	/** Only consider temporarily disabling turbocaching if the number of
-	 * fetches/stores in the current interval have reached these thresholds.
+	/** Only consider bypassing the cache for a key if the number of
+	 * fetches/stores for that key have reached these thresholds. The
+	 * per-key statistics are halved every ENABLED_TIMEOUT seconds.
 	 */
 	static const unsigned int FETCH_THRESHOLD = 20;
 	static const unsigned int STORE_THRESHOLD = 20;
+	/** The maximum number of bypassed keys that are remembered for
+	 * reporting in inspectBypassedKeysAsJson().
+	 */
+	static const unsigned int MAX_REPORTED_BYPASSED_KEYS = 32;
 
 	OXT_FORCE_INLINE static double MIN_HIT_RATIO() { return 0.5; }
 	OXT_FORCE_INLINE static double MIN_STORE_SUCCESS_RATIO() { return 0.5; }
@@ -67,16 +72,10 @@ public:
 		 */
 		DISABLED,
 		/**
-		 * Turbocaching is enabled.
-		 */
-		ENABLED,
-		/**
-		 * In case turbocaching is enabled, and poor cache hit ratio
-		 * is detected, this state will be entered. It will stay
-		 * in this state for TEMPORARY_DISABLE_TIMEOUT seconds before
-		 * transitioning back to ENABLED.
+		 * Turbocaching is enabled. Keys with a poor hit ratio or
+		 * store success ratio are bypassed; see shouldBypass().
 		 */
-		TEMPORARILY_DISABLED
+		ENABLED
 	};
 
 	typedef ResponseCache<Request> ResponseCacheType;
@@ -86,6 +85,31 @@ private:
 	State state;
 	ev_tstamp lastTimeout, nextTimeout;
 
+	/**
+	 * Requests that are fetching a response from the application in order
+	 * to replace an expired entry, by cache key hash. Other requests for
+	 * the same key are coalesced onto them instead of all going to the
+	 * application at once. A hash collision merely makes a request wait
+	 * unnecessarily.
+	 */
+	std::map<boost::uint32_t, Request *> fills;
+
+	struct BypassedKey {
+		string key;
+		bool active;
+	};
+	typedef std::map<boost::uint32_t, BypassedKey> BypassedKeyMap;
+
+	/**
+	 * Keys that were recently bypassed, by hash, for reporting purposes.
+	 * Keys that are no longer bypassed are deactivated on every timeout,
+	 * but their entries are kept: a poorly cacheable key typically cycles
+	 * in and out of being bypassed as its statistics decay, and reusing
+	 * the entry keeps that cycle from allocating memory. Inactive entries
+	 * are only replaced when the table is full.
+	 */
+	BypassedKeyMap bypassedKeys;
+
 	struct ResponsePreparation {
 		Request *req;
 		const ResponseCacheEntryType *entry;
@@ -95,6 +119,7 @@ private:
 		unsigned int ageValueSize;
 		unsigned int contentLengthStrSize;
 		bool showVersionInHeader;
+		bool stale;
 	};
 
 	template<typename Server>
@@ -114,6 +139,7 @@ private:
 		prep.ageValueSize = integerSizeInOtherBase<time_t, 10>(prep.age);
 		prep.contentLengthStrSize = uintSizeAsString(entry.body->httpBodySize);
 		prep.showVersionInHeader = req->config->showVersionInHeader;
+		prep.stale = prep.now >= entry.body->expiryDate;
 	}
 
 	template<typename Server>
@@ -138,7 +164,7 @@ private:
 
 		result += entry->body->httpHeaderSize;
 		if (output != NULL) {
-			pos = appendData(pos, end, entry->body->httpHeaderData,
+			pos = appendData(pos, end, entry->body->getHttpHeaderData(),
 				entry->body->httpHeaderSize);
 		}
 
@@ -158,6 +184,10 @@ private:
 		}
 		PUSH_STATIC_STRING("\r\n");
 
+		if (prep.stale) {
+			PUSH_STATIC_STRING("Warning: 110 - \"Response is Stale\"\r\n");
+		}
+
 		if (prep.showVersionInHeader) {
 			PUSH_STATIC_STRING("X-Powered-By: " PROGRAM_NAME " " PASSENGER_VERSION "\r\n");
 		} else {
@@ -191,14 +221,32 @@ private:
 
 public:
 	ResponseCache<Request> responseCache;
+	/** The number of requests that waited for another request's fill. */
+	unsigned int coalescedRequests;
+	/** The number of stale responses served because of stale-while-revalidate
+	 * or stale-if-error.
+	 */
+	unsigned int staleResponses;
+	/** The number of requests that bypassed the cache because of poor
+	 * statistics for their key.
+	 */
+	unsigned int bypassedRequests;
 
 	TurboCaching()
 		: state(ENABLED),
 		  lastTimeout(0),
-		  nextTimeout(0)
+		  nextTimeout(0),
+		  coalescedRequests(0),
+		  staleResponses(0),
+		  bypassedRequests(0)
 		{ }
 
-	void initialize(bool initiallyEnabled) {
+	void initialize(bool initiallyEnabled, MemoryKit::mbuf_pool *mbufPool,
+		unsigned int maxEntries = DEFAULT_TURBOCACHE_MAX_ENTRIES,
+		size_t maxMemory = DEFAULT_TURBOCACHE_MAX_MEMORY,
+		unsigned int maxBodySize = DEFAULT_TURBOCACHE_MAX_BODY_SIZE)
+	{
+		responseCache.initialize(mbufPool, maxEntries, maxMemory, maxBodySize);
 		state = initiallyEnabled ? ENABLED : DISABLED;
 		lastTimeout = (ev_tstamp) time(NULL);
 		nextTimeout = (ev_tstamp) time(NULL) + ENABLED_TIMEOUT;
@@ -210,6 +258,8 @@ public:
 
 	// Call when the event loop multiplexer returns.
 	void updateState(ev_tstamp now) {
+		responseCache.sharedCacheReaderOnline();
+
 		if (OXT_UNLIKELY(state == DISABLED)) {
 			return;
 		}
@@ -218,50 +268,141 @@ public:
 			return;
 		}
 
-		switch (state) {
-		case ENABLED:
-			if (responseCache.getFetches() >= FETCH_THRESHOLD
-				&& responseCache.getHitRatio() < MIN_HIT_RATIO())
-			{
-				P_INFO("Poor turbocaching hit ratio detected (" <<
-					responseCache.getHits() << " hits, " <<
-					responseCache.getFetches() << " fetches, " <<
-					(int) (responseCache.getHitRatio() * 100) <<
-					"%). Temporarily disabling turbocaching "
-					"for " << TEMPORARY_DISABLE_TIMEOUT << " seconds");
-				state = TEMPORARILY_DISABLED;
-				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
-			} else if (responseCache.getStores() >= STORE_THRESHOLD
-				&& responseCache.getStoreSuccessRatio() < MIN_STORE_SUCCESS_RATIO())
-			{
-				P_INFO("Poor turbocaching store success ratio detected (" <<
-					responseCache.getStoreSuccesses() << " store successes, " <<
-					responseCache.getStores() << " stores, " <<
-					(int) (responseCache.getStoreSuccessRatio() * 100) <<
-					"%). Temporarily disabling turbocaching "
-					"for " << TEMPORARY_DISABLE_TIMEOUT << " seconds");
-				state = TEMPORARILY_DISABLED;
-				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
-			} else {
-				P_DEBUG("Clearing turbocache");
-				nextTimeout = now + ENABLED_TIMEOUT;
+		// Entries are not cleared here: they are removed by expiry, by
+		// LRU/TinyLFU eviction and by the memory limit.
+		nextTimeout = now + ENABLED_TIMEOUT;
+		responseCache.resetStatistics();
+		responseCache.decayKeyStatistics();
+		if (responseCache.getSharedCache() != NULL) {
+			responseCache.getSharedCache()->reclaim();
+		}
+
+		typename BypassedKeyMap::iterator it, end = bypassedKeys.end();
+		for (it = bypassedKeys.begin(); it != end; it++) {
+			if (it->second.active && !shouldBypass(it->first)) {
+				P_DEBUG("Turbocaching no longer bypassed for key \"" <<
+					cEscapeString(it->second.key) << "\"");
+				it->second.active = false;
 			}
-			responseCache.resetStatistics();
-			responseCache.clear();
-			break;
-		case TEMPORARILY_DISABLED:
-			P_INFO("Re-enabling turbocaching");
-			state = ENABLED;
-			nextTimeout = now + ENABLED_TIMEOUT;
-			break;
-		default:
-			P_BUG("Unknown state " << (int) state);
-			break;
 		}
 
 		lastTimeout = now;
 	}
 
+	/**
+	 * Whether the cache should not be consulted for the given key, because
+	 * responses for it were rarely served from the cache, or rarely stored,
+	 * recently. Bypassed keys are not counted in the statistics, so once
+	 * their counts have decayed they are given another chance.
+	 */
+	bool shouldBypass(boost::uint32_t hash) const {
+		ResponseCacheKeyStatistics::Counts counts =
+			responseCache.getKeyStatistics().estimate(hash);
+		return (counts.fetches >= FETCH_THRESHOLD
+				&& counts.hits < counts.fetches * MIN_HIT_RATIO())
+			|| (counts.stores >= STORE_THRESHOLD
+				&& counts.storeSuccesses < counts.stores * MIN_STORE_SUCCESS_RATIO());
+	}
+
+	void recordBypass(const HashedStaticString &cacheKey) {
+		typename BypassedKeyMap::iterator it;
+
+		bypassedRequests++;
+		it = bypassedKeys.find(cacheKey.hash());
+		if (it != bypassedKeys.end()) {
+			if (!it->second.active) {
+				P_DEBUG("Poor turbocaching statistics detected again for key \"" <<
+					cEscapeString(cacheKey) << "\". Bypassing turbocache for it");
+				it->second.active = true;
+			}
+			return;
+		}
+
+		if (bypassedKeys.size() >= MAX_REPORTED_BYPASSED_KEYS) {
+			typename BypassedKeyMap::iterator end = bypassedKeys.end();
+			for (it = bypassedKeys.begin(); it != end && it->second.active; it++) {
+				// Do nothing.
+			}
+			if (it == end) {
+				return;
+			}
+			bypassedKeys.erase(it);
+		}
+
+		P_DEBUG("Poor turbocaching statistics detected for key \"" <<
+			cEscapeString(cacheKey) << "\". Bypassing turbocache for it");
+		BypassedKey &entry = bypassedKeys[cacheKey.hash()];
+		entry.key.assign(cacheKey.data(), cacheKey.size());
+		entry.active = true;
+	}
+
+	Json::Value inspectBypassedKeysAsJson() const {
+		Json::Value doc(Json::arrayValue);
+		typename BypassedKeyMap::const_iterator it, end = bypassedKeys.end();
+		for (it = bypassedKeys.begin(); it != end; it++) {
+			if (!it->second.active) {
+				continue;
+			}
+
+			ResponseCacheKeyStatistics::Counts counts =
+				responseCache.getKeyStatistics().estimate(it->first);
+			Json::Value subdoc;
+			subdoc["key"] = it->second.key;
+			subdoc["fetches"] = counts.fetches;
+			subdoc["hits"] = counts.hits;
+			subdoc["stores"] = counts.stores;
+			subdoc["store_successes"] = counts.storeSuccesses;
+			doc.append(subdoc);
+		}
+		return doc;
+	}
+
+	Request *lookupFill(const HashedStaticString &cacheKey) const {
+		typename std::map<boost::uint32_t, Request *>::const_iterator it =
+			fills.find(cacheKey.hash());
+		if (it == fills.end()) {
+			return NULL;
+		} else {
+			return it->second;
+		}
+	}
+
+	// @pre lookupFill(req->cacheKey) == NULL
+	void beginFill(Request *req) {
+		fills[req->cacheKey.hash()] = req;
+		req->turboCacheFillState = Request::TCF_FILLING;
+		req->turboCacheFillHash = req->cacheKey.hash();
+	}
+
+	void waitForFill(Request *filler, Request *waiter) {
+		waiter->nextTurboCacheWaiter = filler->nextTurboCacheWaiter;
+		waiter->turboCacheFillState = Request::TCF_WAITING;
+		filler->nextTurboCacheWaiter = waiter;
+		coalescedRequests++;
+	}
+
+	/**
+	 * Unregisters a fill. Returns the first request that was waiting for
+	 * it; the others are linked through `nextTurboCacheWaiter`.
+	 */
+	Request *endFill(Request *filler) {
+		assert(filler->turboCacheFillState == Request::TCF_FILLING);
+		typename std::map<boost::uint32_t, Request *>::iterator it =
+			fills.find(filler->turboCacheFillHash);
+		if (it != fills.end() && it->second == filler) {
+			fills.erase(it);
+		}
+		Request *waiters = filler->nextTurboCacheWaiter;
+		filler->nextTurboCacheWaiter = NULL;
+		filler->turboCacheFillState = Request::TCF_NONE;
+		return waiters;
+	}
+
+	// Call before the event loop multiplexer blocks.
+	void beforeBlocking() {
+		responseCache.sharedCacheReaderOffline();
+	}
+
 	template<typename Server, typename Client>
 	void writeResponse(Server *server, Client *client, Request *req, ResponseCacheEntryType &entry) {
 		MemoryKit::mbuf_pool &mbuf_pool = server->getContext()->mbuf_pool;
@@ -278,14 +419,29 @@ public:
 			buffer = MemoryKit::mbuf(buffer, 0, headerSize + entry.body->httpBodySize);
 
 			buildResponseHeader(prep, server, buffer.start, buffer.size());
-			memcpy(buffer.start + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			memcpy(buffer.start + headerSize, entry.body->getHttpBodyData(),
+				entry.body->httpBodySize);
 
 			server->writeResponse(client, buffer);
+		} else if (entry.body->data.mbuf_block != NULL) {
+			// Write the body directly from the cache entry's mbuf. The
+			// output channel holds a reference to it, so the data stays
+			// alive even if the entry is evicted in the mean time.
+			char *buffer = (char *) psg_pnalloc(req->pool, headerSize);
+			buildResponseHeader(prep, server, buffer, headerSize);
+			server->writeResponse(client, buffer, headerSize);
+			if (!req->ended()) {
+				server->writeResponse(client, MemoryKit::mbuf(entry.body->data,
+					entry.body->httpHeaderSize, entry.body->httpBodySize));
+			}
 		} else {
+			// The entry lives in the shared cache and may be freed after
+			// this event loop iteration, so copy it.
 			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + entry.body->httpBodySize);
 			buildResponseHeader(prep, server, buffer,
 				headerSize + entry.body->httpBodySize);
-			memcpy(buffer + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			memcpy(buffer + headerSize, entry.body->getHttpBodyData(),
+				entry.body->httpBodySize);
 
 			server->writeResponse(client, buffer, headerSize + entry.body->httpBodySize);
 		}
@@ -31,6 +31,7 @@
 	#define SUPPORTS_PER_THREAD_CPU_AFFINITY
 	#include <sched.h>
 	#include <pthread.h>
+	#include <dirent.h>
 #endif
 #ifdef USE_SELINUX
 	#include <selinux/selinux.h>
@@ -132,6 +133,11 @@ namespace Core {
 
 	struct WorkingObjects {
 		int serverFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+		/**
+		 * For TCP addresses in reuse port mode: the SO_REUSEPORT sockets
+		 * for core threads 2..N. Thread 1 uses the socket in `serverFds`.
+		 */
+		vector<int> reusePortServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		int apiServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		string password;
 		ApiAccountDatabase apiAccountDatabase;
@@ -142,6 +148,8 @@ namespace Core {
 		SpawningKit::ConfigPtr spawningKitConfig;
 		SpawningKit::FactoryPtr spawningKitFactory;
 		PoolPtr appPool;
+		SharedResponseCachePtr sharedResponseCache;
+		ServerKit::FileBufferedChannelMemoryBudget fileBufferMemoryBudget;
 
 		ServerKit::AcceptLoadBalancer<Controller> loadBalancer;
 		ControllerSchema controllerSchema;
@@ -384,6 +392,62 @@ makeFileWorldReadableAndWritable(const string &path) {
 	}
 #endif
 
+/**
+ * Whether the core threads should each listen on their own SO_REUSEPORT socket
+ * for the given address, instead of sharing a single socket through the
+ * AcceptLoadBalancer. This saves a cross-thread handoff and event loop wakeup
+ * per connection, which matters most for short-lived connections. The kernel
+ * hashes connections over the sockets, so unlike the AcceptLoadBalancer it
+ * does not compensate for a thread that is temporarily busy.
+ */
+static bool
+usingReusePort(const string &address) {
+	#ifdef __linux__
+		// Other platforms support SO_REUSEPORT, but do not balance
+		// connections over the sockets.
+		return agentsOptions->getBool("core_reuse_port")
+			&& agentsOptions->getInt("core_threads") > 1
+			&& getSocketAddressType(address) == SAT_TCP;
+	#else
+		return false;
+	#endif
+}
+
+static void
+createReusePortServers(unsigned int index, const string &address) {
+	TRACE_POINT();
+	WorkingObjects *wo = workingObjects;
+	unsigned int nthreads = agentsOptions->getInt("core_threads");
+
+	wo->reusePortServerFds[index].reserve(nthreads - 1);
+	for (unsigned int i = 1; i < nthreads; i++) {
+		int fd = createServer(address, agentsOptions->getInt("socket_backlog"),
+			true, __FILE__, __LINE__, true);
+		wo->reusePortServerFds[index].push_back(fd);
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(fd, "Server address: " << address
+			<< " (thread " << (i + 1) << ")");
+	}
+
+	if (agentsOptions->getBool("core_cpu_affine")) {
+		// mainLoop() pins core thread i to CPU (i % ncpus), while the steering
+		// program hands connections received on CPU c to thread (c % nthreads).
+		// Those only agree if there is exactly one core thread per CPU.
+		unsigned int ncpus = boost::thread::hardware_concurrency();
+		if (nthreads != ncpus) {
+			P_NOTICE("Not steering connections on " << address
+				<< " to core threads by CPU, because the number of core threads ("
+				<< nthreads << ") differs from the number of CPUs (" << ncpus << ")");
+			return;
+		}
+		try {
+			attachReusePortCpuSteering(wo->serverFds[index], nthreads);
+		} catch (const SystemException &e) {
+			P_WARN("Cannot steer connections on " << address
+				<< " to core threads by CPU: " << e.what());
+		}
+	}
+}
+
 static void
 startListening() {
 	TRACE_POINT();
@@ -398,8 +462,12 @@ startListening() {
 	#endif
 
 	for (unsigned int i = 0; i < addresses.size(); i++) {
+		bool reusePort = usingReusePort(addresses[i]);
 		wo->serverFds[i] = createServer(addresses[i], agentsOptions->getInt("socket_backlog"), true,
-			__FILE__, __LINE__);
+			__FILE__, __LINE__, reusePort);
+		if (reusePort) {
+			createReusePortServers(i, addresses[i]);
+		}
 		#ifdef USE_SELINUX
 			resetSelinuxSocketContext();
 			if (i == 0 && getSocketAddressType(addresses[0]) == SAT_UNIX) {
@@ -594,6 +662,55 @@ onTerminationSignal(EV_P_ struct ev_signal *watcher, int revents) {
 	}
 }
 
+#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
+/**
+ * Returns the NUMA node that the given CPU belongs to, or -1 if unknown
+ * (e.g. on non-NUMA kernels).
+ */
+static int
+getNumaNodeOfCpu(unsigned int cpu) {
+	string path = "/sys/devices/system/cpu/cpu" + toString(cpu);
+	DIR *dir = opendir(path.c_str());
+	if (dir == NULL) {
+		return -1;
+	}
+
+	struct dirent *ent;
+	int result = -1;
+	while ((ent = readdir(dir)) != NULL) {
+		if (startsWith(ent->d_name, "node") && isdigit(ent->d_name[4])) {
+			result = atoi(ent->d_name + 4);
+			break;
+		}
+	}
+	closedir(dir);
+	return result;
+}
+#endif
+
+static void
+configureFileBufferedChannels(ServerKit::FileBufferedChannelConfig &config) {
+	const VariantMap &options = *agentsOptions;
+	WorkingObjects *wo = workingObjects;
+
+	config.bufferDir = options.get("data_buffer_dir");
+	config.threshold = options.getUint("file_buffer_threshold");
+	if (wo->fileBufferMemoryBudget.limit > 0) {
+		config.memoryBudget = &wo->fileBufferMemoryBudget;
+	}
+	// The option parser only accepts these values.
+	string fileType = options.get("file_buffer_type");
+	if (fileType == "named") {
+		config.fileType = ServerKit::FBC_NAMED_FILE;
+	} else if (fileType == "unnamed") {
+		config.fileType = ServerKit::FBC_UNNAMED_FILE;
+	} else if (fileType == "memfd") {
+		config.fileType = ServerKit::FBC_MEMFD;
+	} else {
+		P_BUG("Unknown file buffer type: " << fileType);
+	}
+}
+
 static void
 spawningKitErrorHandler(const SpawningKit::ConfigPtr &config, SpawnException &e, const Options &options) {
 	ApplicationPool2::processAndLogNewSpawnException(e, options, config);
@@ -672,6 +789,12 @@ initializeNonPrivilegedWorkingObjects() {
 	unsigned int nthreads = options.getInt("core_threads");
 	BackgroundEventLoop *firstLoop = NULL; // Avoid compiler warning
 	wo->threadWorkingObjects.reserve(nthreads);
+	wo->fileBufferMemoryBudget.limit = options.getULL("file_buffer_memory_budget");
+	if (options.getBool("turbocache_shared")) {
+		wo->sharedResponseCache = boost::make_shared<SharedResponseCache>(nthreads,
+			options.getUint("turbocache_max_entries"),
+			options.getUint("turbocache_max_memory"));
+	}
 	for (unsigned int i = 0; i < nthreads; i++) {
 		UPDATE_TRACE_POINT();
 		ThreadWorkingObjects two;
@@ -692,10 +815,27 @@ initializeNonPrivilegedWorkingObjects() {
 		two.serverKitContext = new ServerKit::Context(two.bgloop->safe,
 			two.bgloop->libuv_loop);
 		two.serverKitContext->secureModePassword = wo->password;
-		two.serverKitContext->defaultFileBufferedChannelConfig.bufferDir =
-			options.get("data_buffer_dir");
-		two.serverKitContext->defaultFileBufferedChannelConfig.threshold =
-			options.getUint("file_buffer_threshold");
+		configureFileBufferedChannels(two.serverKitContext->defaultFileBufferedChannelConfig);
+		if (options.getBool("core_hugepage_buffers")) {
+			int numaNode = -1;
+			#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
+				if (options.getBool("core_cpu_affine")) {
+					numaNode = getNumaNodeOfCpu(i % boost::thread::hardware_concurrency());
+				}
+			#endif
+			if (!two.serverKitContext->enableMbufSlabs(numaNode) && i == 0) {
+				P_WARN("Cannot use huge page buffers: the buffer pool is already in use");
+			}
+		}
+		if (options.get("core_io_engine") == "io_uring") {
+			string error;
+			if (!two.serverKitContext->enableIoUring(&error)) {
+				if (i == 0) {
+					P_WARN("Cannot use the io_uring I/O engine, falling back to libev: "
+						<< error);
+				}
+			}
+		}
 
 		UPDATE_TRACE_POINT();
 		two.controller = new Core::Controller(two.serverKitContext,
@@ -703,6 +843,7 @@ initializeNonPrivilegedWorkingObjects() {
 		two.controller->resourceLocator = &wo->resourceLocator;
 		two.controller->appPool = wo->appPool;
 		two.controller->unionStationContext = wo->unionStationContext;
+		two.controller->sharedResponseCache = wo->sharedResponseCache;
 		two.controller->shutdownFinishCallback = controllerShutdownFinished;
 		two.controller->initialize();
 		wo->shutdownCounter.fetch_add(1, boost::memory_order_relaxed);
@@ -727,10 +868,7 @@ initializeNonPrivilegedWorkingObjects() {
 		awo->serverKitContext = new ServerKit::Context(awo->bgloop->safe,
 			awo->bgloop->libuv_loop);
 		awo->serverKitContext->secureModePassword = wo->password;
-		awo->serverKitContext->defaultFileBufferedChannelConfig.bufferDir =
-			options.get("data_buffer_dir");
-		awo->serverKitContext->defaultFileBufferedChannelConfig.threshold =
-			options.getUint("file_buffer_threshold");
+		configureFileBufferedChannels(awo->serverKitContext->defaultFileBufferedChannelConfig);
 
 		UPDATE_TRACE_POINT();
 		awo->apiServer = new Core::ApiServer::ApiServer(awo->serverKitContext,
@@ -759,19 +897,29 @@ initializeNonPrivilegedWorkingObjects() {
 	 * while the old server would delete the file yet again shortly after.
 	 * This is especially noticeable on systems that heavily swap.
 	 */
+	bool loadBalancing = false;
 	for (unsigned int i = 0; i < addresses.size(); i++) {
 		if (nthreads == 1) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[0];
 			two->controller->listen(wo->serverFds[i]);
+		} else if (!wo->reusePortServerFds[i].empty()) {
+			P_DEBUG("Core threads listen on " << addresses[i]
+				<< " using SO_REUSEPORT");
+			wo->threadWorkingObjects[0].controller->listen(wo->serverFds[i]);
+			for (unsigned int j = 1; j < nthreads; j++) {
+				ThreadWorkingObjects *two = &wo->threadWorkingObjects[j];
+				two->controller->listen(wo->reusePortServerFds[i][j - 1]);
+			}
 		} else {
 			wo->loadBalancer.listen(wo->serverFds[i]);
+			loadBalancing = true;
 		}
 	}
 	for (unsigned int i = 0; i < nthreads; i++) {
 		ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
 		two->controller->createSpareClients();
 	}
-	if (nthreads > 1) {
+	if (loadBalancing) {
 		wo->loadBalancer.servers.reserve(nthreads);
 		for (unsigned int i = 0; i < nthreads; i++) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
@@ -973,7 +1121,7 @@ mainLoop() {
 	if (wo->apiWorkingObjects.apiServer != NULL) {
 		wo->apiWorkingObjects.bgloop->start("API event loop", 0);
 	}
-	if (wo->threadWorkingObjects.size() > 1) {
+	if (!wo->loadBalancer.servers.empty()) {
 		wo->loadBalancer.start();
 	}
 	waitForExitEvent();
@@ -1084,7 +1232,7 @@ waitForExitEvent() {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
 			two->bgloop->safe->runLater(boost::bind(shutdownController, two));
 		}
-		if (wo->threadWorkingObjects.size() > 1) {
+		if (!wo->loadBalancer.servers.empty()) {
 			wo->loadBalancer.shutdown();
 		}
 		if (wo->apiWorkingObjects.apiServer != NULL) {
@@ -1140,6 +1288,9 @@ cleanup() {
 		if (wo->serverFds[i] != -1) {
 			close(wo->serverFds[i]);
 		}
+		for (unsigned int j = 0; j < wo->reusePortServerFds[i].size(); j++) {
+			close(wo->reusePortServerFds[i][j]);
+		}
 		if (wo->apiServerFds[i] != -1) {
 			close(wo->apiServerFds[i]);
 		}
@@ -1276,6 +1427,8 @@ setAgentsOptionsDefaults() {
 	options.setDefaultInt("max_pool_size", DEFAULT_MAX_POOL_SIZE);
 	options.setDefaultInt("pool_idle_time", DEFAULT_POOL_IDLE_TIME);
 	options.setDefaultInt("min_instances", 1);
+	options.setDefaultUint("spawn_concurrency", DEFAULT_SPAWN_CONCURRENCY);
+	options.setDefaultBool("predictive_spawning", false);
 	options.setDefaultInt("max_preloader_idle_time", DEFAULT_MAX_PRELOADER_IDLE_TIME);
 	options.setDefaultUint("max_request_queue_size", DEFAULT_MAX_REQUEST_QUEUE_SIZE);
 	options.setDefaultUint("stat_throttle_rate", DEFAULT_STAT_THROTTLE_RATE);
@@ -1284,13 +1437,23 @@ setAgentsOptionsDefaults() {
 	options.setDefaultBool("sticky_sessions", false);
 	options.setDefault("sticky_sessions_cookie_name", DEFAULT_STICKY_SESSIONS_COOKIE_NAME);
 	options.setDefaultBool("turbocaching", true);
+	options.setDefaultUint("turbocache_max_entries", DEFAULT_TURBOCACHE_MAX_ENTRIES);
+	options.setDefaultUint("turbocache_max_memory", DEFAULT_TURBOCACHE_MAX_MEMORY);
+	options.setDefaultUint("turbocache_max_body_size", DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+	options.setDefaultBool("turbocache_shared", false);
 	options.setDefault("data_buffer_dir", getSystemTempDir());
 	options.setDefaultUint("file_buffer_threshold", DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD);
+	options.setDefaultULL("file_buffer_memory_budget", 0);
+	options.setDefault("file_buffer_type", "named");
 	options.setDefaultInt("response_buffer_high_watermark", DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+	options.setDefaultUint("app_connect_timeout", DEFAULT_APP_CONNECT_TIMEOUT);
 	options.setDefaultBool("selfchecks", false);
 	options.setDefaultBool("core_graceful_exit", true);
 	options.setDefaultInt("core_threads", boost::thread::hardware_concurrency());
 	options.setDefaultBool("core_cpu_affine", false);
+	options.setDefaultBool("core_reuse_port", false);
+	options.setDefaultBool("core_hugepage_buffers", false);
+	options.setDefault("core_io_engine", "libev");
 	options.setDefault("friendly_error_pages", "auto");
 	options.setDefaultBool("rolling_restarts", false);
 	options.setDefaultBool("resist_deployment_errors", false);
@@ -29,6 +29,9 @@
 #include <boost/thread.hpp>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
 #include <Constants.h>
 #include <Utils.h>
 #include <Utils/VariantMap.h>
@@ -147,6 +150,14 @@ coreUsage() {
 	printf("                            process can handle the given number of concurrent\n");
 	printf("                            requests per process\n");
 	printf("      --min-instances N     Minimum number of application processes. Default: 1\n");
+	printf("      --spawn-concurrency N Maximum number of processes that a single\n");
+	printf("                            application may spawn at the same time.\n");
+	printf("                            Default: %d\n", DEFAULT_SPAWN_CONCURRENCY);
+	printf("      --predictive-spawning\n");
+	printf("                            Spawn processes ahead of demand based on the\n");
+	printf("                            request rate trend, and shut down surplus\n");
+	printf("                            processes before they reach the pool idle\n");
+	printf("                            time\n");
 	printf("      --memory-limit MB     Restart application processes that go over the\n");
 	printf("                            given memory limit (Enterprise only)\n");
 	printf("\n");
@@ -158,6 +169,22 @@ coreUsage() {
 	printf("      --max-request-queue-size NUMBER\n");
 	printf("                            Specify request queue size. Default: %d\n",
 		DEFAULT_MAX_REQUEST_QUEUE_SIZE);
+	printf("      --app-connect-timeout MSEC\n");
+	printf("                            Give up connecting to an application process\n");
+	printf("                            that does not accept the connection within the\n");
+	printf("                            given time. 0 means no timeout.\n");
+	printf("                            Default: %d\n", DEFAULT_APP_CONNECT_TIMEOUT);
+	printf("      --client-keepalive-timeout SECONDS\n");
+	printf("                            Disconnect keep-alive clients that do not send\n");
+	printf("                            a next request within the given time.\n");
+	printf("                            Default: 0 (no timeout)\n");
+	printf("      --client-header-timeout SECONDS\n");
+	printf("                            Disconnect clients that do not send a complete\n");
+	printf("                            request header within the given time.\n");
+	printf("                            Default: 0 (no timeout)\n");
+	printf("      --client-body-timeout SECONDS\n");
+	printf("                            Disconnect clients that stop sending the request\n");
+	printf("                            body for the given time. Default: 0 (no timeout)\n");
 	printf("      --sticky-sessions     Enable sticky sessions\n");
 	printf("      --sticky-sessions-cookie-name NAME\n");
 	printf("                            Cookie name to use for sticky sessions.\n");
@@ -166,6 +193,20 @@ coreUsage() {
 	printf("                            Vary the turbocache by the cookie of the given name\n");
 	printf("      --disable-turbocaching\n");
 	printf("                            Disable turbocaching\n");
+	printf("      --turbocache-max-entries NUMBER\n");
+	printf("                            Maximum number of responses in the turbocache of\n");
+	printf("                            each core thread. Default: %d\n",
+		DEFAULT_TURBOCACHE_MAX_ENTRIES);
+	printf("      --turbocache-max-memory BYTES\n");
+	printf("                            Maximum amount of memory used by the turbocache of\n");
+	printf("                            each core thread. Default: %d\n",
+		DEFAULT_TURBOCACHE_MAX_MEMORY);
+	printf("      --turbocache-max-body-size BYTES\n");
+	printf("                            Responses with larger bodies are not turbocached.\n");
+	printf("                            Default: %d\n", DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+	printf("      --turbocache-shared   Use a single turbocache for all core threads. The\n");
+	printf("                            turbocache limits then apply to the shared cache\n");
+	printf("                            as a whole. Default: off\n");
 	printf("      --no-abort-websockets-on-process-shutdown\n");
 	printf("                            Do not abort WebSocket connections on process\n");
 	printf("                            shutdown or restart\n");
@@ -183,6 +224,16 @@ coreUsage() {
 	printf("      --data-buffer-dir PATH\n");
 	printf("                            Directory to store data buffers in. Default:\n");
 	printf("                            %s\n", getSystemTempDir());
+	printf("      --file-buffer-memory-budget BYTES\n");
+	printf("                            Total amount of memory that all connections may\n");
+	printf("                            use for buffering data. Beyond it, connections\n");
+	printf("                            buffering at least %d bytes buffer to disk.\n",
+		DEFAULT_FILE_BUFFERED_CHANNEL_MIN_THRESHOLD);
+	printf("                            Default: 0 (use a fixed per-connection limit)\n");
+	printf("      --file-buffer-type TYPE\n");
+	printf("                            Kind of file to buffer data to: named, unnamed\n");
+	printf("                            (O_TMPFILE) or memfd (Linux only for the\n");
+	printf("                            latter two). Default: named\n");
 	printf("      --no-graceful-exit    When exiting, exit immediately instead of waiting\n");
 	printf("                            for all connections to terminate\n");
 	printf("      --benchmark MODE      Enable benchmark mode. Available modes:\n");
@@ -195,6 +246,20 @@ coreUsage() {
 	printf("                            Default: number of CPU cores (%d)\n",
 		boost::thread::hardware_concurrency());
 	printf("      --cpu-affine          Enable per-thread CPU affinity (Linux only)\n");
+	printf("      --reuse-port          Give each thread its own SO_REUSEPORT socket for\n");
+	printf("                            TCP addresses instead of distributing clients\n");
+	printf("                            from a single socket. Combined with --cpu-affine,\n");
+	printf("                            clients are steered to the thread running on\n");
+	printf("                            the CPU that received them, if there is one\n");
+	printf("                            thread per CPU. (Linux only)\n");
+	printf("                            Default: off\n");
+	printf("      --hugepage-buffers    Allocate I/O buffers from 2 MB slabs backed by\n");
+	printf("                            transparent huge pages. Combined with\n");
+	printf("                            --cpu-affine, each thread's slabs are placed on\n");
+	printf("                            its NUMA node. (Linux only) Default: off\n");
+	printf("      --io-engine NAME      I/O engine for request handling: libev or\n");
+	printf("                            io_uring (Linux only). Falls back to libev if\n");
+	printf("                            io_uring is unavailable. Default: libev\n");
 	printf("      --core-file-descriptor-ulimit NUMBER\n");
 	printf("                            Set custom file descriptor ulimit for the core\n");
 	printf("  -h, --help                Show this help\n");
@@ -204,6 +269,57 @@ coreUsage() {
 	printf("  full        Full access (default)\n");
 }
 
+/**
+ * Parses the value of a numeric option, or exits with an error message if
+ * the value is not an integer between `min` and `max`. Unlike atoi(), this
+ * rejects negative values instead of letting them wrap around.
+ */
+inline unsigned int
+parseUintOptionValue(const char *optionName, const char *value,
+	unsigned int min, unsigned int max)
+{
+	char *end;
+	unsigned long long result;
+
+	errno = 0;
+	result = strtoull(value, &end, 10);
+	if (*value == '\0' || *end != '\0' || errno != 0
+	 || strchr(value, '-') != NULL
+	 || result < min || result > max)
+	{
+		fprintf(stderr, "ERROR: invalid value for %s: '%s'. The value must be "
+			"a number between %u and %u.\n", optionName, value, min, max);
+		exit(1);
+	}
+	return (unsigned int) result;
+}
+
+/**
+ * Returns the value of an option that accepts one of a fixed set of names,
+ * or exits with an error message if the value is not in `allowedValues`
+ * (a NULL-terminated array).
+ */
+inline const char *
+parseEnumOptionValue(const char *optionName, const char *value,
+	const char * const *allowedValues)
+{
+	string allowed;
+
+	for (const char * const *it = allowedValues; *it != NULL; it++) {
+		if (strcmp(value, *it) == 0) {
+			return value;
+		}
+		if (!allowed.empty()) {
+			allowed.append(", ");
+		}
+		allowed.append(*it);
+	}
+
+	fprintf(stderr, "ERROR: invalid value for %s: '%s'. The value must be "
+		"one of: %s.\n", optionName, value, allowed.c_str());
+	exit(1);
+}
+
 inline bool
 parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	OptionParser p(coreUsage);
@@ -297,6 +413,13 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--min-instances")) {
 		options.setInt("min_instances", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--spawn-concurrency")) {
+		options.setUint("spawn_concurrency", parseUintOptionValue(
+			"--spawn-concurrency", argv[i + 1], 1, UINT_MAX));
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--predictive-spawning")) {
+		options.setBool("predictive_spawning", true);
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--memory-limit")) {
 		options.setInt("memory_limit", atoi(argv[i + 1]));
 		i += 2;
@@ -339,6 +462,19 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-request-queue-size")) {
 		options.setInt("max_request_queue_size", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--app-connect-timeout")) {
+		options.setUint("app_connect_timeout", parseUintOptionValue(
+			"--app-connect-timeout", argv[i + 1], 0, UINT_MAX));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--client-keepalive-timeout")) {
+		options.setUint("client_keepalive_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--client-header-timeout")) {
+		options.setUint("client_header_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--client-body-timeout")) {
+		options.setUint("client_body_timeout", atoi(argv[i + 1]));
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--sticky-sessions")) {
 		options.setBool("sticky_sessions", true);
 		i++;
@@ -351,6 +487,21 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isFlag(argv[i], '\0', "--disable-turbocaching")) {
 		options.setBool("turbocaching", false);
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-entries")) {
+		options.setUint("turbocache_max_entries", parseUintOptionValue(
+			"--turbocache-max-entries", argv[i + 1], 1, TURBOCACHE_MAX_ENTRIES_LIMIT));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-memory")) {
+		options.setUint("turbocache_max_memory", parseUintOptionValue(
+			"--turbocache-max-memory", argv[i + 1], 1, UINT_MAX));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-body-size")) {
+		options.setUint("turbocache_max_body_size", parseUintOptionValue(
+			"--turbocache-max-body-size", argv[i + 1], 0, UINT_MAX));
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--turbocache-shared")) {
+		options.setBool("turbocache_shared", true);
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-abort-websockets-on-process-shutdown")) {
 		options.setBool("abort_websockets_on_process_shutdown", false);
 		i++;
@@ -402,6 +553,14 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--data-buffer-dir")) {
 		options.setInt("data_buffer_dir", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--file-buffer-memory-budget")) {
+		options.setULL("file_buffer_memory_budget", stringToULL(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--file-buffer-type")) {
+		static const char * const fileBufferTypes[] = { "named", "unnamed", "memfd", NULL };
+		options.set("file_buffer_type", parseEnumOptionValue("--file-buffer-type",
+			argv[i + 1], fileBufferTypes));
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--no-graceful-exit")) {
 		options.setBool("core_graceful_exit", false);
 		i++;
@@ -417,6 +576,17 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isFlag(argv[i], '\0', "--cpu-affine")) {
 		options.setBool("core_cpu_affine", true);
 		i++;
+	} else if (p.isFlag(argv[i], '\0', "--reuse-port")) {
+		options.setBool("core_reuse_port", true);
+		i++;
+	} else if (p.isFlag(argv[i], '\0', "--hugepage-buffers")) {
+		options.setBool("core_hugepage_buffers", true);
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--io-engine")) {
+		static const char * const ioEngines[] = { "libev", "io_uring", NULL };
+		options.set("core_io_engine", parseEnumOptionValue("--io-engine",
+			argv[i + 1], ioEngines));
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--core-file-descriptor-ulimit")) {
 		options.setUint("core_file_descriptor_ulimit", atoi(argv[i + 1]));
 		i += 2;
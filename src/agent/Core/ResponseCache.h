@@ -30,9 +30,16 @@
 #include <time.h>
 #include <cassert>
 #include <cstring>
+#include <vector>
+#include <Constants.h>
+#include <MemoryKit/mbuf.h>
 #include <DataStructures/HashedStaticString.h>
+#include <DataStructures/FrequencySketch.h>
+#include <Core/SharedResponseCache.h>
+#include <Core/ResponseCacheKeyStatistics.h>
 #include <ServerKit/http_parser.h>
 #include <ServerKit/CookieUtils.h>
+#include <ServerKit/KnownHeaders.h>
 #include <StaticString.h>
 #include <Utils/DateParsing.h>
 #include <Utils/StrIntUtils.h>
@@ -40,17 +47,35 @@
 namespace Passenger {
 
 /**
+ * A per-thread cache of HTTP responses, used for turbocaching.
+ *
+ * Responses are stored in variable-sized mbufs, and the cache is bounded both
+ * by a maximum number of entries and by a memory budget. Entries are looked up
+ * through an open addressing hash table and evicted in LRU order. When the
+ * cache is full, a new response is only admitted if its key has been requested
+ * more often than the key of the entry that would be evicted for it. This is
+ * the TinyLFU admission policy, and it prevents a stream of one-off requests
+ * from flushing out popular entries. Request frequencies are tracked by a
+ * FrequencySketch.
+ *
+ * Responses that are no longer fresh are kept around for as long as the
+ * `stale-while-revalidate` and `stale-if-error` Cache-Control extensions
+ * (RFC 5861) allow them to be served. See fetchStale().
+ *
+ * Optionally, responses can be stored in a SharedResponseCache instead, so
+ * that all threads benefit from a single application response. In that mode
+ * this object only applies the caching rules and keeps statistics.
+ *
  * Relevant RFCs:
  * https://tools.ietf.org/html/rfc7234    HTTP 1.1 Caching
  * https://tools.ietf.org/html/rfc2109    HTTP State Management Mechanism
+ * https://tools.ietf.org/html/rfc5861    HTTP Cache-Control Extensions for Stale Content
  */
 template<typename Request>
 class ResponseCache {
 public:
-	static const unsigned int MAX_ENTRIES     = 8; // Fits in exactly 2 cache lines
 	static const unsigned int MAX_KEY_LENGTH  = 256;
 	static const unsigned int MAX_HEADER_SIZE = 4096;
-	static const unsigned int MAX_BODY_SIZE   = 1024 * 32;
 	static const unsigned int DEFAULT_HEURISTIC_FRESHNESS = 10;
 	static const unsigned int MIN_HEURISTIC_FRESHNESS = 1;
 
@@ -59,31 +84,63 @@ public:
 		unsigned short keySize;
 		boost::uint32_t hash;
 		time_t date;
+		// Neighbors in the LRU list, or -1.
+		int lruPrev, lruNext;
 
 		Header()
 			: valid(false),
 			  keySize(0),
 			  hash(0),
-			  date(0)
+			  date(0),
+			  lruPrev(-1),
+			  lruNext(-1)
 			{ }
 	};
 
+	/**
+	 * The HTTP header, the dechunked HTTP body and the key are stored
+	 * back-to-back in a single mbuf, so that the body can be written to
+	 * clients by reference instead of being copied.
+	 */
 	struct Body {
-		unsigned short httpHeaderSize;
-		unsigned short httpBodySize;
+		unsigned int httpHeaderSize;
+		unsigned int httpBodySize;
 		time_t expiryDate;
-		char key[MAX_KEY_LENGTH];
-		char httpHeaderData[MAX_HEADER_SIZE];
-		// This data is dechunked.
-		char httpBodyData[MAX_BODY_SIZE];
+		// Until when the response may be served stale, or 0.
+		time_t staleWhileRevalidateUntil;
+		time_t staleIfErrorUntil;
+		MemoryKit::mbuf data;
 
 		Body()
 			: httpHeaderSize(0),
 			  httpBodySize(0),
-			  expiryDate(0)
-		{
-			key[0] = httpHeaderData[0] = httpBodyData[0] = '\0';
+			  expiryDate(0),
+			  staleWhileRevalidateUntil(0),
+			  staleIfErrorUntil(0)
+			{ }
+
+		// Until when the response may be served at all.
+		time_t getRetentionDate() const {
+			return std::max(expiryDate,
+				std::max(staleWhileRevalidateUntil, staleIfErrorUntil));
 		}
+
+		char *getHttpHeaderData() const {
+			return data.start;
+		}
+
+		char *getHttpBodyData() const {
+			return data.start + httpHeaderSize;
+		}
+
+		const char *getKey() const {
+			return data.start + httpHeaderSize + httpBodySize;
+		}
+	};
+
+	enum StaleUse {
+		STALE_WHILE_REVALIDATE,
+		STALE_IF_ERROR
 	};
 
 	struct Entry {
@@ -126,24 +183,35 @@ public:
 
 private:
 	HashedStaticString HOST;
-	HashedStaticString CACHE_CONTROL;
-	HashedStaticString PRAGMA_CONST;
-	HashedStaticString AUTHORIZATION;
-	HashedStaticString VARY;
-	HashedStaticString WWW_AUTHENTICATE;
-	HashedStaticString X_SENDFILE;
-	HashedStaticString X_ACCEL_REDIRECT;
-	HashedStaticString EXPIRES;
-	HashedStaticString LAST_MODIFIED;
-	HashedStaticString LOCATION;
-	HashedStaticString CONTENT_LOCATION;
-	HashedStaticString COOKIE;
 	HashedStaticString PASSENGER_VARY_TURBOCACHE_BY_COOKIE;
 
 	unsigned int fetches, hits, stores, storeSuccesses;
-
-	Header headers[MAX_ENTRIES];
-	Body bodies[MAX_ENTRIES];
+	unsigned int rejections, evictions;
+
+	MemoryKit::mbuf_pool *mbufPool;
+	unsigned int maxEntries;
+	unsigned int maxBodySize;
+	size_t maxMemory;
+
+	unsigned int population;
+	size_t memoryUsage;
+	int lruHead, lruTail;
+	std::vector<Header> headers;
+	std::vector<Body> bodies;
+	std::vector<unsigned int> freeIndices;
+	// Open addressing hash table of entry indices, -1 means empty.
+	std::vector<int> buckets;
+	unsigned int bucketMask;
+	FrequencySketch sketch;
+	ResponseCacheKeyStatistics keyStatistics;
+
+	SharedResponseCache *sharedCache;
+	unsigned int sharedCacheReader;
+	// A record returned by store() that has not been committed yet.
+	SharedResponseCache::Record *pendingRecord;
+	// Describes the shared record that was last fetched or stored.
+	Header sharedHeader;
+	Body sharedBody;
 
 	unsigned int calculateKeyLength(const LString * restrict host,
 		const LString * restrict varyCookie,
@@ -216,35 +284,210 @@ private:
 		}
 	}
 
-	Entry lookup(const HashedStaticString &cacheKey) {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (headers[i].valid
-			 && headers[i].hash == cacheKey.hash()
-			 && cacheKey == StaticString(bodies[i].key, headers[i].keySize))
+	size_t calculateFootprint(size_t recordSize) const {
+		return std::max<size_t>(recordSize, MemoryKit::mbuf_pool_data_size(mbufPool))
+			+ sizeof(MemoryKit::mbuf_block);
+	}
+
+	int findBucket(const StaticString &key, boost::uint32_t hash) const {
+		unsigned int i = hash & bucketMask;
+		while (buckets[i] != -1) {
+			const Header &header = headers[buckets[i]];
+			if (header.hash == hash
+			 && key == StaticString(bodies[buckets[i]].getKey(), header.keySize))
 			{
-				return Entry(i, &headers[i], &bodies[i]);
+				return i;
 			}
+			i = (i + 1) & bucketMask;
 		}
-		return Entry();
+		return -1;
 	}
 
-	Entry lookupInvalidOrOldest() {
-		int oldest = -1;
+	void addToIndex(unsigned int index) {
+		unsigned int i = headers[index].hash & bucketMask;
+		while (buckets[i] != -1) {
+			i = (i + 1) & bucketMask;
+		}
+		buckets[i] = index;
+	}
+
+	void removeFromIndex(unsigned int index) {
+		unsigned int i = headers[index].hash & bucketMask;
+		while (buckets[i] != (int) index) {
+			i = (i + 1) & bucketMask;
+		}
 
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (!headers[i].valid) {
-				return Entry(i, &headers[i], &bodies[i]);
-			} else if (oldest == -1 || headers[i].date < headers[oldest].date) {
-				oldest = i;
+		// Shift back subsequent entries in the probe chain so that
+		// no gaps are left behind.
+		unsigned int j = i;
+		while (true) {
+			j = (j + 1) & bucketMask;
+			if (buckets[j] == -1) {
+				break;
+			}
+			unsigned int home = headers[buckets[j]].hash & bucketMask;
+			bool movable = (j > i)
+				? (home <= i || home > j)
+				: (home <= i && home > j);
+			if (movable) {
+				buckets[i] = buckets[j];
+				i = j;
 			}
 		}
+		buckets[i] = -1;
+	}
 
-		return Entry(oldest, &headers[oldest], &bodies[oldest]);
+	void lruUnlink(unsigned int index) {
+		Header &header = headers[index];
+		if (header.lruPrev == -1) {
+			lruHead = header.lruNext;
+		} else {
+			headers[header.lruPrev].lruNext = header.lruNext;
+		}
+		if (header.lruNext == -1) {
+			lruTail = header.lruPrev;
+		} else {
+			headers[header.lruNext].lruPrev = header.lruPrev;
+		}
+		header.lruPrev = header.lruNext = -1;
+	}
+
+	void lruPushFront(unsigned int index) {
+		Header &header = headers[index];
+		header.lruPrev = -1;
+		header.lruNext = lruHead;
+		if (lruHead != -1) {
+			headers[lruHead].lruPrev = index;
+		}
+		lruHead = index;
+		if (lruTail == -1) {
+			lruTail = index;
+		}
+	}
+
+	Entry wrapSharedRecord(const SharedResponseCache::Record *record) {
+		sharedHeader.valid    = true;
+		sharedHeader.hash     = record->hash;
+		sharedHeader.keySize  = record->keySize;
+		sharedHeader.date     = record->date;
+		sharedBody.expiryDate = record->expiryDate;
+		sharedBody.staleWhileRevalidateUntil = record->staleWhileRevalidateUntil;
+		sharedBody.staleIfErrorUntil = record->staleIfErrorUntil;
+		sharedBody.httpHeaderSize = record->httpHeaderSize;
+		sharedBody.httpBodySize   = record->httpBodySize;
+		// Not reference counted: the data is only valid until the
+		// event loop goes through its next iteration.
+		sharedBody.data = MemoryKit::mbuf(record->getData(), record->getDataSize());
+		return Entry(0, &sharedHeader, &sharedBody);
+	}
+
+	void discardPendingRecord() {
+		if (pendingRecord != NULL) {
+			SharedResponseCache::destroyRecord(pendingRecord);
+			pendingRecord = NULL;
+		}
+	}
+
+	Entry fetchShared(Request *req, ev_tstamp now) {
+		const SharedResponseCache::Record *record = sharedCache->lookup(
+			req->cacheKey, req->cacheKey.hash());
+		Entry entry;
+		if (record == NULL) {
+			entry.cacheMissReason = Entry::NOT_FOUND;
+		} else {
+			hits++;
+			if (record->expiryDate > now) {
+				entry = wrapSharedRecord(record);
+			} else {
+				if (record->getRetentionDate() <= now) {
+					sharedCache->removeExpired(req->cacheKey, req->cacheKey.hash(),
+						(time_t) now);
+				}
+				entry.cacheMissReason = Entry::NOT_FRESH;
+			}
+		}
+		return entry;
+	}
+
+	Entry storeShared(const HashedStaticString &cacheKey, time_t responseDate,
+		time_t expiryDate, time_t staleWhileRevalidateUntil, time_t staleIfErrorUntil,
+		unsigned int headerSize, unsigned int bodySize)
+	{
+		discardPendingRecord();
+		pendingRecord = sharedCache->createRecord(cacheKey, cacheKey.hash(),
+			responseDate, expiryDate, headerSize, bodySize);
+		if (pendingRecord == NULL) {
+			return Entry();
+		}
+		pendingRecord->staleWhileRevalidateUntil = staleWhileRevalidateUntil;
+		pendingRecord->staleIfErrorUntil = staleIfErrorUntil;
+		storeSuccesses++;
+		return wrapSharedRecord(pendingRecord);
+	}
+
+	void eraseKey(const HashedStaticString &cacheKey) {
+		if (sharedCache != NULL) {
+			sharedCache->remove(cacheKey, cacheKey.hash());
+		} else {
+			Entry entry(lookup(cacheKey));
+			if (entry.valid()) {
+				erase(entry.index);
+			}
+		}
+	}
+
+	Entry lookup(const HashedStaticString &cacheKey) {
+		int bucket = findBucket(cacheKey, cacheKey.hash());
+		if (bucket == -1) {
+			return Entry();
+		} else {
+			unsigned int i = buckets[bucket];
+			return Entry(i, &headers[i], &bodies[i]);
+		}
+	}
+
+	bool hasRoomFor(size_t footprint) const {
+		return population < maxEntries && memoryUsage + footprint <= maxMemory;
+	}
+
+	/**
+	 * The TinyLFU admission policy: a new record is admitted into a full
+	 * cache only if its key is requested more often than the key of the
+	 * first eviction victim.
+	 *
+	 * @pre footprint <= maxMemory
+	 */
+	bool shouldAdmit(boost::uint32_t hash, size_t footprint) const {
+		return hasRoomFor(footprint)
+			|| (lruTail != -1
+				&& sketch.estimate(hash) > sketch.estimate(headers[lruTail].hash));
+	}
+
+	/**
+	 * Evicts entries, least recently used first, until there is room
+	 * for a new record with the given footprint.
+	 *
+	 * @pre footprint <= maxMemory
+	 */
+	void evictUntilRoomFor(size_t footprint) {
+		while (!hasRoomFor(footprint)) {
+			erase(lruTail);
+			evictions++;
+		}
 	}
 
-	OXT_FORCE_INLINE
 	void erase(unsigned int index) {
-		headers[index].valid = false;
+		Header &header = headers[index];
+		Body &body = bodies[index];
+		assert(header.valid);
+
+		removeFromIndex(index);
+		lruUnlink(index);
+		memoryUsage -= calculateFootprint(body.data.size());
+		header.valid = false;
+		body.data = MemoryKit::mbuf();
+		freeIndices.push_back(index);
+		population--;
 	}
 
 	time_t parseDate(psg_pool_t *pool, const LString *date, ev_tstamp now) const {
@@ -317,6 +560,38 @@ private:
 		return entry.body->expiryDate > now;
 	}
 
+	// Parses a Cache-Control directive of the form `name=seconds`.
+	// Returns 0 if the directive is absent or invalid.
+	unsigned int parseCacheControlSeconds(const StaticString &cacheControl,
+		const StaticString &name) const
+	{
+		string::size_type pos = cacheControl.find(name);
+		if (pos == string::npos
+		 || cacheControl.size() <= pos + name.size() + 1
+		 || cacheControl[pos + name.size()] != '=')
+		{
+			return 0;
+		}
+		return stringToUint(cacheControl.substr(pos + name.size() + 1));
+	}
+
+	time_t determineStaleDate(const Request *req, time_t expiryDate,
+		const StaticString &directive) const
+	{
+		const LString *value = req->appResponse.cacheControl;
+		if (value == NULL) {
+			return 0;
+		}
+
+		StaticString cacheControl(value->start->data, value->size);
+		unsigned int seconds = parseCacheControlSeconds(cacheControl, directive);
+		if (seconds == 0) {
+			return 0;
+		} else {
+			return expiryDate + seconds;
+		}
+	}
+
 	StaticString extractHostNameWithPortFromParsedUrl(struct http_parser_url &url,
 		const LString *value) const
 	{
@@ -331,7 +606,7 @@ private:
 		}
 	}
 
-	void invalidateLocation(Request *req, const HashedStaticString &header) {
+	void invalidateLocation(Request *req, ServerKit::KnownHeaderId header) {
 		const LString *value = req->appResponse.headers.lookup(header);
 		if (value == NULL || value->size == 0) {
 			return;
@@ -401,34 +676,200 @@ private:
 
 		char *key = (char *) psg_pnalloc(req->pool, keySize);
 		generateKey(https, path, req->host, req->varyCookie, key, keySize);
+		eraseKey(HashedStaticString(key, keySize));
+	}
+
+
+	// Implementation of fetch(), without the per-key statistics.
+	Entry fetchEntry(Request *req, ev_tstamp now) {
+		if (sharedCache != NULL) {
+			return fetchShared(req, now);
+		}
+
+		Entry entry(lookup(req->cacheKey));
+		if (entry.valid()) {
+			hits++;
+			if (isFresh(entry, now)) {
+				if (lruHead != (int) entry.index) {
+					lruUnlink(entry.index);
+					lruPushFront(entry.index);
+				}
+				return entry;
+			} else {
+				if (entry.body->getRetentionDate() <= now) {
+					erase(entry.index);
+				}
+				Entry result;
+				result.cacheMissReason = Entry::NOT_FRESH;
+				return result;
+			}
+		} else {
+			entry.cacheMissReason = Entry::NOT_FOUND;
+			return entry;
+		}
+	}
+
+	// Implementation of store(), without the per-key statistics.
+	Entry storeEntry(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
+		stores++;
+
+		if (headerSize > MAX_HEADER_SIZE || bodySize > maxBodySize) {
+			return Entry();
+		}
+
+		time_t responseDate = parseDate(req->pool, req->appResponse.date, now);
+		if (responseDate == (time_t) -1) {
+			return Entry();
+		}
+
+		time_t expiryDate = determineExpiryDate(req, responseDate, now);
+		if (expiryDate == (time_t) -1) {
+			return Entry();
+		}
+		time_t staleWhileRevalidateUntil = determineStaleDate(req, expiryDate,
+			P_STATIC_STRING("stale-while-revalidate"));
+		time_t staleIfErrorUntil = determineStaleDate(req, expiryDate,
+			P_STATIC_STRING("stale-if-error"));
 
-		Entry entry(lookup(StaticString(key, keySize)));
+		const HashedStaticString &cacheKey = req->cacheKey;
+		size_t recordSize = headerSize + bodySize + cacheKey.size();
+		size_t footprint = calculateFootprint(recordSize);
+		if (sharedCache != NULL) {
+			return storeShared(cacheKey, responseDate, expiryDate,
+				staleWhileRevalidateUntil, staleIfErrorUntil,
+				headerSize, bodySize);
+		} else if (footprint > maxMemory) {
+			return Entry();
+		}
+
+		Entry entry(lookup(cacheKey));
 		if (entry.valid()) {
-			entry.header->valid = false;
+			// Already admitted before, so replace it unconditionally.
+			erase(entry.index);
+		} else if (!shouldAdmit(cacheKey.hash(), footprint)) {
+			// The response is cacheable, so don't count this as a failed store.
+			stores--;
+			rejections++;
+			return Entry();
+		}
+		evictUntilRoomFor(footprint);
+
+		MemoryKit::mbuf data(MemoryKit::mbuf_get_with_size(mbufPool, recordSize));
+		if (data.empty()) {
+			return Entry();
 		}
+
+		unsigned int index = freeIndices.back();
+		freeIndices.pop_back();
+		entry = Entry(index, &headers[index], &bodies[index]);
+		entry.header->valid    = true;
+		entry.header->hash     = cacheKey.hash();
+		entry.header->keySize  = cacheKey.size();
+		entry.header->date     = responseDate;
+		entry.body->expiryDate = expiryDate;
+		entry.body->staleWhileRevalidateUntil = staleWhileRevalidateUntil;
+		entry.body->staleIfErrorUntil = staleIfErrorUntil;
+		entry.body->httpHeaderSize = headerSize;
+		entry.body->httpBodySize   = bodySize;
+		entry.body->data = boost::move(data);
+		memcpy(const_cast<char *>(entry.body->getKey()), cacheKey.data(), cacheKey.size());
+
+		addToIndex(index);
+		lruPushFront(index);
+		memoryUsage += footprint;
+		population++;
+		storeSuccesses++;
+		return entry;
 	}
 
 public:
 	ResponseCache()
-		: CACHE_CONTROL("cache-control"),
-		  PRAGMA_CONST("pragma"),
-		  AUTHORIZATION("authorization"),
-		  VARY("vary"),
-		  WWW_AUTHENTICATE("www-authenticate"),
-		  X_SENDFILE("x-sendfile"),
-		  X_ACCEL_REDIRECT("x-accel-redirect"),
-		  EXPIRES("expires"),
-		  LAST_MODIFIED("last-modified"),
-		  LOCATION("location"),
-		  CONTENT_LOCATION("content-location"),
-		  COOKIE("cookie"),
-		  PASSENGER_VARY_TURBOCACHE_BY_COOKIE("!~PASSENGER_VARY_TURBOCACHE_COOKIE"),
+		: PASSENGER_VARY_TURBOCACHE_BY_COOKIE("!~PASSENGER_VARY_TURBOCACHE_COOKIE"),
 		  fetches(0),
 		  hits(0),
 		  stores(0),
-		  storeSuccesses(0)
+		  storeSuccesses(0),
+		  rejections(0),
+		  evictions(0),
+		  mbufPool(NULL),
+		  maxEntries(0),
+		  maxBodySize(0),
+		  maxMemory(0),
+		  population(0),
+		  memoryUsage(0),
+		  lruHead(-1),
+		  lruTail(-1),
+		  bucketMask(0),
+		  sharedCache(NULL),
+		  sharedCacheReader(0),
+		  pendingRecord(NULL)
 		{ }
 
+	~ResponseCache() {
+		discardPendingRecord();
+	}
+
+	/**
+	 * Must be called before storing anything. Response data is allocated
+	 * from `mbufPool`, which must outlive all responses written from this
+	 * cache. Clears the cache.
+	 */
+	void initialize(MemoryKit::mbuf_pool *mbufPool,
+		unsigned int maxEntries = DEFAULT_TURBOCACHE_MAX_ENTRIES,
+		size_t maxMemory = DEFAULT_TURBOCACHE_MAX_MEMORY,
+		unsigned int maxBodySize = DEFAULT_TURBOCACHE_MAX_BODY_SIZE)
+	{
+		assert(maxEntries > 0);
+		clear();
+		this->mbufPool = mbufPool;
+		this->maxEntries = maxEntries;
+		this->maxMemory = maxMemory;
+		this->maxBodySize = maxBodySize;
+
+		unsigned int nbuckets = 16;
+		while (nbuckets < maxEntries * 2) {
+			nbuckets *= 2;
+		}
+		headers.assign(maxEntries, Header());
+		bodies.assign(maxEntries, Body());
+		buckets.assign(nbuckets, -1);
+		bucketMask = nbuckets - 1;
+		freeIndices.clear();
+		for (unsigned int i = maxEntries; i > 0; i--) {
+			freeIndices.push_back(i - 1);
+		}
+		sketch.resize(maxEntries);
+		keyStatistics.resize(maxEntries);
+	}
+
+	/**
+	 * Stores responses in the given shared cache from now on, instead of
+	 * in this object. Registers the calling thread as a reader of the
+	 * shared cache. The caller must call `sharedCacheReaderOnline()` and
+	 * `sharedCacheReaderOffline()` around event processing.
+	 */
+	void useSharedCache(SharedResponseCache *cache) {
+		clear();
+		sharedCache = cache;
+		sharedCacheReader = cache->registerReader();
+	}
+
+	SharedResponseCache *getSharedCache() const {
+		return sharedCache;
+	}
+
+	void sharedCacheReaderOnline() {
+		if (sharedCache != NULL) {
+			sharedCache->readerOnline(sharedCacheReader);
+		}
+	}
+
+	void sharedCacheReaderOffline() {
+		if (sharedCache != NULL) {
+			sharedCache->readerOffline(sharedCacheReader);
+		}
+	}
+
 	OXT_FORCE_INLINE
 	unsigned int getFetches() const {
 		return fetches;
@@ -446,7 +887,7 @@ public:
 
 	OXT_FORCE_INLINE
 	unsigned int getStores() const {
-		return fetches;
+		return stores;
 	}
 
 	OXT_FORCE_INLINE
@@ -459,10 +900,52 @@ public:
 		return storeSuccesses / (double) stores;
 	}
 
+	/** The number of cacheable responses that were not stored because of
+	 * the admission policy.
+	 */
+	OXT_FORCE_INLINE
+	unsigned int getRejections() const {
+		return rejections;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEvictions() const {
+		return evictions;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEntryCount() const {
+		return population;
+	}
+
+	/** The number of bytes occupied by cached responses. */
+	OXT_FORCE_INLINE
+	size_t getMemoryUsage() const {
+		return memoryUsage;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMaxBodySize() const {
+		return maxBodySize;
+	}
+
 	// For decreasing the store success ratio without calling store().
 	OXT_FORCE_INLINE
-	void incStores() {
+	void incStores(const Request *req) {
 		stores++;
+		keyStatistics.recordStore(req->cacheKey.hash(), false);
+	}
+
+	/**
+	 * Approximate fetch and store statistics per cache key, for
+	 * deciding which keys are not worth caching.
+	 */
+	const ResponseCacheKeyStatistics &getKeyStatistics() const {
+		return keyStatistics;
+	}
+
+	void decayKeyStatistics() {
+		keyStatistics.decay();
 	}
 
 	void resetStatistics() {
@@ -470,11 +953,17 @@ public:
 		hits = 0;
 		stores = 0;
 		storeSuccesses = 0;
+		rejections = 0;
+		evictions = 0;
 	}
 
+	/**
+	 * Removes all entries. Request frequencies, as tracked by the
+	 * admission policy, are remembered.
+	 */
 	void clear() {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			headers[i].valid = false;
+		while (lruHead != -1) {
+			erase(lruHead);
 		}
 	}
 
@@ -500,7 +989,7 @@ public:
 				req->config->defaultVaryTurbocacheByCookie.size());
 		}
 		if (varyCookieName != NULL) {
-			LString *cookieHeader = req->headers.lookup(COOKIE);
+			LString *cookieHeader = req->headers.lookup(ServerKit::KNOWN_HEADER_COOKIE);
 			if (cookieHeader != NULL) {
 				req->varyCookie = ServerKit::findCookie(req->pool, cookieHeader, varyCookieName);
 			}
@@ -514,12 +1003,12 @@ public:
 			return false;
 		}
 
-		req->cacheControl = req->headers.lookup(CACHE_CONTROL);
+		req->cacheControl = req->headers.lookup(ServerKit::KNOWN_HEADER_CACHE_CONTROL);
 		if (req->cacheControl == NULL) {
 			// hasPragmaHeader is only used by requestAllowsFetching(),
 			// so if there is no Cache-Control header then it's not
 			// necessary to check for the Pragma header.
-			req->hasPragmaHeader = req->headers.lookup(PRAGMA_CONST) != NULL;
+			req->hasPragmaHeader = req->headers.lookup(ServerKit::KNOWN_HEADER_PRAGMA) != NULL;
 		}
 
 		char *key = (char *) psg_pnalloc(req->pool, size);
@@ -537,6 +1026,39 @@ public:
 			&& !req->hasPragmaHeader;
 	}
 
+	/**
+	 * Looks up an entry that fetch() reported as not fresh, but that may
+	 * still be served for the given reason. A fresh entry is returned too.
+	 * Does not update the statistics.
+	 *
+	 * @pre requestAllowsFetching()
+	 */
+	Entry fetchStale(Request *req, ev_tstamp now, StaleUse use) {
+		Entry entry;
+		if (sharedCache != NULL) {
+			const SharedResponseCache::Record *record = sharedCache->lookup(
+				req->cacheKey, req->cacheKey.hash());
+			if (record != NULL) {
+				entry = wrapSharedRecord(record);
+			}
+		} else {
+			entry = lookup(req->cacheKey);
+		}
+
+		if (!entry.valid() || isFresh(entry, now)) {
+			return entry;
+		}
+
+		time_t staleUntil = (use == STALE_WHILE_REVALIDATE)
+			? entry.body->staleWhileRevalidateUntil
+			: entry.body->staleIfErrorUntil;
+		if (staleUntil > now) {
+			return entry;
+		} else {
+			return Entry();
+		}
+	}
+
 	// @pre requestAllowsFetching()
 	Entry fetch(Request *req, ev_tstamp now) {
 		fetches++;
@@ -546,24 +1068,14 @@ public:
 			hits = 0;
 		}
 
-		Entry entry(lookup(req->cacheKey));
-		if (entry.valid()) {
-			hits++;
-			if (isFresh(entry, now)) {
-				return entry;
-			} else {
-				erase(entry.index);
-				Entry result;
-				result.cacheMissReason = Entry::NOT_FRESH;
-				return result;
-			}
-		} else {
-			entry.cacheMissReason = Entry::NOT_FOUND;
-			return entry;
-		}
+		sketch.increment(req->cacheKey.hash());
+		Entry entry(fetchEntry(req, now));
+		keyStatistics.recordFetch(req->cacheKey.hash(), entry.valid());
+		return entry;
 	}
 
 
+
 	// @pre prepareRequest() returned true
 	OXT_FORCE_INLINE
 	bool requestAllowsStoring(Request *req) const {
@@ -578,7 +1090,7 @@ public:
 
 		ServerKit::HeaderTable &respHeaders = req->appResponse.headers;
 
-		req->appResponse.cacheControl = respHeaders.lookup(CACHE_CONTROL);
+		req->appResponse.cacheControl = respHeaders.lookup(ServerKit::KNOWN_HEADER_CACHE_CONTROL);
 		if (req->appResponse.cacheControl != NULL && req->appResponse.cacheControl->size > 0) {
 			req->appResponse.cacheControl = psg_lstr_make_contiguous(
 				req->appResponse.cacheControl,
@@ -594,22 +1106,22 @@ public:
 			}
 		}
 
-		if (req->headers.lookup(AUTHORIZATION) != NULL
-		 || respHeaders.lookup(VARY) != NULL
-		 || respHeaders.lookup(WWW_AUTHENTICATE) != NULL
-		 || respHeaders.lookup(X_SENDFILE) != NULL
-		 || respHeaders.lookup(X_ACCEL_REDIRECT) != NULL)
+		if (req->headers.lookup(ServerKit::KNOWN_HEADER_AUTHORIZATION) != NULL
+		 || respHeaders.lookup(ServerKit::KNOWN_HEADER_VARY) != NULL
+		 || respHeaders.lookup(ServerKit::KNOWN_HEADER_WWW_AUTHENTICATE) != NULL
+		 || respHeaders.lookup(ServerKit::KNOWN_HEADER_X_SENDFILE) != NULL
+		 || respHeaders.lookup(ServerKit::KNOWN_HEADER_X_ACCEL_REDIRECT) != NULL)
 		{
 			return false;
 		}
 
-		req->appResponse.expiresHeader = respHeaders.lookup(EXPIRES);
+		req->appResponse.expiresHeader = respHeaders.lookup(ServerKit::KNOWN_HEADER_EXPIRES);
 		if (req->appResponse.expiresHeader == NULL) {
 			// lastModifiedHeader is only used in determineExpiryDate(),
 			// and only if expiresHeader is not present, and Cache-Control
 			// does not contain max-age.
 			req->appResponse.lastModifiedHeader =
-				respHeaders.lookup(LAST_MODIFIED);
+				respHeaders.lookup(ServerKit::KNOWN_HEADER_LAST_MODIFIED);
 			if (req->appResponse.lastModifiedHeader != NULL) {
 				req->appResponse.lastModifiedHeader =
 					psg_lstr_make_contiguous(req->appResponse.lastModifiedHeader,
@@ -627,38 +1139,27 @@ public:
 
 	// @pre requestAllowsStoring()
 	// @pre prepareRequestForStoring()
+	// @pre initialize() has been called
+	// @post If the result is valid, then the caller must fill
+	//       getHttpHeaderData() and getHttpBodyData().
 	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
-		stores++;
-
-		if (headerSize > MAX_HEADER_SIZE || bodySize > MAX_BODY_SIZE) {
-			return Entry();
-		}
-
-		time_t responseDate = parseDate(req->pool, req->appResponse.date, now);
-		if (responseDate == (time_t) -1) {
-			return Entry();
-		}
-
-		time_t expiryDate = determineExpiryDate(req, responseDate, now);
-		if (expiryDate == (time_t) -1) {
-			return Entry();
-		}
+		Entry entry(storeEntry(req, now, headerSize, bodySize));
+		keyStatistics.recordStore(req->cacheKey.hash(), entry.valid());
+		return entry;
+	}
 
-		const HashedStaticString &cacheKey = req->cacheKey;
-		Entry entry(lookup(cacheKey));
-		if (!entry.valid()) {
-			entry = lookupInvalidOrOldest();
-			entry.header->valid   = true;
-			entry.header->hash    = cacheKey.hash();
-			entry.header->keySize = cacheKey.size();
-			memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
+	/**
+	 * Must be called after the caller has filled in the HTTP header and
+	 * body of an entry returned by `store()`. Only in shared mode does
+	 * this actually do something: it publishes the entry to the other
+	 * threads.
+	 */
+	void commit(const Entry &entry) {
+		if (pendingRecord != NULL && entry.body == &sharedBody) {
+			sharedCache->insert(pendingRecord);
+			pendingRecord = NULL;
+			sharedBody.data = MemoryKit::mbuf();
 		}
-		entry.header->date     = responseDate;
-		entry.body->expiryDate = expiryDate;
-		entry.body->httpHeaderSize = headerSize;
-		entry.body->httpBodySize   = bodySize;
-		storeSuccesses++;
-		return entry;
 	}
 
 
@@ -670,25 +1171,27 @@ public:
 
 	// @pre requestAllowsInvalidating()
 	void invalidate(Request *req) {
-		Entry entry(lookup(req->cacheKey));
-		if (entry.valid()) {
-			entry.header->valid = false;
-		}
+		eraseKey(req->cacheKey);
 
-		invalidateLocation(req, LOCATION);
-		invalidateLocation(req, CONTENT_LOCATION);
+		invalidateLocation(req, ServerKit::KNOWN_HEADER_LOCATION);
+		invalidateLocation(req, ServerKit::KNOWN_HEADER_CONTENT_LOCATION);
 	}
 
 
 	string inspect() const {
 		stringstream stream;
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
+		if (sharedCache != NULL) {
+			stream << " shared: " << sharedCache->getEntryCount() << " entries, "
+				<< sharedCache->getMemoryUsage() << " bytes\n";
+			return stream.str();
+		}
+		stream << " " << population << " entries, " << memoryUsage << " bytes\n";
+		for (int i = lruHead; i != -1; i = headers[i].lruNext) {
 			time_t expiryDate = bodies[i].expiryDate;
-			stream << " #" << i << ": valid=" << headers[i].valid
-				<< ", hash=" << headers[i].hash
+			stream << " #" << i << ": hash=" << headers[i].hash
 				<< ", expiryDate=" << expiryDate
 				<< ", keySize=" << headers[i].keySize << ", key=\""
-				<< cEscapeString(StaticString(bodies[i].key, headers[i].keySize)) << "\"\n";
+				<< cEscapeString(StaticString(bodies[i].getKey(), headers[i].keySize)) << "\"\n";
 		}
 		return stream.str();
 	}
@@ -0,0 +1,181 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_RESPONSE_CACHE_KEY_STATISTICS_H_
+#define _PASSENGER_RESPONSE_CACHE_KEY_STATISTICS_H_
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * Approximate per-key turbocaching statistics (fetches, hits, stores and
+ * store successes) in a fixed amount of memory. This is a count-min sketch:
+ * each key maps to one cell in each of the DEPTH rows, and a key's count is
+ * the smallest of its cells' counts. Counts are therefore never too low, but
+ * may be too high because of collisions with other keys.
+ *
+ * All four counts of a key live in the same cell, so that the ratios
+ * between them are estimated from the same rows. Counters saturate at 65535.
+ * Call decay() periodically so that old behavior fades away.
+ *
+ * Not thread-safe.
+ */
+class ResponseCacheKeyStatistics {
+public:
+	static const unsigned int DEPTH = 4;
+
+	struct Counts {
+		unsigned int fetches;
+		unsigned int hits;
+		unsigned int stores;
+		unsigned int storeSuccesses;
+
+		Counts()
+			: fetches(0),
+			  hits(0),
+			  stores(0),
+			  storeSuccesses(0)
+			{ }
+	};
+
+private:
+	struct Cell {
+		boost::uint16_t fetches;
+		boost::uint16_t hits;
+		boost::uint16_t stores;
+		boost::uint16_t storeSuccesses;
+	};
+
+	typedef boost::uint16_t Cell::*Field;
+
+	vector<Cell> table;
+	unsigned int widthMask;
+
+	static boost::uint32_t spread(boost::uint32_t hash) {
+		hash = (hash ^ (hash >> 16)) * 0x45d9f3b;
+		return hash ^ (hash >> 16);
+	}
+
+	Cell &cellAt(boost::uint32_t hash, unsigned int row) {
+		return table[row * (widthMask + 1) + (rowHash(hash, row) & widthMask)];
+	}
+
+	const Cell &cellAt(boost::uint32_t hash, unsigned int row) const {
+		return table[row * (widthMask + 1) + (rowHash(hash, row) & widthMask)];
+	}
+
+	static boost::uint32_t rowHash(boost::uint32_t hash, unsigned int row) {
+		static const boost::uint32_t SEEDS[DEPTH] = {
+			0x97cb3127u, 0xbe98f273u, 0x2f90404fu, 0x84222325u
+		};
+		boost::uint64_t result = (boost::uint64_t) (hash ^ SEEDS[row]) * 0x9e3779b97f4a7c15ULL;
+		return (boost::uint32_t) (result >> 32);
+	}
+
+	void increment(boost::uint32_t hash, Field field) {
+		hash = spread(hash);
+		for (unsigned int row = 0; row < DEPTH; row++) {
+			boost::uint16_t &counter = cellAt(hash, row).*field;
+			if (counter != 0xffff) {
+				counter++;
+			}
+		}
+	}
+
+public:
+	ResponseCacheKeyStatistics(unsigned int width = 0) {
+		resize(width);
+	}
+
+	/**
+	 * Resizes each row to at least `width` cells, rounded up to a power
+	 * of two. Forgets all statistics.
+	 */
+	void resize(unsigned int width) {
+		unsigned int size = 16;
+		while (size < width) {
+			size *= 2;
+		}
+		Cell empty = { 0, 0, 0, 0 };
+		table.assign(size * DEPTH, empty);
+		widthMask = size - 1;
+	}
+
+	void recordFetch(boost::uint32_t hash, bool hit) {
+		increment(hash, &Cell::fetches);
+		if (hit) {
+			increment(hash, &Cell::hits);
+		}
+	}
+
+	void recordStore(boost::uint32_t hash, bool success) {
+		increment(hash, &Cell::stores);
+		if (success) {
+			increment(hash, &Cell::storeSuccesses);
+		}
+	}
+
+	Counts estimate(boost::uint32_t hash) const {
+		Counts result;
+		hash = spread(hash);
+		result.fetches = result.hits = result.stores = result.storeSuccesses = 0xffff;
+		for (unsigned int row = 0; row < DEPTH; row++) {
+			const Cell &cell = cellAt(hash, row);
+			result.fetches = std::min<unsigned int>(result.fetches, cell.fetches);
+			result.hits = std::min<unsigned int>(result.hits, cell.hits);
+			result.stores = std::min<unsigned int>(result.stores, cell.stores);
+			result.storeSuccesses = std::min<unsigned int>(result.storeSuccesses,
+				cell.storeSuccesses);
+		}
+		return result;
+	}
+
+	/** Halves all counts. */
+	void decay() {
+		vector<Cell>::iterator it, end = table.end();
+		for (it = table.begin(); it != end; it++) {
+			it->fetches >>= 1;
+			it->hits >>= 1;
+			it->stores >>= 1;
+			it->storeSuccesses >>= 1;
+		}
+	}
+
+	void clear() {
+		Cell empty = { 0, 0, 0, 0 };
+		std::fill(table.begin(), table.end(), empty);
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_RESPONSE_CACHE_KEY_STATISTICS_H_ */
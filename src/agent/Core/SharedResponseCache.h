@@ -0,0 +1,520 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARED_RESPONSE_CACHE_H_
+#define _PASSENGER_SHARED_RESPONSE_CACHE_H_
+
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <new>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <StaticString.h>
+#include <Exceptions.h>
+
+namespace Passenger {
+
+
+/**
+ * Storage for turbocached responses that is shared by all Controller threads,
+ * so that a response only has to be fetched from the application once per
+ * freshness period, instead of once per thread.
+ *
+ * The cache is divided into `SHARD_COUNT` shards by key hash. Each shard is
+ * a chained hash table whose bucket array never changes after construction.
+ * Records are immutable once inserted.
+ *
+ * ## Reading
+ *
+ * Lookups do not take any locks. Every reader thread obtains an index through
+ * `registerReader()`, and calls `readerOnline()` when its event loop starts
+ * processing events and `readerOffline()` before it blocks. A record returned
+ * by `lookup()` stays valid until the same reader goes offline or online again.
+ *
+ * ## Writing
+ *
+ * Writers are serialized per shard. A replaced, removed or evicted record is
+ * unlinked immediately, but only freed once every reader that was online at
+ * that moment has passed through `readerOnline()` or `readerOffline()`
+ * (quiescent state based reclamation, a form of RCU).
+ *
+ * Because readers cannot reorder an LRU list without locking, each shard uses
+ * the CLOCK (second chance) eviction policy: readers mark records as
+ * referenced, and the eviction hand skips referenced records once.
+ */
+class SharedResponseCache {
+public:
+	enum {
+		SHARD_BITS = 4,
+		SHARD_COUNT = 1 << SHARD_BITS,
+		CACHE_LINE_SIZE = 64
+	};
+
+	struct Record {
+		// Next record in the same bucket. Written by writers, read by readers.
+		boost::atomic<Record *> next;
+		// Set by readers, cleared by the eviction hand.
+		boost::atomic<bool> referenced;
+
+		// Neighbors in the shard's eviction queue, or in its retired list.
+		// Protected by the shard lock.
+		Record *queuePrev, *queueNext;
+		// The global epoch at the time this record was unlinked.
+		unsigned long long retiredAt;
+
+		boost::uint32_t hash;
+		unsigned short keySize;
+		unsigned int httpHeaderSize;
+		unsigned int httpBodySize;
+		time_t date;
+		time_t expiryDate;
+		time_t staleWhileRevalidateUntil;
+		time_t staleIfErrorUntil;
+		// Followed by the HTTP header, the HTTP body and the key.
+
+		char *getData() const {
+			return (char *) (this + 1);
+		}
+
+		unsigned int getDataSize() const {
+			return httpHeaderSize + httpBodySize + keySize;
+		}
+
+		StaticString getKey() const {
+			return StaticString(getData() + httpHeaderSize + httpBodySize, keySize);
+		}
+
+		size_t getFootprint() const {
+			return sizeof(Record) + getDataSize();
+		}
+
+		time_t getRetentionDate() const {
+			return std::max(expiryDate,
+				std::max(staleWhileRevalidateUntil, staleIfErrorUntil));
+		}
+	};
+
+private:
+	struct Shard {
+		mutable boost::mutex syncher;
+		boost::scoped_array< boost::atomic<Record *> > buckets;
+		unsigned int bucketMask;
+		Record *queueHead, *queueTail;
+		Record *retired;
+		unsigned int population;
+		unsigned int retiredCount;
+		unsigned int evictions;
+		size_t memoryUsage;
+		char padding[CACHE_LINE_SIZE];
+
+		Shard()
+			: bucketMask(0),
+			  queueHead(NULL),
+			  queueTail(NULL),
+			  retired(NULL),
+			  population(0),
+			  retiredCount(0),
+			  evictions(0),
+			  memoryUsage(0)
+			{ }
+	};
+
+	struct Reader {
+		// 0 while the reader is offline, otherwise the global epoch
+		// that it observed when it last went online.
+		boost::atomic<unsigned long long> epoch;
+		char padding[CACHE_LINE_SIZE - sizeof(boost::atomic<unsigned long long>)];
+
+		Reader()
+			: epoch(0)
+			{ }
+	};
+
+	Shard shards[SHARD_COUNT];
+	boost::scoped_array<Reader> readers;
+	unsigned int maxReaders;
+	boost::atomic<unsigned int> readerCount;
+	boost::atomic<unsigned long long> globalEpoch;
+	unsigned int maxEntriesPerShard;
+	size_t maxMemoryPerShard;
+
+	Shard &getShard(boost::uint32_t hash) {
+		return shards[hash >> (32 - SHARD_BITS)];
+	}
+
+	const Shard &getShard(boost::uint32_t hash) const {
+		return shards[hash >> (32 - SHARD_BITS)];
+	}
+
+	static Record *find(const Shard &shard, const StaticString &key, boost::uint32_t hash) {
+		Record *record = shard.buckets[hash & shard.bucketMask].load(
+			boost::memory_order_acquire);
+		while (record != NULL) {
+			if (record->hash == hash && record->getKey() == key) {
+				return record;
+			}
+			record = record->next.load(boost::memory_order_acquire);
+		}
+		return NULL;
+	}
+
+	static void queuePushBack(Shard &shard, Record *record) {
+		record->queuePrev = shard.queueTail;
+		record->queueNext = NULL;
+		if (shard.queueTail == NULL) {
+			shard.queueHead = record;
+		} else {
+			shard.queueTail->queueNext = record;
+		}
+		shard.queueTail = record;
+	}
+
+	static void queueUnlink(Shard &shard, Record *record) {
+		if (record->queuePrev == NULL) {
+			shard.queueHead = record->queueNext;
+		} else {
+			record->queuePrev->queueNext = record->queueNext;
+		}
+		if (record->queueNext == NULL) {
+			shard.queueTail = record->queuePrev;
+		} else {
+			record->queueNext->queuePrev = record->queuePrev;
+		}
+	}
+
+	// Removes the record from the bucket chain and from the eviction
+	// queue, and puts it on the retired list.
+	void unlink(Shard &shard, Record *record) {
+		boost::atomic<Record *> *link = &shard.buckets[record->hash & shard.bucketMask];
+		while (link->load(boost::memory_order_relaxed) != record) {
+			link = &link->load(boost::memory_order_relaxed)->next;
+		}
+		link->store(record->next.load(boost::memory_order_relaxed),
+			boost::memory_order_release);
+		queueUnlink(shard, record);
+		shard.population--;
+		shard.memoryUsage -= record->getFootprint();
+
+		record->retiredAt = globalEpoch.fetch_add(1, boost::memory_order_seq_cst);
+		record->queuePrev = NULL;
+		record->queueNext = shard.retired;
+		shard.retired = record;
+		shard.retiredCount++;
+	}
+
+	unsigned long long getOldestReaderEpoch() const {
+		unsigned long long result = ULLONG_MAX;
+		unsigned int count = std::min(readerCount.load(boost::memory_order_acquire),
+			maxReaders);
+		for (unsigned int i = 0; i < count; i++) {
+			unsigned long long epoch = readers[i].epoch.load(boost::memory_order_seq_cst);
+			if (epoch != 0 && epoch < result) {
+				result = epoch;
+			}
+		}
+		return result;
+	}
+
+	// Frees all retired records that no reader can still be accessing.
+	void reclaim(Shard &shard) {
+		if (shard.retired == NULL) {
+			return;
+		}
+
+		unsigned long long oldestEpoch = getOldestReaderEpoch();
+		Record **link = &shard.retired;
+		while (*link != NULL) {
+			Record *record = *link;
+			if (record->retiredAt < oldestEpoch) {
+				*link = record->queueNext;
+				destroyRecord(record);
+				shard.retiredCount--;
+			} else {
+				link = &record->queueNext;
+			}
+		}
+	}
+
+	bool hasRoomFor(const Shard &shard, size_t footprint) const {
+		return shard.population < maxEntriesPerShard
+			&& shard.memoryUsage + footprint <= maxMemoryPerShard;
+	}
+
+	void evictUntilRoomFor(Shard &shard, size_t footprint) {
+		while (shard.queueHead != NULL && !hasRoomFor(shard, footprint)) {
+			Record *record = shard.queueHead;
+			if (record->referenced.load(boost::memory_order_relaxed)) {
+				record->referenced.store(false, boost::memory_order_relaxed);
+				queueUnlink(shard, record);
+				queuePushBack(shard, record);
+			} else {
+				unlink(shard, record);
+				shard.evictions++;
+			}
+		}
+	}
+
+public:
+	/**
+	 * @param maxReaders The maximum number of threads that will call `registerReader()`.
+	 * @param maxEntries The maximum number of records in the entire cache.
+	 * @param maxMemory The maximum number of bytes occupied by records in the entire cache.
+	 */
+	SharedResponseCache(unsigned int maxReaders, unsigned int maxEntries, size_t maxMemory)
+		: readers(new Reader[maxReaders]),
+		  maxReaders(maxReaders),
+		  readerCount(0),
+		  globalEpoch(1),
+		  maxEntriesPerShard(std::max(maxEntries / SHARD_COUNT, 1u)),
+		  maxMemoryPerShard(maxMemory / SHARD_COUNT)
+	{
+		unsigned int nbuckets = 16;
+		while (nbuckets < maxEntriesPerShard * 2) {
+			nbuckets *= 2;
+		}
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			shards[i].buckets.reset(new boost::atomic<Record *>[nbuckets]);
+			shards[i].bucketMask = nbuckets - 1;
+			for (unsigned int j = 0; j < nbuckets; j++) {
+				shards[i].buckets[j].store(NULL, boost::memory_order_relaxed);
+			}
+		}
+	}
+
+	~SharedResponseCache() {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			Shard &shard = shards[i];
+			Record *record = shard.queueHead;
+			while (record != NULL) {
+				Record *next = record->queueNext;
+				destroyRecord(record);
+				record = next;
+			}
+			record = shard.retired;
+			while (record != NULL) {
+				Record *next = record->queueNext;
+				destroyRecord(record);
+				record = next;
+			}
+		}
+	}
+
+	/**
+	 * Allocates a record that is not yet part of the cache. The caller
+	 * fills in the HTTP header and body, then passes it to `insert()`.
+	 * Returns NULL if the record would never fit in the cache.
+	 */
+	Record *createRecord(const StaticString &key, boost::uint32_t hash,
+		time_t date, time_t expiryDate,
+		unsigned int httpHeaderSize, unsigned int httpBodySize) const
+	{
+		size_t dataSize = httpHeaderSize + httpBodySize + key.size();
+		if (sizeof(Record) + dataSize > maxMemoryPerShard) {
+			return NULL;
+		}
+
+		void *memory = malloc(sizeof(Record) + dataSize);
+		if (memory == NULL) {
+			return NULL;
+		}
+
+		Record *record = new (memory) Record();
+		record->next.store(NULL, boost::memory_order_relaxed);
+		record->referenced.store(false, boost::memory_order_relaxed);
+		record->queuePrev = NULL;
+		record->queueNext = NULL;
+		record->retiredAt = 0;
+		record->hash = hash;
+		record->keySize = key.size();
+		record->httpHeaderSize = httpHeaderSize;
+		record->httpBodySize = httpBodySize;
+		record->date = date;
+		record->expiryDate = expiryDate;
+		record->staleWhileRevalidateUntil = 0;
+		record->staleIfErrorUntil = 0;
+		memcpy(record->getData() + httpHeaderSize + httpBodySize,
+			key.data(), key.size());
+		return record;
+	}
+
+	static void destroyRecord(Record *record) {
+		record->~Record();
+		free(record);
+	}
+
+	/**
+	 * Adds a record created by `createRecord()` to the cache, replacing
+	 * any existing record with the same key. Takes over ownership of
+	 * the record.
+	 */
+	void insert(Record *record) {
+		Shard &shard = getShard(record->hash);
+		boost::lock_guard<boost::mutex> l(shard.syncher);
+
+		Record *old = find(shard, record->getKey(), record->hash);
+		if (old != NULL) {
+			unlink(shard, old);
+		}
+		evictUntilRoomFor(shard, record->getFootprint());
+
+		boost::atomic<Record *> &bucket = shard.buckets[record->hash & shard.bucketMask];
+		record->next.store(bucket.load(boost::memory_order_relaxed),
+			boost::memory_order_relaxed);
+		bucket.store(record, boost::memory_order_release);
+		queuePushBack(shard, record);
+		shard.population++;
+		shard.memoryUsage += record->getFootprint();
+
+		reclaim(shard);
+	}
+
+	/**
+	 * Looks up the record with the given key. Lock-free.
+	 *
+	 * @pre The calling reader is online.
+	 */
+	const Record *lookup(const StaticString &key, boost::uint32_t hash) const {
+		Record *record = find(getShard(hash), key, hash);
+		if (record != NULL && !record->referenced.load(boost::memory_order_relaxed)) {
+			record->referenced.store(true, boost::memory_order_relaxed);
+		}
+		return record;
+	}
+
+	void remove(const StaticString &key, boost::uint32_t hash) {
+		Shard &shard = getShard(hash);
+		boost::lock_guard<boost::mutex> l(shard.syncher);
+		Record *record = find(shard, key, hash);
+		if (record != NULL) {
+			unlink(shard, record);
+		}
+		reclaim(shard);
+	}
+
+	/**
+	 * Removes the record with the given key, but only if it has expired
+	 * and may not be served stale anymore.
+	 * A fresh record that another thread stored in the mean time is
+	 * left alone.
+	 */
+	void removeExpired(const StaticString &key, boost::uint32_t hash, time_t now) {
+		Shard &shard = getShard(hash);
+		boost::lock_guard<boost::mutex> l(shard.syncher);
+		Record *record = find(shard, key, hash);
+		if (record != NULL && record->getRetentionDate() <= now) {
+			unlink(shard, record);
+		}
+		reclaim(shard);
+	}
+
+	/**
+	 * Frees retired records in all shards that are no longer in use.
+	 * Writers already do this for their own shard, so this only needs
+	 * to be called occasionally.
+	 */
+	void reclaim() {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			boost::lock_guard<boost::mutex> l(shards[i].syncher);
+			reclaim(shards[i]);
+		}
+	}
+
+
+	/****** Reader management ******/
+
+	unsigned int registerReader() {
+		unsigned int index = readerCount.fetch_add(1, boost::memory_order_acq_rel);
+		if (index >= maxReaders) {
+			throw RuntimeException("Too many shared turbocache readers");
+		}
+		return index;
+	}
+
+	void readerOnline(unsigned int reader) {
+		readers[reader].epoch.store(globalEpoch.load(boost::memory_order_seq_cst),
+			boost::memory_order_seq_cst);
+		// Lookups by this reader must not be reordered before the store above,
+		// otherwise a writer could free a record that it is about to find.
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	}
+
+	void readerOffline(unsigned int reader) {
+		readers[reader].epoch.store(0, boost::memory_order_release);
+	}
+
+
+	/****** Statistics ******/
+
+	unsigned int getEntryCount() const {
+		unsigned int result = 0;
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			boost::lock_guard<boost::mutex> l(shards[i].syncher);
+			result += shards[i].population;
+		}
+		return result;
+	}
+
+	size_t getMemoryUsage() const {
+		size_t result = 0;
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			boost::lock_guard<boost::mutex> l(shards[i].syncher);
+			result += shards[i].memoryUsage;
+		}
+		return result;
+	}
+
+	unsigned int getEvictions() const {
+		unsigned int result = 0;
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			boost::lock_guard<boost::mutex> l(shards[i].syncher);
+			result += shards[i].evictions;
+		}
+		return result;
+	}
+
+	/** The number of unlinked records that are waiting to be freed. */
+	unsigned int getRetiredCount() const {
+		unsigned int result = 0;
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			boost::lock_guard<boost::mutex> l(shards[i].syncher);
+			result += shards[i].retiredCount;
+		}
+		return result;
+	}
+};
+
+typedef boost::shared_ptr<SharedResponseCache> SharedResponseCachePtr;
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARED_RESPONSE_CACHE_H_ */
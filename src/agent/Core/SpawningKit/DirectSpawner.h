@@ -30,8 +30,7 @@
 #include <Constants.h>
 #include <LoggingKit/LoggingKit.h>
 #include <LveLoggingDecorator.h>
-#include <limits.h>  // for PTHREAD_STACK_MIN
-#include <pthread.h>
+#include <ProcessManagement/ChildReaper.h>
 
 #include <adhoc_lve.h>
 
@@ -45,71 +44,10 @@ using namespace oxt;
 
 class DirectSpawner: public Spawner {
 private:
-	static int startBackgroundThread(void *(*mainFunction)(void *), void *arg) {
-		// Using raw pthread API because we don't want to register such
-		// trivial threads on the oxt::thread list.
-		pthread_t thr;
-		pthread_attr_t attr;
-		size_t stack_size = 96 * 1024;
-
-		unsigned long min_stack_size;
-		bool stack_min_size_defined;
-		bool round_stack_size;
-		int ret;
-
-		#ifdef PTHREAD_STACK_MIN
-			// PTHREAD_STACK_MIN may not be a constant macro so we need
-			// to evaluate it dynamically.
-			min_stack_size = PTHREAD_STACK_MIN;
-			stack_min_size_defined = true;
-		#else
-			// Assume minimum stack size is 128 KB.
-			min_stack_size = 128 * 1024;
-			stack_min_size_defined = false;
-		#endif
-		if (stack_size != 0 && stack_size < min_stack_size) {
-			stack_size = min_stack_size;
-			round_stack_size = !stack_min_size_defined;
-		} else {
-			round_stack_size = true;
-		}
-
-		if (round_stack_size) {
-			// Round stack size up to page boundary.
-			long page_size;
-			#if defined(_SC_PAGESIZE)
-				page_size = sysconf(_SC_PAGESIZE);
-			#elif defined(_SC_PAGE_SIZE)
-				page_size = sysconf(_SC_PAGE_SIZE);
-			#elif defined(PAGESIZE)
-				page_size = sysconf(PAGESIZE);
-			#elif defined(PAGE_SIZE)
-				page_size = sysconf(PAGE_SIZE);
-			#else
-				page_size = getpagesize();
-			#endif
-			if (stack_size % page_size != 0) {
-				stack_size = stack_size - (stack_size % page_size) + page_size;
-			}
-		}
-
-		pthread_attr_init(&attr);
-		pthread_attr_setdetachstate(&attr, 1);
-		pthread_attr_setstacksize(&attr, stack_size);
-		ret = pthread_create(&thr, &attr, mainFunction, arg);
-		pthread_attr_destroy(&attr);
-		return ret;
-	}
-
-	static void *detachProcessMain(void *arg) {
-		boost::this_thread::disable_syscall_interruption dsi;
-		pid_t pid = (pid_t) (long) arg;
-		syscalls::waitpid(pid, NULL, 0);
-		return NULL;
-	}
-
 	void detachProcess(pid_t pid) {
-		startBackgroundThread(detachProcessMain, (void *) (long) pid);
+		// Reaped by the central reaper thread once it exits, so that
+		// we don't need a thread per process that blocks in waitpid().
+		ChildReaper::getInstance().reap(pid);
 	}
 
 	vector<string> createCommand(const Options &options, const SpawnPreparationInfo &preparation,
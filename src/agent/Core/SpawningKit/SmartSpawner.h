@@ -70,9 +70,11 @@ private:
 	map<string, string> preloaderAnnotations;
 	Options options;
 
-	// Protects m_lastUsed and pid.
+	// Protects m_lastUsed, pid and preloaderAnnotations.
 	mutable boost::mutex simpleFieldSyncher;
-	// Protects everything else.
+	// Protects everything else. Only held while (re)starting the preloader
+	// and while asking it to fork, not while the forked process is being
+	// negotiated with, so that multiple processes can be spawned concurrently.
 	mutable boost::mutex syncher;
 
 	// Preloader information.
@@ -319,7 +321,10 @@ private:
 			watcher->initialize();
 			watcher->start();
 
-			preloaderAnnotations = debugDir->readAll();
+			{
+				boost::lock_guard<boost::mutex> l(simpleFieldSyncher);
+				preloaderAnnotations = debugDir->readAll();
+			}
 			P_INFO("Preloader for " << options.appRoot <<
 				" started on PID " << pid <<
 				", listening on " << socketAddress);
@@ -759,6 +764,7 @@ private:
 protected:
 	virtual void annotateAppSpawnException(SpawnException &e, NegotiationDetails &details) {
 		Spawner::annotateAppSpawnException(e, details);
+		boost::lock_guard<boost::mutex> l(simpleFieldSyncher);
 		e.addAnnotations(preloaderAnnotations);
 	}
 
@@ -796,14 +802,24 @@ public:
 			m_lastUsed = SystemTime::getUsec();
 		}
 		UPDATE_TRACE_POINT();
-		boost::lock_guard<boost::mutex> l(syncher);
-		if (!preloaderStarted()) {
+		// The preparation info may be replaced by a concurrent preloader
+		// restart, so we negotiate against our own copy.
+		SpawnPreparationInfo preparation;
+		NegotiationDetails details;
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			if (!preloaderStarted()) {
+				UPDATE_TRACE_POINT();
+				startPreloader();
+			}
+
 			UPDATE_TRACE_POINT();
-			startPreloader();
+			details = sendSpawnCommandAndGetNegotiationDetails(options);
+			preparation = this->preparation;
 		}
 
 		UPDATE_TRACE_POINT();
-		NegotiationDetails details = sendSpawnCommandAndGetNegotiationDetails(options);
+		details.preparation = &preparation;
 		Result result = negotiateSpawn(details);
 		P_DEBUG("Process spawning done: appRoot=" << options.appRoot <<
 			", pid=" << result["pid"].asInt());
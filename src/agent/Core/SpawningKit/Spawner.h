@@ -90,6 +90,7 @@
 #include <Utils/IOUtils.h>
 #include <Utils/StrIntUtils.h>
 #include <Utils/ProcessMetricsCollector.h>
+#include <ProcessManagement/ChildReaper.h>
 #include <Core/SpawningKit/Config.h>
 #include <Core/SpawningKit/Options.h>
 #include <Core/SpawningKit/Result.h>
@@ -464,18 +465,7 @@ protected:
 	 * <em>timeout</em> miliseconds for the process to exit.
 	 */
 	static int timedWaitpid(pid_t pid, int *status, unsigned long long timeout) {
-		Timer<SystemTime::GRAN_10MSEC> timer;
-		int ret;
-
-		do {
-			ret = syscalls::waitpid(pid, status, WNOHANG);
-			if (ret > 0 || ret == -1) {
-				return ret;
-			} else {
-				syscalls::usleep(10000);
-			}
-		} while (timer.elapsed() < timeout);
-		return 0; // timed out
+		return ChildReaper::timedWaitpid(pid, status, timeout);
 	}
 
 	static string fixupSocketAddress(const Options &options, const string &address) {
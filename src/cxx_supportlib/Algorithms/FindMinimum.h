@@ -0,0 +1,130 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_ALGORITHMS_FIND_MINIMUM_H_
+#define _PASSENGER_ALGORITHMS_FIND_MINIMUM_H_
+
+#include <oxt/macros.hpp>
+#include <climits>
+#include <cassert>
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
+
+namespace Passenger {
+
+
+/**
+ * Plain implementation of findFirstMinimumIndex(). Also used as a fallback
+ * on platforms without SSE2, and for arrays too small to be worth vectorizing.
+ */
+inline unsigned int
+findFirstMinimumIndexScalar(const int *values, unsigned int size, int lowerBound = INT_MIN) {
+	assert(size > 0);
+	unsigned int result = 0;
+	int lowest = values[0];
+
+	for (unsigned int i = 1; i < size && lowest != lowerBound; i++) {
+		if (values[i] < lowest) {
+			result = i;
+			lowest = values[i];
+		}
+	}
+	return result;
+}
+
+/**
+ * Returns the index of the smallest value in the given array. If there are
+ * multiple smallest values then the index of the first one is returned.
+ * `size` must be at least 1.
+ *
+ * If all values are known to be at least `lowerBound`, then pass it: the scan
+ * stops as soon as a value equal to `lowerBound` is found, because nothing can
+ * be smaller than that.
+ *
+ * On x86 this uses SSE2 to examine 4 values at a time: a first pass computes
+ * the minimum value, a second pass looks for its first occurrence.
+ */
+inline unsigned int
+findFirstMinimumIndex(const int *values, unsigned int size, int lowerBound = INT_MIN) {
+	#ifdef __SSE2__
+		if (size < 8) {
+			return findFirstMinimumIndexScalar(values, size, lowerBound);
+		}
+
+		const __m128i bound = _mm_set1_epi32(lowerBound);
+		__m128i lowest = _mm_loadu_si128((const __m128i *) values);
+		unsigned int i;
+
+		// Pass 1: compute the minimum, or the position of the first value
+		// that equals the lower bound. SSE2 has no signed 32-bit min
+		// instruction, so we emulate it with a compare and a select.
+		for (i = 0; i + 4 <= size; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i *) (values + i));
+			int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(v, bound));
+			if (OXT_UNLIKELY(mask != 0)) {
+				return i + __builtin_ctz(mask) / 4;
+			}
+			__m128i smaller = _mm_cmpgt_epi32(lowest, v);
+			lowest = _mm_or_si128(_mm_and_si128(smaller, v),
+				_mm_andnot_si128(smaller, lowest));
+		}
+
+		int lanes[4];
+		_mm_storeu_si128((__m128i *) lanes, lowest);
+		int minimum = lanes[0];
+		for (unsigned int j = 1; j < 4; j++) {
+			if (lanes[j] < minimum) {
+				minimum = lanes[j];
+			}
+		}
+		for (unsigned int j = i; j < size; j++) {
+			if (values[j] < minimum) {
+				minimum = values[j];
+			}
+		}
+
+		// Pass 2: find the first occurrence of the minimum.
+		const __m128i needle = _mm_set1_epi32(minimum);
+		for (i = 0; i + 4 <= size; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i *) (values + i));
+			int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(v, needle));
+			if (mask != 0) {
+				return i + __builtin_ctz(mask) / 4;
+			}
+		}
+		while (values[i] != minimum) {
+			i++;
+		}
+		return i;
+	#else
+		return findFirstMinimumIndexScalar(values, size, lowerBound);
+	#endif
+}
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_ALGORITHMS_FIND_MINIMUM_H_ */
@@ -218,6 +218,80 @@ expMovingAverage(double prevAverage, double currentValue, double alpha, double n
 }
 
 
+/**
+ * Implements double exponential smoothing (Holt's linear trend method). Next to an
+ * exponential moving average of the data (the level), it keeps track of an
+ * exponential moving average of the change between successive levels (the trend),
+ * which allows forecasting the data a number of samples ahead.
+ *
+ * Like expMovingAverage(), this algorithm is not timing sensitive: it assumes
+ * that values are collected at regular intervals.
+ *
+ * `alpha` and `beta` are the smoothing factors of the level and the trend,
+ * respectively. Their range is [0, 1000]. Higher values cause the current value
+ * to have more weight, lower values have the opposite effect.
+ */
+template<unsigned int alpha, unsigned int beta>
+class ExpMovingAverageWithTrend {
+private:
+	double m_level, m_trend;
+	unsigned int count;
+
+	static BOOST_CONSTEXPR double floatingAlpha() {
+		return alpha / 1000.0;
+	}
+
+	static BOOST_CONSTEXPR double floatingBeta() {
+		return beta / 1000.0;
+	}
+
+public:
+	ExpMovingAverageWithTrend()
+		: m_level(0),
+		  m_trend(0),
+		  count(0)
+		{ }
+
+	void update(double value) {
+		if (OXT_UNLIKELY(count == 0)) {
+			m_level = value;
+			count++;
+		} else if (OXT_UNLIKELY(count == 1)) {
+			// Initialize the trend from the first two values
+			// so that it doesn't start out biased towards 0.
+			m_trend = value - m_level;
+			m_level = value;
+			count++;
+		} else {
+			double prevLevel = m_level;
+			m_level = floatingAlpha() * value
+				+ (1 - floatingAlpha()) * (m_level + m_trend);
+			m_trend = floatingBeta() * (m_level - prevLevel)
+				+ (1 - floatingBeta()) * m_trend;
+		}
+	}
+
+	bool available() const {
+		return count > 0;
+	}
+
+	double level() const {
+		return m_level;
+	}
+
+	double trend() const {
+		return m_trend;
+	}
+
+	/**
+	 * Forecasts the value `steps` samples ahead.
+	 */
+	double forecast(double steps) const {
+		return m_level + steps * m_trend;
+	}
+};
+
+
 } // namespace Passenger
 
 #endif /* _PASSENGER_ALGORITHMS_EXP_MOVING_AVERAGE_H_ */
@@ -44,11 +44,13 @@
 #define DEFAULT_ANALYTICS_LOG_GROUP ""
 #define DEFAULT_ANALYTICS_LOG_PERMISSIONS "u=rwx,g=rx,o=rx"
 #define DEFAULT_ANALYTICS_LOG_USER "nobody"
+#define DEFAULT_APP_CONNECT_TIMEOUT 10000
 #define DEFAULT_APP_ENV "production"
 #define DEFAULT_APP_OUTPUT_LOG_LEVEL 3
 #define DEFAULT_APP_OUTPUT_LOG_LEVEL_NAME "notice"
 #define DEFAULT_APP_THREAD_COUNT 1
 #define DEFAULT_CONCURRENCY_MODEL "process"
+#define DEFAULT_FILE_BUFFERED_CHANNEL_MIN_THRESHOLD 16384
 #define DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD 131072
 #define DEFAULT_HTTP_SERVER_LISTEN_ADDRESS "tcp://127.0.0.1:3000"
 #define DEFAULT_INTEGRATION_MODE "standalone"
@@ -65,10 +67,14 @@
 #define DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK 134217728
 #define DEFAULT_RUBY "ruby"
 #define DEFAULT_SOCKET_BACKLOG 2048
+#define DEFAULT_SPAWN_CONCURRENCY 1
 #define DEFAULT_SPAWN_METHOD "smart"
 #define DEFAULT_START_TIMEOUT 90000
 #define DEFAULT_STAT_THROTTLE_RATE 10
 #define DEFAULT_STICKY_SESSIONS_COOKIE_NAME "_passenger_route"
+#define DEFAULT_TURBOCACHE_MAX_BODY_SIZE 524288
+#define DEFAULT_TURBOCACHE_MAX_ENTRIES 1024
+#define DEFAULT_TURBOCACHE_MAX_MEMORY 16777216
 #define DEFAULT_UNION_STATION_GATEWAY_ADDRESS "gateway.unionstationapp.com"
 #define DEFAULT_UNION_STATION_GATEWAY_PORT 443
 #define DEFAULT_WEB_APP_USER "nobody"
@@ -98,6 +104,7 @@
 #define SERVER_TOKEN_NAME "Phusion_Passenger"
 #define SHORT_PROGRAM_NAME "Passenger"
 #define SUPPORT_URL "https://www.phusionpassenger.com/support"
+#define TURBOCACHE_MAX_ENTRIES_LIMIT 1048576
 #define USER_NAMESPACE_DIRNAME ".passenger"
 
 #endif /* _PASSENGER_CONSTANTS_H_ */
@@ -0,0 +1,150 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_DATA_STRUCTURES_FREQUENCY_SKETCH_H_
+#define _PASSENGER_DATA_STRUCTURES_FREQUENCY_SKETCH_H_
+
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * An approximate frequency counter for a large number of keys in a fixed
+ * amount of memory: a count-min sketch with 4-bit counters and periodic aging,
+ * as used by the TinyLFU cache admission policy
+ * (https://arxiv.org/abs/1512.00727).
+ *
+ * Keys are identified by a 32-bit hash. Each key maps to 4 counters. The
+ * estimated frequency is the smallest of them, so estimates are never too low
+ * but may be too high because of collisions. Counters saturate at 15. After
+ * `10 * capacity` increments all counters are halved so that keys that used to
+ * be popular, but no longer are, fade away.
+ *
+ * Not thread-safe.
+ */
+class FrequencySketch {
+public:
+	static const unsigned int MAX_FREQUENCY = 15;
+
+private:
+	// Each word holds 16 counters of 4 bits.
+	vector<boost::uint64_t> table;
+	unsigned int tableMask;
+	unsigned int sampleSize;
+	unsigned int additions;
+
+	static boost::uint32_t spread(boost::uint32_t hash) {
+		hash = (hash ^ (hash >> 16)) * 0x45d9f3b;
+		return hash ^ (hash >> 16);
+	}
+
+	unsigned int indexOf(boost::uint32_t hash, unsigned int i) const {
+		static const boost::uint64_t SEEDS[4] = {
+			0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+			0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+		};
+		boost::uint64_t result = (hash + SEEDS[i]) * SEEDS[i];
+		result += result >> 32;
+		return (unsigned int) result & tableMask;
+	}
+
+	bool incrementAt(unsigned int index, unsigned int counter) {
+		unsigned int offset = counter << 2;
+		boost::uint64_t mask = (boost::uint64_t) 0xf << offset;
+		if ((table[index] & mask) != mask) {
+			table[index] += (boost::uint64_t) 1 << offset;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	void age() {
+		for (unsigned int i = 0; i < table.size(); i++) {
+			table[i] = (table[i] >> 1) & 0x7777777777777777ULL;
+		}
+		additions /= 2;
+	}
+
+public:
+	FrequencySketch(unsigned int capacity = 0) {
+		resize(capacity);
+	}
+
+	/**
+	 * Resizes the sketch for tracking approximately `capacity` keys. Forgets
+	 * all frequencies.
+	 */
+	void resize(unsigned int capacity) {
+		unsigned int size = 8;
+		while (size < capacity) {
+			size *= 2;
+		}
+		table.assign(size, 0);
+		tableMask = size - 1;
+		sampleSize = std::max(capacity, 8u) * 10;
+		additions = 0;
+	}
+
+	void clear() {
+		std::fill(table.begin(), table.end(), 0);
+		additions = 0;
+	}
+
+	void increment(boost::uint32_t hash) {
+		hash = spread(hash);
+		unsigned int start = (hash & 3) << 2;
+		bool added = false;
+		for (unsigned int i = 0; i < 4; i++) {
+			added |= incrementAt(indexOf(hash, i), start + i);
+		}
+		if (added && ++additions >= sampleSize) {
+			age();
+		}
+	}
+
+	unsigned int estimate(boost::uint32_t hash) const {
+		hash = spread(hash);
+		unsigned int start = (hash & 3) << 2;
+		unsigned int result = MAX_FREQUENCY;
+		for (unsigned int i = 0; i < 4; i++) {
+			unsigned int offset = (start + i) << 2;
+			unsigned int count = (table[indexOf(hash, i)] >> offset) & 0xf;
+			result = std::min(result, count);
+		}
+		return result;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_DATA_STRUCTURES_FREQUENCY_SKETCH_H_ */
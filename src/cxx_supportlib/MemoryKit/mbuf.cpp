@@ -23,6 +23,11 @@
 #include <oxt/backtrace.hpp>
 #include <algorithm>
 #include <ostream>
+#include <sys/mman.h>
+#ifdef __linux__
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
 #include <MemoryKit/mbuf.h>
 #include <LoggingKit/LoggingKit.h>
 #include <StaticString.h>
@@ -119,12 +124,119 @@ _mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset)
 	return mbuf_block;
 }
 
+/*
+ * Prefers allocating the slab region's memory on the given NUMA node. This is
+ * best-effort: if the node has no memory left, the kernel falls back to other
+ * nodes. We invoke the system call directly so that we don't depend on libnuma.
+ */
+static void
+_mbuf_slab_bind(char *start, int numa_node)
+{
+	#if defined(__linux__) && defined(SYS_mbind)
+		const int MPOL_PREFERRED_MODE = 1;
+		const unsigned int BITS_PER_LONG = 8 * sizeof(unsigned long);
+		unsigned long nodemask[4];
+
+		if (numa_node >= (int) (sizeof(nodemask) * 8)) {
+			return;
+		}
+		memset(nodemask, 0, sizeof(nodemask));
+		nodemask[numa_node / BITS_PER_LONG] = 1UL << (numa_node % BITS_PER_LONG);
+		syscall(SYS_mbind, start, (unsigned long) MBUF_SLAB_SIZE,
+			MPOL_PREFERRED_MODE, nodemask, sizeof(nodemask) * 8 + 1, 0);
+	#endif
+}
+
+/*
+ * Maps a new MBUF_SLAB_SIZE-aligned region, carves it into normal
+ * mbuf_blocks and puts those on the freelist.
+ *
+ * The region is aligned so that the kernel can back it with a single
+ * transparent huge page, which saves TLB entries when buffering large
+ * responses. It is prefaulted so that the request path doesn't take
+ * page faults when it first uses the blocks.
+ */
+static bool
+_mbuf_slab_new(struct mbuf_pool *pool)
+{
+	struct mbuf_slab *slab;
+	char *region, *start;
+	size_t i, nblocks;
+
+	slab = (struct mbuf_slab *) malloc(sizeof(struct mbuf_slab));
+	if (OXT_UNLIKELY(slab == NULL)) {
+		return false;
+	}
+
+	region = (char *) mmap(NULL, 2 * MBUF_SLAB_SIZE, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (OXT_UNLIKELY(region == (char *) MAP_FAILED)) {
+		free(slab);
+		return false;
+	}
+	start = (char *) (((uintptr_t) region + MBUF_SLAB_SIZE - 1)
+		& ~((uintptr_t) MBUF_SLAB_SIZE - 1));
+	if (start > region) {
+		munmap(region, start - region);
+	}
+	munmap(start + MBUF_SLAB_SIZE, MBUF_SLAB_SIZE - (start - region));
+
+	#ifdef MADV_HUGEPAGE
+		madvise(start, MBUF_SLAB_SIZE, MADV_HUGEPAGE);
+	#endif
+	if (pool->numa_node >= 0) {
+		_mbuf_slab_bind(start, pool->numa_node);
+	}
+	for (i = 0; i < MBUF_SLAB_SIZE; i += 4096) {
+		((volatile char *) start)[i] = 0;
+	}
+
+	nblocks = MBUF_SLAB_SIZE / pool->mbuf_block_chunk_size;
+	for (i = 0; i < nblocks; i++) {
+		struct mbuf_block *mbuf_block = (struct mbuf_block *)
+			(start + i * pool->mbuf_block_chunk_size + pool->mbuf_block_offset);
+		mbuf_block->magic = MBUF_BLOCK_MAGIC;
+		mbuf_block->pool = pool;
+		mbuf_block->refcount = 0;
+		mbuf_block->offset = 0;
+		STAILQ_INSERT_TAIL(&pool->free_mbuf_blockq, mbuf_block, next);
+	}
+	pool->nfree_mbuf_blockq += nblocks;
+
+	slab->start = start;
+	slab->nblocks = nblocks;
+	slab->nfree = 0;
+	STAILQ_INSERT_TAIL(&pool->slabs, slab, next);
+	pool->nslabs++;
+	return true;
+}
+
+static struct mbuf_slab *
+_mbuf_slab_find(struct mbuf_pool *pool, struct mbuf_block *mbuf_block)
+{
+	struct mbuf_slab *slab;
+	char *start = (char *) ((uintptr_t) mbuf_block & ~((uintptr_t) MBUF_SLAB_SIZE - 1));
+
+	STAILQ_FOREACH (slab, &pool->slabs, next) {
+		if (slab->start == start) {
+			return slab;
+		}
+	}
+	return NULL;
+}
+
 static struct mbuf_block *
 _mbuf_block_get(struct mbuf_pool *pool)
 {
 	struct mbuf_block *mbuf_block;
 	char *buf;
 
+	if (pool->slab_mode && STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
+		if (OXT_UNLIKELY(!_mbuf_slab_new(pool))) {
+			return NULL;
+		}
+	}
+
 	if (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
 		assert(pool->nfree_mbuf_blockq > 0);
 
@@ -280,12 +392,113 @@ mbuf_pool_init(struct mbuf_pool *pool)
 	#endif
 
 	pool->mbuf_block_offset = pool->mbuf_block_chunk_size - MBUF_BLOCK_HSIZE;
+
+	STAILQ_INIT(&pool->slabs);
+	pool->nslabs = 0;
+	pool->nreserved_slabs = 0;
+	pool->numa_node = -1;
+	pool->slab_mode = false;
+
+	for (unsigned int i = 0; i < MBUF_POOL_NSIZE_CLASSES; i++) {
+		pool->size_classes[i] = NULL;
+	}
 }
 
 void
 mbuf_pool_deinit(struct mbuf_pool *pool)
 {
+	pool->nreserved_slabs = 0;
 	mbuf_pool_compact(pool);
+
+	for (unsigned int i = 0; i < MBUF_POOL_NSIZE_CLASSES; i++) {
+		struct mbuf_pool *class_pool = pool->size_classes[i];
+		// Active blocks still point to their pool, so we can only
+		// free the pool once they are all gone.
+		if (class_pool != NULL && class_pool->nactive_mbuf_blockq == 0) {
+			free(class_pool);
+			pool->size_classes[i] = NULL;
+		}
+	}
+}
+
+/*
+ * Switches the pool to slab mode. Instead of malloc()ing normal mbuf_blocks
+ * one by one, the pool then carves them from MBUF_SLAB_SIZE regions; see
+ * _mbuf_slab_new(). If numa_node >= 0 then the regions are bound to that
+ * NUMA node. nreserved_slabs regions are allocated immediately, and
+ * mbuf_pool_compact() always keeps at least that many.
+ *
+ * Must be called before any mbuf_blocks are allocated from the pool. Returns
+ * false if that is not the case, or if the chunk size is too large for slabs.
+ */
+bool
+mbuf_pool_enable_slabs(struct mbuf_pool *pool, int numa_node,
+	unsigned int nreserved_slabs)
+{
+	if (pool->nfree_mbuf_blockq > 0 || pool->nactive_mbuf_blockq > 0
+	 || pool->mbuf_block_chunk_size > MBUF_SLAB_SIZE / 4)
+	{
+		return false;
+	}
+
+	pool->slab_mode = true;
+	pool->numa_node = numa_node;
+	pool->nreserved_slabs = nreserved_slabs;
+	while (pool->nslabs < nreserved_slabs && _mbuf_slab_new(pool)) {
+		// Do nothing.
+	}
+	return true;
+}
+
+/*
+ * Chunk sizes of the size classes, in ascending order. The class whose chunk
+ * size equals the pool's own chunk size is served by the pool itself.
+ */
+static const size_t mbuf_size_class_chunk_sizes[MBUF_POOL_NSIZE_CLASSES] = {
+	512, 4096, 16384
+};
+
+/*
+ * Returns the pool whose normal mbuf_blocks best fit `size` bytes of data:
+ * the pool with the smallest chunk size that can hold it, or the one with
+ * the largest chunk size if none can. This is either `pool` itself or one
+ * of its size class pools, which are created on demand.
+ *
+ * Blocks always return to the pool that they were allocated from, so the
+ * caller doesn't have to remember which pool it used.
+ */
+struct mbuf_pool *
+mbuf_pool_for_size(struct mbuf_pool *pool, size_t size)
+{
+	size_t best_chunk_size = pool->mbuf_block_chunk_size;
+	int index = -1;
+
+	for (unsigned int i = 0; i < MBUF_POOL_NSIZE_CLASSES; i++) {
+		size_t chunk_size = mbuf_size_class_chunk_sizes[i];
+		bool fits = chunk_size - MBUF_BLOCK_HSIZE >= size;
+		bool best_fits = best_chunk_size - MBUF_BLOCK_HSIZE >= size;
+		if (fits
+			? (!best_fits || chunk_size < best_chunk_size)
+			: (!best_fits && chunk_size > best_chunk_size))
+		{
+			best_chunk_size = chunk_size;
+			index = i;
+		}
+	}
+	if (index == -1) {
+		return pool;
+	}
+
+	if (OXT_UNLIKELY(pool->size_classes[index] == NULL)) {
+		struct mbuf_pool *class_pool = (struct mbuf_pool *) malloc(sizeof(struct mbuf_pool));
+		if (class_pool == NULL) {
+			return pool;
+		}
+		class_pool->mbuf_block_chunk_size = mbuf_size_class_chunk_sizes[index];
+		mbuf_pool_init(class_pool);
+		pool->size_classes[index] = class_pool;
+	}
+	return pool->size_classes[index];
 }
 
 /*
@@ -298,10 +511,86 @@ mbuf_pool_data_size(struct mbuf_pool *pool)
 	return pool->mbuf_block_offset;
 }
 
+/*
+ * In slab mode, only whole regions can be returned to the OS. Releases
+ * regions whose blocks are all free, as long as at least nreserved_slabs
+ * regions remain.
+ */
+static unsigned int
+_mbuf_pool_compact_slabs(struct mbuf_pool *pool)
+{
+	struct mbuf_slab *slab, *next_slab;
+	struct mbuf_block *mbuf_block;
+	struct mhdr remaining;
+	unsigned int budget, nreleased = 0, count = 0;
+
+	STAILQ_FOREACH (slab, &pool->slabs, next) {
+		slab->nfree = 0;
+	}
+	STAILQ_FOREACH (mbuf_block, &pool->free_mbuf_blockq, next) {
+		_mbuf_slab_find(pool, mbuf_block)->nfree++;
+	}
+
+	// Mark the slabs that we release by leaving nfree == nblocks.
+	budget = (pool->nslabs > pool->nreserved_slabs)
+		? pool->nslabs - pool->nreserved_slabs
+		: 0;
+	STAILQ_FOREACH (slab, &pool->slabs, next) {
+		if (slab->nfree == slab->nblocks && nreleased < budget) {
+			nreleased++;
+		} else {
+			slab->nfree = 0;
+		}
+	}
+	if (nreleased == 0) {
+		return 0;
+	}
+
+	STAILQ_INIT(&remaining);
+	while (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
+		mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
+		STAILQ_REMOVE_HEAD(&pool->free_mbuf_blockq, next);
+		slab = _mbuf_slab_find(pool, mbuf_block);
+		if (slab->nfree == slab->nblocks) {
+			pool->nfree_mbuf_blockq--;
+			count++;
+		} else {
+			STAILQ_INSERT_TAIL(&remaining, mbuf_block, next);
+		}
+	}
+	STAILQ_CONCAT(&pool->free_mbuf_blockq, &remaining);
+
+	slab = STAILQ_FIRST(&pool->slabs);
+	while (slab != NULL) {
+		next_slab = STAILQ_NEXT(slab, next);
+		if (slab->nfree == slab->nblocks) {
+			STAILQ_REMOVE(&pool->slabs, slab, struct mbuf_slab, next);
+			munmap(slab->start, MBUF_SLAB_SIZE);
+			free(slab);
+			pool->nslabs--;
+		}
+		slab = next_slab;
+	}
+
+	return count;
+}
+
 unsigned int
 mbuf_pool_compact(struct mbuf_pool *pool)
 {
-	unsigned int count = pool->nfree_mbuf_blockq;
+	unsigned int i, count = 0;
+
+	for (i = 0; i < MBUF_POOL_NSIZE_CLASSES; i++) {
+		if (pool->size_classes[i] != NULL) {
+			count += mbuf_pool_compact(pool->size_classes[i]);
+		}
+	}
+
+	if (pool->slab_mode) {
+		return count + _mbuf_pool_compact_slabs(pool);
+	}
+
+	count += pool->nfree_mbuf_blockq;
 
 	while (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
 		struct mbuf_block *mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
@@ -396,6 +685,17 @@ mbuf_get_with_size(struct mbuf_pool *pool, size_t size)
 	return mbuf(block, 0, size, mbuf::just_created_t());
 }
 
+/*
+ * Like mbuf_get(), but takes the block from the size class that best fits
+ * `size` bytes; see mbuf_pool_for_size(). The returned mbuf spans the entire
+ * block, so it may be smaller or larger than `size`.
+ */
+mbuf
+mbuf_get_for_size(struct mbuf_pool *pool, size_t size)
+{
+	return mbuf_get(mbuf_pool_for_size(pool, size));
+}
+
 static void
 mbuf_block_print(struct mbuf_block *mbuf_block, std::ostream &stream)
 {
@@ -89,10 +89,22 @@ struct mbuf_block {
 };
 
 STAILQ_HEAD(mhdr, struct mbuf_block);
+
+/* A region that mbuf_blocks are carved from in slab mode. */
+struct mbuf_slab {
+	STAILQ_ENTRY(struct mbuf_slab) next; /* next slab in the pool */
+	char              *start;     /* start of region, MBUF_SLAB_SIZE aligned (const) */
+	boost::uint32_t    nblocks;   /* # mbuf_blocks in region (const) */
+	boost::uint32_t    nfree;     /* # free mbuf_blocks, only valid during compaction */
+};
+
+STAILQ_HEAD(mbuf_slab_list, struct mbuf_slab);
 #ifdef MBUF_ENABLE_DEBUGGING
 	TAILQ_HEAD(active_mbuf_block_list, struct mbuf_block);
 #endif
 
+#define MBUF_POOL_NSIZE_CLASSES 3
+
 struct mbuf_pool {
 	boost::uint32_t nfree_mbuf_blockq;   /* # free mbuf_block */
 	boost::uint32_t nactive_mbuf_blockq; /* # active (non-free) mbuf_block */
@@ -103,6 +115,16 @@ struct mbuf_pool {
 
 	size_t mbuf_block_chunk_size; /* mbuf_block chunk size - header + data (const) */
 	size_t mbuf_block_offset;     /* mbuf_block offset in chunk (const) */
+
+	/* Slab mode; see mbuf_pool_enable_slabs() */
+	struct mbuf_slab_list slabs;     /* regions that mbuf_blocks are carved from */
+	boost::uint32_t nslabs;          /* # regions */
+	boost::uint32_t nreserved_slabs; /* # regions that compaction keeps */
+	int numa_node;                   /* NUMA node that regions are bound to, or -1 */
+	bool slab_mode;
+
+	/* Pools for the other size classes, created on demand; see mbuf_pool_for_size() */
+	struct mbuf_pool *size_classes[MBUF_POOL_NSIZE_CLASSES];
 };
 
 #define MBUF_BLOCK_MAGIC      0xdeadbeef
@@ -110,6 +132,7 @@ struct mbuf_pool {
 #define MBUF_BLOCK_MAX_SIZE   16777216
 #define MBUF_BLOCK_SIZE       16384
 #define MBUF_BLOCK_HSIZE      sizeof(struct mbuf_block)
+#define MBUF_SLAB_SIZE        (2 * 1024 * 1024)
 
 #define MBUF_BLOCK_EMPTY(mbuf_block) ((mbuf_block)->pos  == (mbuf_block)->last)
 #define MBUF_BLOCK_FULL(mbuf_block)  ((mbuf_block)->last == (mbuf_block)->end)
@@ -118,6 +141,9 @@ void mbuf_pool_init(struct mbuf_pool *pool);
 void mbuf_pool_deinit(struct mbuf_pool *pool);
 size_t mbuf_pool_data_size(struct mbuf_pool *pool);
 unsigned int mbuf_pool_compact(struct mbuf_pool *pool);
+bool mbuf_pool_enable_slabs(struct mbuf_pool *pool, int numa_node,
+	unsigned int nreserved_slabs);
+struct mbuf_pool *mbuf_pool_for_size(struct mbuf_pool *pool, size_t size);
 
 struct mbuf_block *mbuf_block_get(struct mbuf_pool *pool);
 void mbuf_block_put(struct mbuf_block *mbuf_block);
@@ -280,6 +306,7 @@ public:
 mbuf mbuf_block_subset(struct mbuf_block *mbuf_block, unsigned int start, unsigned int len);
 mbuf mbuf_get(struct mbuf_pool *pool);
 mbuf mbuf_get_with_size(struct mbuf_pool *pool, size_t size);
+mbuf mbuf_get_for_size(struct mbuf_pool *pool, size_t size);
 
 
 } // namespace MemoryKit
@@ -87,10 +87,17 @@ psg_init_pool(psg_pool_t *pool, size_t size)
 	pool->data.failed = 0;
 
 	size = size - sizeof(psg_pool_t);
-	pool->max = (size < PSG_MAX_ALLOC_FROM_POOL) ? size : PSG_MAX_ALLOC_FROM_POOL;
+	if (size > PSG_DEFAULT_POOL_SIZE) {
+		pool->max = size / 4;
+	} else {
+		pool->max = (size < PSG_MAX_ALLOC_FROM_POOL) ? size : PSG_MAX_ALLOC_FROM_POOL;
+	}
 
 	pool->current = pool;
 	pool->large = NULL;
+	pool->large_size = 0;
+	pool->nlarge = 0;
+	pool->max_alloc_size = 0;
 }
 
 
@@ -134,6 +141,9 @@ psg_reset_pool(psg_pool_t *pool, size_t size)
 	} else {
 		pool->current = pool;
 		pool->large = NULL;
+		pool->large_size = 0;
+		pool->nlarge = 0;
+		pool->max_alloc_size = 0;
 
 		for (p = pool; p; p = p->data.next) {
 			char *m = (char *) p;
@@ -153,12 +163,38 @@ psg_reset_pool(psg_pool_t *pool, size_t size)
 }
 
 
+size_t
+psg_pool_block_size(const psg_pool_t *pool)
+{
+	return (size_t) (pool->data.end - (const char *) pool);
+}
+
+
+size_t
+psg_pool_used_size(const psg_pool_t *pool)
+{
+	const psg_pool_t  *p;
+	size_t             result = pool->large_size;
+
+	result += (size_t) (pool->data.last - (const char *) pool) - sizeof(psg_pool_t);
+	for (p = pool->data.next; p; p = p->data.next) {
+		result += (size_t) (p->data.last - (const char *) p) - sizeof(psg_pool_data_t);
+	}
+
+	return result;
+}
+
+
 void *
 psg_palloc(psg_pool_t *pool, size_t size)
 {
 	char        *m;
 	psg_pool_t  *p;
 
+	if (OXT_UNLIKELY(size > PSG_MAX_ALLOC_FROM_POOL) && size > pool->max_alloc_size) {
+		pool->max_alloc_size = size;
+	}
+
 	if (OXT_LIKELY(size <= pool->max)) {
 		p = pool->current;
 
@@ -186,6 +222,10 @@ psg_pnalloc(psg_pool_t *pool, size_t size)
 	char        *m;
 	psg_pool_t  *p;
 
+	if (OXT_UNLIKELY(size > PSG_MAX_ALLOC_FROM_POOL) && size > pool->max_alloc_size) {
+		pool->max_alloc_size = size;
+	}
+
 	if (size <= pool->max) {
 		p = pool->current;
 
@@ -263,6 +303,8 @@ psg_palloc_large(psg_pool_t *pool, size_t size)
 		return NULL;
 	}
 
+	pool->large_size += size;
+	pool->nlarge++;
 	n = 0;
 
 	for (large = pool->large; large; large = large->next) {
@@ -301,6 +343,10 @@ psg_pmemalign(psg_pool_t *pool, size_t size, size_t alignment)
 		return NULL;
 	}
 
+	if (size > PSG_MAX_ALLOC_FROM_POOL && size > pool->max_alloc_size) {
+		pool->max_alloc_size = size;
+	}
+
 	large = (psg_pool_large_t *) psg_palloc(pool, sizeof(psg_pool_large_t));
 	if (large == NULL) {
 		free(p);
@@ -310,6 +356,8 @@ psg_pmemalign(psg_pool_t *pool, size_t size, size_t alignment)
 	large->alloc = p;
 	large->next = pool->large;
 	pool->large = large;
+	pool->large_size += size;
+	pool->nlarge++;
 
 	return p;
 }
@@ -94,13 +94,32 @@ struct psg_pool_s {
 	size_t                max;      /* Read-only */
 	psg_pool_t           *current;
 	psg_pool_large_t     *large;
+
+	/* Statistics since creation or the last reset. */
+	size_t                large_size;      /* Total bytes allocated through `large`. */
+	unsigned int          nlarge;          /* Number of allocations through `large`. */
+	size_t                max_alloc_size;  /* Largest allocation above PSG_MAX_ALLOC_FROM_POOL, or 0. */
 };
 
 
+/**
+ * Creates a pool whose blocks are `size` bytes. Pools larger than
+ * PSG_DEFAULT_POOL_SIZE also serve proportionally larger objects from
+ * their blocks, instead of from the large memory allocator.
+ */
 psg_pool_t *psg_create_pool(size_t size);
 void psg_destroy_pool(psg_pool_t *pool);
 bool psg_reset_pool(psg_pool_t *pool, size_t size);
 
+/** Returns the block size that the pool was created with. */
+size_t psg_pool_block_size(const psg_pool_t *pool);
+
+/**
+ * Returns the number of bytes allocated from the pool since its creation
+ * or its last reset, including large allocations.
+ */
+size_t psg_pool_used_size(const psg_pool_t *pool);
+
 /** Allocate `size` bytes from the pool, aligned on platform word size. */
 void *psg_palloc(psg_pool_t *pool, size_t size);
 
@@ -0,0 +1,356 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE // according to Linux man page for syscall()
+#endif
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#ifdef __linux__
+	#include <sys/syscall.h>
+#endif
+
+#include <boost/bind.hpp>
+#include <oxt/system_calls.hpp>
+#include <algorithm>
+#include <climits>  // for PTHREAD_STACK_MIN
+#include <cstring>
+#include <cerrno>
+
+#include <ProcessManagement/ChildReaper.h>
+#include <LoggingKit/LoggingKit.h>
+#include <Exceptions.h>
+#include <Utils/ScopeGuard.h>
+#include <Utils/StrIntUtils.h>
+#include <Utils/Timer.h>
+
+namespace Passenger {
+
+using namespace std;
+using namespace oxt;
+
+
+ChildReaper::ChildReaper()
+	: thr(NULL)
+{
+	if (syscalls::pipe(wakeupPipe) == -1) {
+		int e = errno;
+		throw SystemException("Cannot create a pipe", e);
+	}
+	for (int i = 0; i < 2; i++) {
+		fcntl(wakeupPipe[i], F_SETFD, FD_CLOEXEC);
+		fcntl(wakeupPipe[i], F_SETFL, fcntl(wakeupPipe[i], F_GETFL) | O_NONBLOCK);
+	}
+
+	int fd = openPidfd(getpid());
+	pidfdSupported = fd != -1;
+	if (fd != -1) {
+		syscalls::close(fd);
+	}
+}
+
+ChildReaper &
+ChildReaper::getInstance() {
+	// Never destroyed: the reaper thread may outlive static destructors.
+	static ChildReaper *instance = new ChildReaper();
+	return *instance;
+}
+
+int
+ChildReaper::openPidfd(pid_t pid) {
+	#if defined(__linux__) && defined(__NR_pidfd_open)
+		// pidfds are always opened with O_CLOEXEC.
+		return (int) syscall(__NR_pidfd_open, pid, 0);
+	#else
+		errno = ENOSYS;
+		return -1;
+	#endif
+}
+
+int
+ChildReaper::timedWaitpid(pid_t pid, int *status, unsigned long long timeout) {
+	int ret = syscalls::waitpid(pid, status, WNOHANG);
+	if (ret != 0) {
+		return ret;
+	}
+
+	int fd = openPidfd(pid);
+	if (fd != -1) {
+		FdGuard guard(fd, NULL, 0, true);
+		struct pollfd pfd;
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		if (syscalls::poll(&pfd, 1, (int) std::min<unsigned long long>(timeout, INT_MAX)) == -1) {
+			return -1;
+		}
+		return syscalls::waitpid(pid, status, WNOHANG);
+	}
+
+	// No pidfd support: poll.
+	Timer<SystemTime::GRAN_10MSEC> timer;
+	do {
+		ret = syscalls::waitpid(pid, status, WNOHANG);
+		if (ret > 0 || ret == -1) {
+			return ret;
+		} else {
+			syscalls::usleep(10000);
+		}
+	} while (timer.elapsed() < timeout);
+	return 0; // timed out
+}
+
+void
+ChildReaper::startThread() {
+	if (thr == NULL) {
+		thr = new oxt::thread(
+			boost::bind(&ChildReaper::threadMain, this),
+			"Child reaper",
+			1024 * 64
+		);
+	}
+}
+
+/**
+ * Used when the process cannot be watched through a pidfd: reaps it from a
+ * thread of its own that blocks in `waitpid()`, instead of having the reaper
+ * thread poll for it.
+ */
+void
+ChildReaper::startBlockingWaiter(pid_t pid, const Callback &callback) {
+	// Using raw pthread API because we don't want to register such
+	// trivial threads on the oxt::thread list.
+	pthread_t thr;
+	pthread_attr_t attr;
+	size_t stackSize = 96 * 1024;
+	int ret;
+
+	#ifdef PTHREAD_STACK_MIN
+		// PTHREAD_STACK_MIN may not be a constant macro so we need
+		// to evaluate it dynamically.
+		if (stackSize < (size_t) PTHREAD_STACK_MIN) {
+			stackSize = PTHREAD_STACK_MIN;
+		}
+	#endif
+
+	BlockingWaiter *waiter = new BlockingWaiter();
+	waiter->pid = pid;
+	waiter->callback = callback;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	pthread_attr_setstacksize(&attr, stackSize);
+	ret = pthread_create(&thr, &attr, blockingWaiterMain, waiter);
+	pthread_attr_destroy(&attr);
+
+	if (ret != 0) {
+		delete waiter;
+		throw SystemException("Cannot create a thread for reaping process "
+			+ toString(pid), ret);
+	}
+}
+
+void *
+ChildReaper::blockingWaiterMain(void *arg) {
+	boost::this_thread::disable_syscall_interruption dsi;
+	BlockingWaiter *waiter = (BlockingWaiter *) arg;
+	int status;
+
+	if (syscalls::waitpid(waiter->pid, &status, 0) == -1) {
+		// Already reaped by someone else.
+		status = -1;
+	}
+	if (waiter->callback) {
+		waiter->callback(waiter->pid, status);
+	}
+	delete waiter;
+	return NULL;
+}
+
+void
+ChildReaper::wakeup() {
+	char c = 0;
+	// The pipe is non-blocking. If it's full then the reaper thread
+	// is going to wake up anyway.
+	ssize_t ret = ::write(wakeupPipe[1], &c, 1);
+	(void) ret;
+}
+
+void
+ChildReaper::reap(pid_t pid, const Callback &callback) {
+	Watch watch;
+	watch.pid = pid;
+	watch.pidfd = pidfdSupported ? openPidfd(pid) : -1;
+	watch.reap = true;
+	watch.callback = callback;
+	if (watch.pidfd == -1) {
+		startBlockingWaiter(pid, callback);
+		return;
+	}
+
+	boost::lock_guard<boost::mutex> l(syncher);
+	watches.push_back(watch);
+	startThread();
+	wakeup();
+}
+
+bool
+ChildReaper::notifyOnExit(pid_t pid, const Callback &callback) {
+	if (!pidfdSupported) {
+		return false;
+	}
+
+	Watch watch;
+	watch.pid = pid;
+	watch.pidfd = openPidfd(pid);
+	watch.reap = false;
+	watch.callback = callback;
+	if (watch.pidfd == -1 && errno != ESRCH) {
+		return false;
+	}
+	// If the process no longer exists (ESRCH) then the reaper
+	// thread calls the callback right away.
+
+	boost::lock_guard<boost::mutex> l(syncher);
+	watches.push_back(watch);
+	startThread();
+	wakeup();
+	return true;
+}
+
+unsigned int
+ChildReaper::getWatchCount() {
+	boost::lock_guard<boost::mutex> l(syncher);
+	return watches.size();
+}
+
+/**
+ * Checks whether the watched process has exited, and if so, reaps it
+ * if necessary.
+ */
+bool
+ChildReaper::checkWatch(const Watch &watch, bool readable, int &status) {
+	status = -1;
+	if (watch.reap) {
+		if (!readable) {
+			return false;
+		}
+		pid_t ret = ::waitpid(watch.pid, &status, WNOHANG);
+		if (ret == -1 && errno == EINTR) {
+			return false;
+		} else if (ret == 0) {
+			return false;
+		} else {
+			if (ret == -1) {
+				// Already reaped by someone else.
+				status = -1;
+			}
+			return true;
+		}
+	} else {
+		return readable || watch.pidfd == -1;
+	}
+}
+
+void
+ChildReaper::threadMain() {
+	vector<struct pollfd> fds;
+	vector< pair<Watch, int> > exited;
+
+	while (true) {
+		// Watches without a pidfd are for processes that had already
+		// exited when the watch was added.
+		bool haveExited = false;
+
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			fds.resize(watches.size() + 1);
+			fds[0].fd = wakeupPipe[0];
+			fds[0].events = POLLIN;
+			fds[0].revents = 0;
+			for (unsigned int i = 0; i < watches.size(); i++) {
+				// poll() ignores negative file descriptors.
+				fds[i + 1].fd = watches[i].pidfd;
+				fds[i + 1].events = POLLIN;
+				fds[i + 1].revents = 0;
+				haveExited = haveExited || watches[i].pidfd == -1;
+			}
+		}
+
+		if (syscalls::poll(&fds[0], fds.size(), haveExited ? 0 : -1) == -1) {
+			int e = errno;
+			P_ERROR("Child reaper: poll() failed: " << strerror(e) << " (errno=" << e << ")");
+			syscalls::usleep(10000);
+			continue;
+		}
+
+		if (fds[0].revents != 0) {
+			char buf[256];
+			while (::read(wakeupPipe[0], buf, sizeof(buf)) > 0) {
+				// Drain the pipe.
+			}
+		}
+
+		{
+			// Watches are only ever removed by this thread, and new
+			// watches are appended, so the first `fds.size() - 1`
+			// watches still correspond to `fds`.
+			boost::lock_guard<boost::mutex> l(syncher);
+			unsigned int i = 0, nChecked = fds.size() - 1;
+			vector<Watch>::iterator it = watches.begin();
+
+			while (i < nChecked) {
+				int status;
+				if (checkWatch(*it, fds[i + 1].revents != 0, status)) {
+					exited.push_back(make_pair(*it, status));
+					it = watches.erase(it);
+				} else {
+					it++;
+				}
+				i++;
+			}
+		}
+
+		vector< pair<Watch, int> >::iterator it, end = exited.end();
+		for (it = exited.begin(); it != end; it++) {
+			if (it->first.pidfd != -1) {
+				syscalls::close(it->first.pidfd);
+			}
+			if (it->first.callback) {
+				it->first.callback(it->first.pid, it->second);
+			}
+		}
+		exited.clear();
+	}
+}
+
+
+} // namespace Passenger
@@ -0,0 +1,129 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_PROCESS_MANAGEMENT_CHILD_REAPER_H_
+#define _PASSENGER_PROCESS_MANAGEMENT_CHILD_REAPER_H_
+
+#include <sys/types.h>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <oxt/thread.hpp>
+#include <vector>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * Waits for processes to exit without polling, and reaps child processes in
+ * the background. A single reaper thread serves the entire process: it waits
+ * on a pidfd (Linux >= 5.3) for every watched process, and calls the
+ * associated callback as soon as that process has exited.
+ *
+ * On platforms without pidfd support, every child process is reaped by a
+ * background thread of its own that blocks in `waitpid()`, so that nothing
+ * has to poll. Exit notifications for non-child processes (`notifyOnExit()`)
+ * are not available in that case.
+ *
+ * Callbacks are called from the reaper thread (or the per-process thread),
+ * without any lock held. They must not block for long.
+ *
+ * All methods are thread-safe.
+ */
+class ChildReaper {
+public:
+	/**
+	 * Called with the PID of the process that has exited, and its exit
+	 * status as returned by `waitpid()`, or -1 if the status is unknown.
+	 */
+	typedef boost::function<void (pid_t pid, int status)> Callback;
+
+private:
+	struct Watch {
+		pid_t pid;
+		int pidfd;
+		bool reap;
+		Callback callback;
+	};
+
+	boost::mutex syncher;
+	vector<Watch> watches;
+	oxt::thread *thr;
+	int wakeupPipe[2];
+	bool pidfdSupported;
+
+	ChildReaper();
+
+	struct BlockingWaiter {
+		pid_t pid;
+		Callback callback;
+	};
+
+	void startThread();
+	static void startBlockingWaiter(pid_t pid, const Callback &callback);
+	static void *blockingWaiterMain(void *arg);
+	void wakeup();
+	void threadMain();
+	bool checkWatch(const Watch &watch, bool readable, int &status);
+
+public:
+	/** Returns the process-wide reaper. */
+	static ChildReaper &getInstance();
+
+	/** Opens a pidfd for the given process, or returns -1 if not supported. */
+	static int openPidfd(pid_t pid);
+
+	/**
+	 * Behaves like `waitpid(pid, status, WNOHANG)`, but waits at most
+	 * `timeout` miliseconds for the child process to exit.
+	 *
+	 * This is an interruption point.
+	 */
+	static int timedWaitpid(pid_t pid, int *status, unsigned long long timeout);
+
+	/**
+	 * Reaps the given child process in the background once it has exited,
+	 * then calls `callback` (if any) with its exit status.
+	 */
+	void reap(pid_t pid, const Callback &callback = Callback());
+
+	/**
+	 * Calls `callback` once the given process, which does not have to be a
+	 * child process, has exited. The process is not reaped.
+	 *
+	 * Returns false if exit notifications are not supported on this platform,
+	 * in which case the caller has to keep polling the process.
+	 */
+	bool notifyOnExit(pid_t pid, const Callback &callback);
+
+	/** The number of processes that are currently being watched. */
+	unsigned int getWatchCount();
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_PROCESS_MANAGEMENT_CHILD_REAPER_H_ */
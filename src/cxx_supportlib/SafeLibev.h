@@ -87,9 +87,11 @@ private:
 	}
 
 	void runCommands() {
+		// Swap instead of copying so that the event loop thread
+		// doesn't have to allocate memory for every wakeup.
+		vector<Command> commands;
 		boost::unique_lock<boost::mutex> l(syncher);
-		vector<Command> commands = this->commands;
-		this->commands.clear();
+		commands.swap(this->commands);
 		l.unlock();
 
 		vector<Command>::const_iterator it, end = commands.end();
@@ -27,11 +27,16 @@
 #define _PASSENGER_SERVER_KIT_CONTEXT_H_
 
 #include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <string>
 #include <cstddef>
 #include <jsoncpp/json.h>
 #include <MemoryKit/mbuf.h>
 #include <SafeLibev.h>
+#include <ServerKit/IoUring.h>
+#include <ServerKit/TimerWheel.h>
 #include <Constants.h>
 #include <Utils/StrIntUtils.h>
 #include <Utils/JsonUtils.h>
@@ -44,11 +49,89 @@ namespace Passenger {
 namespace ServerKit {
 
 
+/**
+ * The kind of file that a FileBufferedChannel buffers data to when it is
+ * in the in-file mode.
+ */
+enum FileBufferedChannelFileType {
+	/**
+	 * A named file in `bufferDir`, which is deleted right after it
+	 * has been created.
+	 */
+	FBC_NAMED_FILE,
+	/**
+	 * An unnamed file in `bufferDir` created with O_TMPFILE, so that
+	 * there is no deletion step. Falls back to FBC_NAMED_FILE if
+	 * the OS or filesystem doesn't support it.
+	 */
+	FBC_UNNAMED_FILE,
+	/**
+	 * An anonymous, memory-backed file created with memfd_create().
+	 * The buffered data stays in memory (or swap), but out of the mbuf
+	 * pool and without touching the disk. Falls back to FBC_NAMED_FILE
+	 * if the OS doesn't support it.
+	 */
+	FBC_MEMFD
+};
+
+/**
+ * Accounts the memory that FileBufferedChannels buffer, across all channels
+ * whose config points to it -- possibly in multiple Contexts, e.g. all Core
+ * threads. It replaces the per-channel `threshold`: as long as the budget
+ * isn't exhausted, channels keep buffering in memory, so that a few slow
+ * clients don't needlessly cause disk I/O. Once it is exhausted, channels
+ * that buffer at least `minThreshold` bytes switch to the in-file mode.
+ */
+struct FileBufferedChannelMemoryBudget {
+	boost::uint64_t limit;
+	unsigned int minThreshold;
+	boost::atomic<boost::uint64_t> used;
+
+	FileBufferedChannelMemoryBudget(boost::uint64_t _limit = 0,
+		unsigned int _minThreshold = DEFAULT_FILE_BUFFERED_CHANNEL_MIN_THRESHOLD)
+		: limit(_limit),
+		  minThreshold(_minThreshold),
+		  used(0)
+		{ }
+
+	void add(boost::uint64_t size) {
+		used.fetch_add(size, boost::memory_order_relaxed);
+	}
+
+	void remove(boost::uint64_t size) {
+		used.fetch_sub(size, boost::memory_order_relaxed);
+	}
+
+	bool exhausted() const {
+		return used.load(boost::memory_order_relaxed) >= limit;
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		doc["limit"] = byteSizeToJson(limit);
+		doc["min_threshold"] = byteSizeToJson(minThreshold);
+		doc["used"] = byteSizeToJson(used.load(boost::memory_order_relaxed));
+		return doc;
+	}
+};
+
 struct FileBufferedChannelConfig {
 	string bufferDir;
 	unsigned int threshold;
 	unsigned int delayInFileModeSwitching;
 	unsigned int maxDiskChunkReadSize;
+	/**
+	 * The maximum number of buffers that the mover writes to the file
+	 * in a single (vectored) write operation.
+	 */
+	unsigned int maxBuffersPerWrite;
+	FileBufferedChannelFileType fileType;
+	/**
+	 * If not NULL, `threshold` is ignored and the decision to switch to
+	 * the in-file mode is made by this budget instead. May only be changed
+	 * while no channel that uses this config buffers any data.
+	 */
+	FileBufferedChannelMemoryBudget *memoryBudget;
 	bool autoTruncateFile;
 	bool autoStartMover;
 
@@ -57,6 +140,9 @@ struct FileBufferedChannelConfig {
 		  threshold(DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD),
 		  delayInFileModeSwitching(0),
 		  maxDiskChunkReadSize(0),
+		  maxBuffersPerWrite(64),
+		  fileType(FBC_NAMED_FILE),
+		  memoryBudget(NULL),
 		  autoTruncateFile(true),
 		  autoStartMover(true)
 		{ }
@@ -75,24 +161,84 @@ public:
 	struct MemoryKit::mbuf_pool mbuf_pool;
 	string secureModePassword;
 	FileBufferedChannelConfig defaultFileBufferedChannelConfig;
+	/** Drives client timeouts of all Servers in this context. */
+	TimerWheel timerWheel;
 
 	Context(const SafeLibevPtr &_libev, struct uv_loop_s *_libuv)
 		: libev(_libev),
-		  libuv(_libuv)
+		  libuv(_libuv),
+		  timerWheel(_libev->getLoop())
 	{
 		initialize();
 	}
 
 	Context(struct ev_loop *loop)
-		: libev(boost::make_shared<SafeLibev>(loop))
+		: libev(boost::make_shared<SafeLibev>(loop)),
+		  timerWheel(loop)
 	{
 		initialize();
 	}
 
+	#ifdef SERVER_KIT_HAVE_IO_URING
+		/**
+		 * Non-NULL if Servers and FdSourceChannels in this context should use
+		 * io_uring for accepting clients and for reading, instead of libev
+		 * readiness notification. See `enableIoUring()`.
+		 */
+		boost::scoped_ptr<IoUring> ioUring;
+	#endif
+
 	~Context() {
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			ioUring.reset();
+		#endif
 		MemoryKit::mbuf_pool_deinit(&mbuf_pool);
 	}
 
+	/**
+	 * Switches this context's I/O engine from libev to io_uring. Returns
+	 * false, and leaves the context on libev, if io_uring is not supported
+	 * by the compiler or by the kernel. Must be called before any Servers or
+	 * channels are created in this context.
+	 */
+	bool enableIoUring(string *error = NULL) {
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			try {
+				ioUring.reset(new IoUring(libev->getLoop(), &mbuf_pool));
+				return true;
+			} catch (const std::exception &e) {
+				if (error != NULL) {
+					*error = e.what();
+				}
+				return false;
+			}
+		#else
+			if (error != NULL) {
+				*error = "io_uring support was not compiled in";
+			}
+			return false;
+		#endif
+	}
+
+	/**
+	 * Makes the mbuf pool carve its blocks from huge-page-aligned slab regions
+	 * instead of malloc()ing them one by one. If `numaNode` >= 0, then the
+	 * regions are bound to that NUMA node. `reservedSlabs` regions are
+	 * prefaulted immediately, and compaction always keeps at least that many.
+	 * Must be called before any buffers are allocated from this context.
+	 */
+	bool enableMbufSlabs(int numaNode = -1, unsigned int reservedSlabs = 1) {
+		return MemoryKit::mbuf_pool_enable_slabs(&mbuf_pool, numaNode, reservedSlabs);
+	}
+
+	bool usingIoUring() const {
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			return ioUring != NULL;
+		#else
+			return false;
+		#endif
+	}
+
 	Json::Value inspectStateAsJson() const {
 		Json::Value doc;
 		Json::Value mbufDoc;
@@ -105,6 +251,27 @@ public:
 			* mbuf_pool.mbuf_block_chunk_size);
 		mbufDoc["active_memory"] = byteSizeToJson(mbuf_pool.nactive_mbuf_blockq
 			* mbuf_pool.mbuf_block_chunk_size);
+		if (mbuf_pool.slab_mode) {
+			mbufDoc["slabs"] = (Json::UInt) mbuf_pool.nslabs;
+			mbufDoc["reserved_slabs"] = (Json::UInt) mbuf_pool.nreserved_slabs;
+			mbufDoc["slab_memory"] = byteSizeToJson((size_t) mbuf_pool.nslabs
+				* MBUF_SLAB_SIZE);
+			mbufDoc["numa_node"] = mbuf_pool.numa_node;
+		}
+		for (unsigned int i = 0; i < MBUF_POOL_NSIZE_CLASSES; i++) {
+			const struct MemoryKit::mbuf_pool *classPool = mbuf_pool.size_classes[i];
+			if (classPool != NULL) {
+				Json::Value classDoc;
+				classDoc["chunk_size"] = (Json::UInt) classPool->mbuf_block_chunk_size;
+				classDoc["free_blocks"] = (Json::UInt) classPool->nfree_mbuf_blockq;
+				classDoc["active_blocks"] = (Json::UInt) classPool->nactive_mbuf_blockq;
+				classDoc["spare_memory"] = byteSizeToJson(classPool->nfree_mbuf_blockq
+					* classPool->mbuf_block_chunk_size);
+				classDoc["active_memory"] = byteSizeToJson(classPool->nactive_mbuf_blockq
+					* classPool->mbuf_block_chunk_size);
+				mbufDoc["size_classes"].append(classDoc);
+			}
+		}
 		#ifdef MBUF_ENABLE_DEBUGGING
 			struct MemoryKit::active_mbuf_block_list *list =
 				const_cast<struct MemoryKit::active_mbuf_block_list *>(
@@ -127,6 +294,17 @@ public:
 		#endif
 
 		doc["mbuf_pool"] = mbufDoc;
+		doc["timer_wheel"] = timerWheel.inspectStateAsJson();
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ioUring != NULL) {
+				doc["io_engine"] = "io_uring";
+				doc["io_uring"] = ioUring->inspectStateAsJson();
+			} else {
+				doc["io_engine"] = "libev";
+			}
+		#else
+			doc["io_engine"] = "libev";
+		#endif
 
 		return doc;
 	}
@@ -28,6 +28,7 @@
 
 #include <oxt/macros.hpp>
 #include <boost/move/move.hpp>
+#include <algorithm>
 #include <sys/types.h>
 #include <unistd.h>
 #include <ev.h>
@@ -42,10 +43,24 @@ namespace ServerKit {
 using namespace oxt;
 
 
+/**
+ * A Channel that reads data from a file descriptor. It normally waits for
+ * readability with libev and then calls read(), but if the Context uses
+ * io_uring then it submits reads to the ring instead. In that case each
+ * read completes with an mbuf from the ring's provided buffers.
+ */
 class FdSourceChannel: protected Channel {
 private:
 	ev_io watcher;
 	MemoryKit::mbuf buffer;
+	#ifdef SERVER_KIT_HAVE_IO_URING
+		// The read or nop operation in flight, or 0.
+		unsigned int ioUringOperation;
+		// The result of a read that completed while this channel
+		// was not accepting input.
+		int pendingReadResult;
+		bool hasPendingReadResult;
+	#endif
 
 	static void _onReadable(EV_P_ ev_io *io, int revents) {
 		static_cast<FdSourceChannel *>(io->data)->onReadable(io, revents);
@@ -73,7 +88,12 @@ private:
 
 		for (i = 0; i < burstReadCount && !done; i++) {
 			if (buffer.empty()) {
-				buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				if (readSizeHint == 0) {
+					buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				} else {
+					buffer = MemoryKit::mbuf_get_for_size(&ctx->mbuf_pool,
+						readSizeHint);
+				}
 			}
 
 			origBufferSize = buffer.size();
@@ -81,6 +101,10 @@ private:
 				ret = ::read(watcher.fd, buffer.start, buffer.size());
 			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
 			if (ret > 0) {
+				if (readSizeHint != 0) {
+					adaptReadSizeHint(ret, origBufferSize);
+				}
+
 				MemoryKit::mbuf buffer2(buffer, 0, ret);
 				if (size_t(ret) == size_t(buffer.size())) {
 					// Unref mbuf_block
@@ -125,23 +149,138 @@ private:
 		}
 	}
 
+	/**
+	 * Grows the read size hint when a read filled a buffer that was at least
+	 * as large as the hint, and otherwise lets it decay towards the sizes of
+	 * the most recent reads.
+	 */
+	void adaptReadSizeHint(size_t readSize, size_t bufferSize) {
+		if (readSize == bufferSize) {
+			if (readSize >= readSizeHint) {
+				readSizeHint = std::min<size_t>(readSize * 2, MAX_READ_SIZE_HINT);
+			}
+		} else {
+			readSizeHint = std::max<size_t>(readSize, readSizeHint / 2);
+		}
+	}
+
+	#ifdef SERVER_KIT_HAVE_IO_URING
+		void submitIoUringRead() {
+			assert(ioUringOperation == 0);
+			if (hasPendingReadResult) {
+				// Deliver the result from the event loop, not from
+				// within whatever made this channel accept input again.
+				ioUringOperation = ctx->ioUring->nop(_onIoUringReadCompleted, this);
+			} else {
+				ioUringOperation = ctx->ioUring->read(watcher.fd,
+					_onIoUringReadCompleted, this);
+			}
+		}
+
+		void cancelIoUringRead() {
+			if (ioUringOperation != 0) {
+				ctx->ioUring->cancel(ioUringOperation);
+				ioUringOperation = 0;
+			}
+		}
+
+		static void _onIoUringReadCompleted(IoUring *ring, const struct io_uring_cqe *cqe,
+			MemoryKit::mbuf &data, void *userData)
+		{
+			static_cast<FdSourceChannel *>(userData)->onIoUringReadCompleted(
+				cqe->res, data);
+		}
+
+		void onIoUringReadCompleted(int result, MemoryKit::mbuf &data) {
+			RefGuard guard(hooks, this, __FILE__, __LINE__);
+			unsigned int generation = this->generation;
+
+			ioUringOperation = 0;
+			if (hasPendingReadResult) {
+				result = pendingReadResult;
+				data = boost::move(buffer);
+				buffer = MemoryKit::mbuf();
+				hasPendingReadResult = false;
+			}
+
+			if (!acceptingInput()) {
+				if (mayAcceptInputLater()) {
+					if (result != -ENOBUFS && result != -EAGAIN) {
+						pendingReadResult = result;
+						buffer = boost::move(data);
+						hasPendingReadResult = true;
+					}
+					consumedCallback = onChannelConsumed;
+				}
+				return;
+			}
+
+			if (result > 0) {
+				feedWithoutRefGuard(boost::move(data));
+				if (generation != this->generation) {
+					// Callback deinitialized this object.
+					return;
+				}
+				if (acceptingInput()) {
+					submitIoUringRead();
+				} else if (mayAcceptInputLater()) {
+					consumedCallback = onChannelConsumed;
+				}
+			} else if (result == 0) {
+				feedWithoutRefGuard(MemoryKit::mbuf());
+			} else if (result == -ENOBUFS || result == -EAGAIN) {
+				// All provided buffers are in use. Try again
+				// once the ring has been replenished.
+				submitIoUringRead();
+			} else {
+				feedError(-result);
+			}
+		}
+	#endif
+
 	static void onChannelConsumed(Channel *channel, unsigned int size) {
 		FdSourceChannel *self = static_cast<FdSourceChannel *>(channel);
 		self->consumedCallback = NULL;
 		if (self->acceptingInput()) {
+			#ifdef SERVER_KIT_HAVE_IO_URING
+				if (self->ctx->ioUring != NULL) {
+					if (self->ioUringOperation == 0) {
+						self->submitIoUringRead();
+					}
+					return;
+				}
+			#endif
 			ev_io_start(self->ctx->libev->getLoop(), &self->watcher);
 		}
 	}
 
 	void initialize() {
 		burstReadCount = 1;
+		readSizeHint = 0;
 		watcher.active = false;
 		watcher.fd = -1;
 		watcher.data = this;
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			ioUringOperation = 0;
+			pendingReadResult = 0;
+			hasPendingReadResult = false;
+		#endif
 	}
 
 public:
+	static const unsigned int MAX_READ_SIZE_HINT = 64 * 1024;
+
 	unsigned int burstReadCount;
+	/**
+	 * The number of bytes that the next read is expected to return, or 0.
+	 * If non-zero, read buffers come from the best-fitting mbuf size class
+	 * instead of the pool's default one (see `MemoryKit::mbuf_pool_for_size()`),
+	 * and the hint adapts to the sizes of past reads. This keeps clients that
+	 * only send small messages from each pinning a large buffer.
+	 *
+	 * Not used with io_uring, which reads into the ring's provided buffers.
+	 */
+	unsigned int readSizeHint;
 
 	FdSourceChannel() {
 		initialize();
@@ -157,6 +296,11 @@ public:
 		if (ctx != NULL && ev_is_active(&watcher)) {
 			ev_io_stop(ctx->libev->getLoop(), &watcher);
 		}
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ctx != NULL) {
+				cancelIoUringRead();
+			}
+		#endif
 	}
 
 	// May only be called right after construction.
@@ -172,9 +316,14 @@ public:
 
 	void deinitialize() {
 		buffer = MemoryKit::mbuf();
+		readSizeHint = 0;
 		if (ev_is_active(&watcher)) {
 			ev_io_stop(ctx->libev->getLoop(), &watcher);
 		}
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			cancelIoUringRead();
+			hasPendingReadResult = false;
+		#endif
 		watcher.fd = -1;
 		consumedCallback = NULL;
 		Channel::deinitialize();
@@ -182,6 +331,14 @@ public:
 
 	// May only be called right after the constructor or reinitialize().
 	void startReading() {
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ctx->ioUring != NULL) {
+				// The read is submitted together with the other
+				// operations of this event loop iteration.
+				startReadingInNextTick();
+				return;
+			}
+		#endif
 		startReadingInNextTick();
 		onReadableWithoutRefGuard();
 	}
@@ -189,6 +346,12 @@ public:
 	// May only be called right after the constructor or reinitialize().
 	void startReadingInNextTick() {
 		assert(Channel::acceptingInput());
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ctx->ioUring != NULL) {
+				submitIoUringRead();
+				return;
+			}
+		#endif
 		ev_io_start(ctx->libev->getLoop(), &watcher);
 	}
 
@@ -241,6 +404,11 @@ public:
 		Json::Value doc = Channel::inspectAsJson();
 		doc["initialized"] = watcher.fd != -1;
 		doc["io_watcher_active"] = (bool) watcher.active;
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ctx != NULL && ctx->ioUring != NULL) {
+				doc["io_uring_read_pending"] = ioUringOperation != 0;
+			}
+		#endif
 		return doc;
 	}
 };
@@ -32,11 +32,17 @@
 #include <boost/move/move.hpp>
 #include <boost/atomic.hpp>
 #include <sys/types.h>
+#include <fcntl.h>
 #include <uv.h>
+#ifdef __linux__
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
 #include <jsoncpp/json.h>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <cerrno>
 #include <algorithm>
 #include <utility>
 #include <string>
@@ -78,7 +84,11 @@ using namespace std;
  *
  * FileBufferedChannel operates by default in the in-memory mode. All data is buffered
  * in memory. Beyond a threshold (determined by `passedThreshold()`), it switches
- * to in-file mode.
+ * to in-file mode. The threshold is either fixed per channel, or determined by a
+ * memory budget that is shared between channels (see FileBufferedChannelMemoryBudget).
+ *
+ * In the in-file mode, buffers are moved to the file in batches of up to
+ * `config->maxBuffersPerWrite` buffers per vectored write.
  */
 class FileBufferedChannel: protected Channel {
 public:
@@ -201,6 +211,8 @@ public:
 	static const unsigned int MAX_MEMORY_BUFFERING = 4294967295u;
 	// `nbuffers` is 27-bit. This is 2^27-1.
 	static const unsigned int MAX_BUFFERS = 134217727;
+	// Upper limit for `config->maxBuffersPerWrite`. Well below IOV_MAX.
+	static const unsigned int MAX_BUFFERS_PER_WRITE = 64;
 
 
 private:
@@ -252,6 +264,10 @@ private:
 			  libuv(_self->ctx->libuv),
 			  logbase(_self)
 		{
+			// The request may be completed without ever being passed to
+			// libuv (e.g. memfd creation), so make sure uv_fs_req_cleanup()
+			// doesn't free garbage pointers.
+			memset(&req, 0, sizeof(req));
 			req.type = UV_UNKNOWN_REQ;
 			req.result = -1;
 			req.data = this;
@@ -374,6 +390,12 @@ private:
 		 */
 		boost::int64_t written;
 
+		/**
+		 * Number of write operations that the writer has started, for
+		 * inspection purposes.
+		 */
+		boost::uint64_t writeOperations;
+
 		InFileMode(uv_loop_t *_libuv)
 			: libuv(_libuv),
 			  fd(-1),
@@ -381,7 +403,8 @@ private:
 			  writerState(WS_INACTIVE),
 			  writerRequest(NULL),
 			  readOffset(0),
-			  written(0)
+			  written(0),
+			  writeOperations(0)
 			{ }
 
 		~InFileMode() {
@@ -458,6 +481,9 @@ private:
 
 	void clearBuffers(bool mayCallCallbacks) {
 		unsigned int oldNbuffers = nbuffers;
+		if (config != NULL && config->memoryBudget != NULL) {
+			config->memoryBudget->remove(bytesBuffered);
+		}
 		nbuffers = 0;
 		bytesBuffered = 0;
 		firstBuffer = MemoryKit::mbuf();
@@ -482,12 +508,18 @@ private:
 		}
 		nbuffers++;
 		bytesBuffered += buffer.size();
+		if (config->memoryBudget != NULL) {
+			config->memoryBudget->add(buffer.size());
+		}
 		FBC_DEBUG("pushBuffer() completed: nbuffers = " << nbuffers << ", bytesBuffered = " << bytesBuffered);
 	}
 
 	void popBuffer() {
 		assert(bytesBuffered >= firstBuffer.size());
 		bytesBuffered -= firstBuffer.size();
+		if (config->memoryBudget != NULL) {
+			config->memoryBudget->remove(firstBuffer.size());
+		}
 		nbuffers--;
 		FBC_DEBUG("popBuffer() completed: nbuffers = " << nbuffers << ", bytesBuffered = " << bytesBuffered);
 		if (moreBuffers.empty()) {
@@ -837,7 +869,7 @@ private:
 		FBC_DEBUG("Switching to in-file mode");
 		mode = IN_FILE_MODE;
 		inFileMode = boost::make_shared<InFileMode>(ctx->libuv);
-		createBufferFile();
+		createBufferFile(config->fileType);
 	}
 
 	/**
@@ -864,32 +896,31 @@ private:
 
 	struct FileCreationContext: public FileIOContext {
 		string path;
+		FileBufferedChannelFileType fileType;
 
 		FileCreationContext(FileBufferedChannel *self)
 			: FileIOContext(self)
 			{ }
 	};
 
-	void createBufferFile() {
+	void createBufferFile(FileBufferedChannelFileType fileType) {
 		P_ASSERT_EQ(mode, IN_FILE_MODE);
 		P_ASSERT_EQ(inFileMode->writerState, WS_INACTIVE);
 		P_ASSERT_EQ(inFileMode->fd, -1);
 
 		FileCreationContext *fcContext = new FileCreationContext(this);
+		fcContext->fileType = fileType;
 		fcContext->path = config->bufferDir;
-		fcContext->path.append("/buffer.");
-		fcContext->path.append(toString(rand()));
+		if (fileType == FBC_NAMED_FILE) {
+			fcContext->path.append("/buffer.");
+			fcContext->path.append(toString(rand()));
+		}
 
 		inFileMode->writerState = WS_CREATING_FILE;
 		inFileMode->writerRequest = fcContext;
 
 		if (config->delayInFileModeSwitching == 0) {
-			FBC_DEBUG("Writer: creating file " << fcContext->path);
-			int result = uv_fs_open(ctx->libuv, &fcContext->req,
-				fcContext->path.c_str(), O_RDWR | O_CREAT | O_EXCL,
-				0600, _bufferFileCreated);
-			if (result != 0) {
-				fcContext->req.result = result;
+			if (!startOpeningBufferFile(fcContext)) {
 				ctx->libev->runLater(boost::bind(_bufferFileCreated,
 					&fcContext->req));
 			}
@@ -901,6 +932,61 @@ private:
 		}
 	}
 
+	/**
+	 * Returns true if the file is being opened asynchronously, in which case
+	 * libuv calls `_bufferFileCreated()` when done. Otherwise, the file was
+	 * opened synchronously (memfd) or opening it failed, `fcContext->req.result`
+	 * contains the file descriptor or the negated error code, and the caller is
+	 * responsible for calling `_bufferFileCreated()`.
+	 */
+	bool startOpeningBufferFile(FileCreationContext *fcContext) {
+		int result;
+
+		if (fcContext->fileType == FBC_MEMFD) {
+			#if defined(__linux__) && defined(SYS_memfd_create)
+				FBC_DEBUG("Writer: creating memfd");
+				// 1 = MFD_CLOEXEC
+				result = syscall(SYS_memfd_create, "passenger-buffer", 1);
+				if (result != -1) {
+					fcContext->req.result = result;
+					return false;
+				}
+				FBC_DEBUG("Writer: cannot create memfd (errno=" << errno <<
+					"), falling back to a named file");
+			#endif
+			fcContext->fileType = FBC_NAMED_FILE;
+			fcContext->path.append("/buffer.");
+			fcContext->path.append(toString(rand()));
+		}
+
+		if (fcContext->fileType == FBC_UNNAMED_FILE) {
+			#ifdef O_TMPFILE
+				FBC_DEBUG("Writer: creating unnamed file in " << fcContext->path);
+				result = uv_fs_open(ctx->libuv, &fcContext->req,
+					fcContext->path.c_str(), O_RDWR | O_TMPFILE | O_EXCL,
+					0600, _bufferFileCreated);
+			#else
+				fcContext->fileType = FBC_NAMED_FILE;
+				fcContext->path.append("/buffer.");
+				fcContext->path.append(toString(rand()));
+			#endif
+		}
+
+		if (fcContext->fileType == FBC_NAMED_FILE) {
+			FBC_DEBUG("Writer: creating file " << fcContext->path);
+			result = uv_fs_open(ctx->libuv, &fcContext->req,
+				fcContext->path.c_str(), O_RDWR | O_CREAT | O_EXCL,
+				0600, _bufferFileCreated);
+		}
+
+		if (result != 0) {
+			fcContext->req.result = result;
+			return false;
+		} else {
+			return true;
+		}
+	}
+
 	static void _bufferFileDoneDelaying(FileCreationContext *fcContext) {
 		if (fcContext->isCanceled()) {
 			// We don't cleanup fcContext->req here because we didn't
@@ -914,13 +1000,8 @@ private:
 	}
 
 	void bufferFileDoneDelaying(FileCreationContext *fcContext) {
-		FBC_DEBUG("Writer: done delaying in-file mode switching. "
-			"Creating file: " << fcContext->path);
-		int result = uv_fs_open(ctx->libuv, &fcContext->req,
-			fcContext->path.c_str(), O_RDWR | O_CREAT | O_EXCL,
-			0600, _bufferFileCreated);
-		if (result != 0) {
-			fcContext->req.result = result;
+		FBC_DEBUG("Writer: done delaying in-file mode switching");
+		if (!startOpeningBufferFile(fcContext)) {
 			_bufferFileCreated(&fcContext->req);
 		}
 	}
@@ -934,8 +1015,12 @@ private:
 					"Writer: creation of file " << fcContext->path <<
 					"canceled. Deleting file in the background");
 				closeBufferFileInBackground(fcContext);
-				// Will take care of deleting fcContext
-				unlinkBufferFileInBackground(fcContext);
+				if (fcContext->fileType == FBC_NAMED_FILE) {
+					// Will take care of deleting fcContext
+					unlinkBufferFileInBackground(fcContext);
+				} else {
+					delete fcContext;
+				}
 			} else {
 				delete fcContext;
 			}
@@ -951,20 +1036,34 @@ private:
 		inFileMode->writerRequest = NULL;
 
 		if (fcContext->req.result >= 0) {
-			FBC_DEBUG("Writer: file created. Deleting file in the background");
 			P_LOG_FILE_DESCRIPTOR_OPEN4(fcContext->req.result, __FILE__, __LINE__,
 				"FileBufferedChannel buffer file");
 			inFileMode->fd = fcContext->req.result;
-			// Will take care of deleting fcContext
-			unlinkBufferFileInBackground(fcContext);
-			moveNextBufferToFile();
+			if (fcContext->fileType == FBC_NAMED_FILE) {
+				FBC_DEBUG("Writer: file created. Deleting file in the background");
+				// Will take care of deleting fcContext
+				unlinkBufferFileInBackground(fcContext);
+			} else {
+				FBC_DEBUG("Writer: file created");
+				delete fcContext;
+			}
+			moveNextBuffersToFile();
 		} else {
 			int errcode = -fcContext->req.result;
+			FileBufferedChannelFileType fileType = fcContext->fileType;
 			delete fcContext;
-			if (errcode == EEXIST) {
+			if (errcode == EEXIST && fileType == FBC_NAMED_FILE) {
 				FBC_DEBUG("Writer: file already exists, retrying");
 				inFileMode->writerState = WS_INACTIVE;
-				createBufferFile();
+				createBufferFile(FBC_NAMED_FILE);
+				verifyInvariants();
+			} else if (fileType == FBC_UNNAMED_FILE
+				&& (errcode == EOPNOTSUPP || errcode == EISDIR || errcode == EINVAL))
+			{
+				FBC_DEBUG("Writer: unnamed files are not supported, "
+					"falling back to a named file");
+				inFileMode->writerState = WS_INACTIVE;
+				createBufferFile(FBC_NAMED_FILE);
 				verifyInvariants();
 			} else {
 				setError(errcode, __FILE__, __LINE__);
@@ -1059,16 +1158,23 @@ private:
 		// Smart pointer to keep fd open until libuv operation
 		// is finished.
 		boost::shared_ptr<InFileMode> inFileMode;
-		MemoryKit::mbuf buffer;
-		uv_buf_t uvBuffer;
+		// Copies of the buffers at the front of the queue that are being
+		// written. They keep the data alive in case of cancellation.
+		MemoryKit::mbuf buffers[MAX_BUFFERS_PER_WRITE];
+		uv_buf_t uvBuffers[MAX_BUFFERS_PER_WRITE];
+		unsigned int nbuffers;
+		size_t size;
 		size_t written;
 
 		MoveContext(FileBufferedChannel *self)
-			: FileIOContext(self)
+			: FileIOContext(self),
+			  nbuffers(0),
+			  size(0),
+			  written(0)
 			{ }
 	};
 
-	void moveNextBufferToFile() {
+	void moveNextBuffersToFile() {
 		P_ASSERT_EQ(mode, IN_FILE_MODE);
 		assert(inFileMode->fd != -1);
 		verifyInvariants();
@@ -1083,31 +1189,77 @@ private:
 			return;
 		}
 
-		FBC_DEBUG("Writer: moving next buffer to file: " <<
-			peekBuffer().size() << " bytes");
-
 		MoveContext *moveContext = new MoveContext(this);
 		moveContext->inFileMode = inFileMode;
-		moveContext->buffer = peekBuffer();
-		moveContext->written = 0;
-		moveContext->uvBuffer = uv_buf_init(moveContext->buffer.start,
-			moveContext->buffer.size());
+		collectBuffersToMove(moveContext);
+		FBC_DEBUG("Writer: moving next " << moveContext->nbuffers <<
+			" buffer(s) to file: " << moveContext->size << " bytes");
 
 		inFileMode->writerState = WS_MOVING;
 		inFileMode->writerRequest = moveContext;
+		writeBuffersToFile(moveContext);
+		verifyInvariants();
+	}
+
+	/**
+	 * Takes buffers from the front of the queue, up to the first EOF
+	 * buffer, for moving to the file in a single write operation.
+	 */
+	void collectBuffersToMove(MoveContext *moveContext) {
+		unsigned int limit = config->maxBuffersPerWrite;
+		if (limit > MAX_BUFFERS_PER_WRITE) {
+			limit = MAX_BUFFERS_PER_WRITE;
+		} else if (limit == 0) {
+			limit = 1;
+		}
+		deque<MemoryKit::mbuf>::const_iterator it = moreBuffers.begin();
+		const MemoryKit::mbuf *buffer = &firstBuffer;
+
+		while (!buffer->empty()) {
+			moveContext->buffers[moveContext->nbuffers] = *buffer;
+			moveContext->nbuffers++;
+			moveContext->size += buffer->size();
+			if (moveContext->nbuffers == limit || it == moreBuffers.end()) {
+				break;
+			}
+			buffer = &(*it);
+			it++;
+		}
+	}
+
+	/**
+	 * Writes the part of the MoveContext's buffers that hasn't been
+	 * written yet.
+	 */
+	void writeBuffersToFile(MoveContext *moveContext) {
+		size_t skip = moveContext->written;
+		unsigned int nuvBuffers = 0;
+
+		for (unsigned int i = 0; i < moveContext->nbuffers; i++) {
+			const MemoryKit::mbuf &buffer = moveContext->buffers[i];
+			if (skip >= buffer.size()) {
+				skip -= buffer.size();
+			} else {
+				moveContext->uvBuffers[nuvBuffers] = uv_buf_init(
+					buffer.start + skip, buffer.size() - skip);
+				nuvBuffers++;
+				skip = 0;
+			}
+		}
+
+		inFileMode->writeOperations++;
 		int result = uv_fs_write(ctx->libuv, &moveContext->req, inFileMode->fd,
-			&moveContext->uvBuffer, 1,
-			inFileMode->readOffset + inFileMode->written,
-			_bufferWrittenToFile);
+			moveContext->uvBuffers, nuvBuffers,
+			inFileMode->readOffset + inFileMode->written + moveContext->written,
+			_buffersWrittenToFile);
 		if (result != 0) {
 			moveContext->req.result = result;
-			ctx->libev->runLater(boost::bind(_bufferWrittenToFile,
+			ctx->libev->runLater(boost::bind(_buffersWrittenToFile,
 				&moveContext->req));
 		}
-		verifyInvariants();
 	}
 
-	static void _bufferWrittenToFile(uv_fs_t *req) {
+	static void _buffersWrittenToFile(uv_fs_t *req) {
 		MoveContext *moveContext = static_cast<MoveContext *>(req->data);
 		uv_fs_req_cleanup(req);
 		if (moveContext->isCanceled()) {
@@ -1115,10 +1267,10 @@ private:
 			return;
 		}
 
-		moveContext->self->bufferWrittenToFile(moveContext);
+		moveContext->self->buffersWrittenToFile(moveContext);
 	}
 
-	void bufferWrittenToFile(MoveContext *moveContext) {
+	void buffersWrittenToFile(MoveContext *moveContext) {
 		P_ASSERT_EQ(mode, IN_FILE_MODE);
 		P_ASSERT_EQ(inFileMode->writerState, WS_MOVING);
 		assert(!peekBuffer().empty());
@@ -1126,43 +1278,34 @@ private:
 
 		if (moveContext->req.result >= 0) {
 			moveContext->written += moveContext->req.result;
-			assert(moveContext->written <= moveContext->buffer.size());
+			assert(moveContext->written <= moveContext->size);
 
-			if (moveContext->written == moveContext->buffer.size()) {
-				// Write completed. Proceed with next buffer.
+			if (moveContext->written == moveContext->size) {
+				// Write completed. Proceed with next buffers.
 				RefGuard guard(hooks, this, __FILE__, __LINE__);
 				unsigned int generation = this->generation;
 
 				FBC_DEBUG("Writer: move complete");
-				assert(peekBuffer().size() == moveContext->buffer.size());
-				inFileMode->written += moveContext->buffer.size();
+				for (unsigned int i = 0; i < moveContext->nbuffers; i++) {
+					assert(peekBuffer().size() == moveContext->buffers[i].size());
+					inFileMode->written += moveContext->buffers[i].size();
 
-				popBuffer();
-				if (generation != this->generation || mode >= ERROR) {
-					// buffersFlushedCallback deinitialized this object, or callback
-					// called a method that encountered an error.
-					delete moveContext;
-					return;
+					popBuffer();
+					if (generation != this->generation || mode >= ERROR) {
+						// buffersFlushedCallback deinitialized this object, or callback
+						// called a method that encountered an error.
+						delete moveContext;
+						return;
+					}
 				}
 
 				inFileMode->writerRequest = NULL;
 				delete moveContext;
-				moveNextBufferToFile();
+				moveNextBuffersToFile();
 			} else {
 				FBC_DEBUG("Writer: move incomplete, proceeding " <<
-					"with writing rest of buffer");
-				moveContext->uvBuffer = uv_buf_init(
-					moveContext->buffer.start + moveContext->written,
-					moveContext->buffer.size() - moveContext->written);
-				int result = uv_fs_write(ctx->libuv, &moveContext->req,
-					inFileMode->fd, &moveContext->uvBuffer, 1,
-					inFileMode->readOffset + inFileMode->written,
-					_bufferWrittenToFile);
-				if (result != 0) {
-					moveContext->req.result = result;
-					ctx->libev->runLater(boost::bind(_bufferWrittenToFile,
-						&moveContext->req));
-				}
+					"with writing rest of buffers");
+				writeBuffersToFile(moveContext);
 				verifyInvariants();
 			}
 		} else {
@@ -1388,6 +1531,8 @@ public:
 		if (mode == IN_FILE_MODE) {
 			cancelWriter();
 		}
+		// Return any buffered data to the memory budget.
+		clearBuffers(false);
 	}
 
 	// May only be called right after construction.
@@ -1425,7 +1570,7 @@ public:
 		        && inFileMode->writerState == WS_INACTIVE
 		        && config->autoStartMover)
 		{
-			moveNextBufferToFile();
+			moveNextBuffersToFile();
 		}
 		if (readerState == RS_INACTIVE) {
 			if (acceptingInput()) {
@@ -1539,7 +1684,12 @@ public:
 	}
 
 	bool passedThreshold() const {
-		return bytesBuffered >= config->threshold;
+		if (config->memoryBudget == NULL) {
+			return bytesBuffered >= config->threshold;
+		} else {
+			return bytesBuffered >= config->memoryBudget->minThreshold
+				&& config->memoryBudget->exhausted();
+		}
 	}
 
 	OXT_FORCE_INLINE
@@ -1594,6 +1744,7 @@ public:
 			doc["writer_state"] = getWriterStateString();
 			doc["read_offset"] = byteSizeToJson(inFileMode->readOffset);
 			doc["written"] = signedByteSizeToJson(inFileMode->written);
+			doc["write_operations"] = (Json::UInt64) inFileMode->writeOperations;
 			break;
 		case ERROR:
 			doc["mode"] = "ERROR";
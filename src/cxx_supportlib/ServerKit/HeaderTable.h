@@ -32,6 +32,7 @@
 
 #include <DataStructures/LString.h>
 #include <DataStructures/HashedStaticString.h>
+#include <ServerKit/KnownHeaders.h>
 #include <StaticString.h>
 
 namespace Passenger {
@@ -40,9 +41,6 @@ namespace ServerKit {
 using namespace std;
 
 
-extern const HashedStaticString HTTP_COOKIE;
-extern const HashedStaticString HTTP_SET_COOKIE;
-
 struct Header {
 	/** Downcased version of the key, for case-insensitive lookup. */
 	LString key;
@@ -50,6 +48,8 @@ struct Header {
 	LString origKey;
 	LString val;
 	boost::uint32_t hash;
+	/** A KnownHeaderId. Set by HeaderTable upon insertion. */
+	boost::uint8_t knownId;
 };
 
 
@@ -70,6 +70,9 @@ struct Header {
  * The hash table never shrinks in size, even after clear(), unless you explicitly call
  * compact(). This allows you to reuse hash table memory over multiple requests.
  *
+ * Headers with a well-known name (see KnownHeaders.h) are additionally indexed
+ * by their KnownHeaderId, so that looking them up by ID is a single array access.
+ *
  * This implementation is based on https://github.com/preshing/CompareIntegerMaps.
  * See also http://preshing.com/20130107/this-hash-table-is-faster-than-a-judy-array
  */
@@ -90,6 +93,7 @@ private:
 	Cell *m_cells;
 	boost::uint16_t m_arraySize;
 	boost::uint16_t m_population;
+	Header *m_known[KNOWN_HEADER_COUNT];
 
 	bool shouldRepopulateOnInsert() const {
 		return (m_population + 1) * 4 >= m_arraySize * 3;
@@ -111,16 +115,22 @@ private:
 		return v;
 	}
 
-	OXT_FORCE_INLINE
-	static bool isCookieHeader(const Header *header) {
-		return header->hash == HTTP_COOKIE.hash()
-			&& psg_lstr_cmp(&header->key, HTTP_COOKIE);
-	}
-
-	OXT_FORCE_INLINE
-	static bool isSetCookieHeader(const Header *header) {
-		return header->hash == HTTP_SET_COOKIE.hash()
-			&& psg_lstr_cmp(&header->key, HTTP_SET_COOKIE);
+	static KnownHeaderId identify(const Header *header) {
+		if (header->key.size == 0 || header->key.size > SERVER_KIT_KNOWN_HEADER_MAX_SIZE) {
+			return KNOWN_HEADER_NONE;
+		} else if (header->key.start == header->key.end) {
+			return lookupKnownHeaderId(header->key.start->data, header->key.size);
+		} else {
+			char buf[SERVER_KIT_KNOWN_HEADER_MAX_SIZE];
+			char *pos = buf;
+			const LString::Part *part = header->key.start;
+			while (part != NULL) {
+				memcpy(pos, part->data, part->size);
+				pos += part->size;
+				part = part->next;
+			}
+			return lookupKnownHeaderId(buf, header->key.size);
+		}
 	}
 
 	void repopulate(unsigned int desiredSize) {
@@ -166,6 +176,7 @@ private:
 		m_population = other.m_population;
 		m_cells      = new Cell[other.m_arraySize];
 		memcpy(m_cells, other.m_cells, other.m_arraySize * sizeof(Cell));
+		memcpy(m_known, other.m_known, sizeof(m_known));
 	}
 
 public:
@@ -199,6 +210,7 @@ public:
 			memset(m_cells, 0, sizeof(Cell) * m_arraySize);
 		}
 		m_population = 0;
+		memset(m_known, 0, sizeof(m_known));
 	}
 
 	const Cell *lookupCell(const HashedStaticString &key) const {
@@ -214,7 +226,9 @@ public:
 			if (cellIsEmpty(cell)) {
 				// Empty cell found.
 				return NULL;
-			} else if (psg_lstr_cmp(&cell->header->key, key)) {
+			} else if (cell->header->hash == key.hash()
+				&& psg_lstr_cmp(&cell->header->key, key))
+			{
 				// Non-empty cell found.
 				return cell;
 			} else {
@@ -253,6 +267,27 @@ public:
 		return const_cast<LString *>(static_cast<const HeaderTable *>(this)->lookup(key));
 	}
 
+	OXT_FORCE_INLINE
+	Header *lookupHeader(KnownHeaderId id) {
+		assert(id != KNOWN_HEADER_NONE && id < KNOWN_HEADER_COUNT);
+		return m_known[id];
+	}
+
+	OXT_FORCE_INLINE
+	const LString *lookup(KnownHeaderId id) const {
+		assert(id != KNOWN_HEADER_NONE && id < KNOWN_HEADER_COUNT);
+		if (m_known[id] != NULL) {
+			return &m_known[id]->val;
+		} else {
+			return NULL;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	LString *lookup(KnownHeaderId id) {
+		return const_cast<LString *>(static_cast<const HeaderTable *>(this)->lookup(id));
+	}
+
 	/**
 	 * HeaderTable takes over ownership of `header`. But you must ensure that the pool
 	 * that the header was allocated from is not destroyed before the HeaderTable
@@ -278,14 +313,18 @@ public:
 					}
 					m_population++;
 
+					header->knownId = identify(header);
+					if (header->knownId != KNOWN_HEADER_NONE) {
+						m_known[header->knownId] = header;
+					}
 					cell->header = header;
 					*headerPtr = NULL;
 					return;
 				} else if (psg_lstr_cmp(&cell->header->key, &header->key)) {
 					// Cell matches, so merge value into header.
-					if (isCookieHeader(header)) {
+					if (cell->header->knownId == KNOWN_HEADER_COOKIE) {
 						psg_lstr_append(&cell->header->val, pool, ";", 1);
-					} else if (isSetCookieHeader(header)) {
+					} else if (cell->header->knownId == KNOWN_HEADER_SET_COOKIE) {
 						psg_lstr_append(&cell->header->val, pool, "\n", 1);
 					} else {
 						psg_lstr_append(&cell->header->val, pool, ",", 1);
@@ -329,6 +368,10 @@ public:
 		assert(cell >= m_cells && cell - m_cells < m_arraySize);
 		assert(!cellIsEmpty(cell));
 
+		if (cell->header->knownId != KNOWN_HEADER_NONE) {
+			m_known[cell->header->knownId] = NULL;
+		}
+
 		// Remove this cell by shuffling neighboring cells so there are no gaps in anyone's probe chain
 		Cell *neighbor = PHT_CIRCULAR_NEXT(cell);
 		while (true) {
@@ -372,10 +415,22 @@ public:
 		}
 	}
 
+	void erase(KnownHeaderId id) {
+		Header *header = lookupHeader(id);
+		if (header != NULL) {
+			Cell *cell = PHT_FIRST_CELL(header->hash);
+			while (cell->header != header) {
+				cell = PHT_CIRCULAR_NEXT(cell);
+			}
+			erase(cell);
+		}
+	}
+
 	/** Does not resize the array. */
 	void clear() {
 		if (m_cells != NULL && m_population != 0) {
 			memset(m_cells, 0, sizeof(Cell) * m_arraySize);
+			memset(m_known, 0, sizeof(m_known));
 		}
 		m_population = 0;
 	}
@@ -385,6 +440,7 @@ public:
 		m_cells = NULL;
 		m_arraySize  = 0;
 		m_population = 0;
+		memset(m_known, 0, sizeof(m_known));
 	}
 
 	void compact() {
@@ -29,6 +29,7 @@
 #include <psg_sysqueue.h>
 #include <ServerKit/Client.h>
 #include <ServerKit/HttpRequest.h>
+#include <ServerKit/TimerWheel.h>
 
 namespace Passenger {
 namespace ServerKit {
@@ -48,6 +49,8 @@ public:
 	 */
 	Request *currentRequest;
 	unsigned int requestsBegun;
+	/** Keep-alive, header read or body read timeout, whichever applies. */
+	TimerWheel::Timer timeoutTimer;
 
 	BaseHttpClient(void *server)
 		: BaseClient(server),
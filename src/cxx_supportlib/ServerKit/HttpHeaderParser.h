@@ -44,12 +44,6 @@
 namespace Passenger {
 namespace ServerKit {
 
-
-extern const HashedStaticString HTTP_CONTENT_LENGTH;
-extern const HashedStaticString HTTP_TRANSFER_ENCODING;
-extern const HashedStaticString HTTP_X_SENDFILE;
-extern const HashedStaticString HTTP_X_ACCEL_REDIRECT;
-
 struct HttpParseRequest {};
 struct HttpParseResponse {};
 
@@ -371,8 +365,8 @@ private:
 			message->httpState = Message::UPGRADED;
 			message->bodyType  = Message::RBT_UPGRADE;
 			message->wantKeepAlive = false;
-		} else if (message->headers.lookup(HTTP_X_SENDFILE) != NULL
-		 || message->headers.lookup(HTTP_X_ACCEL_REDIRECT) != NULL)
+		} else if (message->headers.lookup(KNOWN_HEADER_X_SENDFILE) != NULL
+		 || message->headers.lookup(KNOWN_HEADER_X_ACCEL_REDIRECT) != NULL)
 		{
 			// If X-Sendfile or X-Accel-Redirect is set, pretend like the body
 			// is empty and disallow keep-alive. See:
@@ -389,8 +383,8 @@ private:
 			// ForwardResponse.cpp.
 			message->httpState = Message::COMPLETE;
 			message->bodyType = Message::RBT_NO_BODY;
-			message->headers.erase(HTTP_CONTENT_LENGTH);
-			message->headers.erase(HTTP_TRANSFER_ENCODING);
+			message->headers.erase(KNOWN_HEADER_CONTENT_LENGTH);
+			message->headers.erase(KNOWN_HEADER_TRANSFER_ENCODING);
 			message->wantKeepAlive = false;
 		} else if (requestMethod == HTTP_HEAD
 		 || status / 100 == 1  // status 1xx
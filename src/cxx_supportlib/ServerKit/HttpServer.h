@@ -32,6 +32,7 @@
 #include <oxt/macros.hpp>
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <cassert>
 #include <pthread.h>
@@ -66,6 +67,10 @@ private:
 		using namespace ConfigKit;
 
 		add("request_freelist_limit", UINT_TYPE, OPTIONAL, 1024);
+		// Timeouts in seconds. 0 means no timeout.
+		add("client_keepalive_timeout", UINT_TYPE, OPTIONAL, 0);
+		add("client_header_timeout", UINT_TYPE, OPTIONAL, 0);
+		add("client_body_timeout", UINT_TYPE, OPTIONAL, 0);
 	}
 
 public:
@@ -85,13 +90,22 @@ public:
 
 struct HttpServerConfigRealization {
 	unsigned int requestFreelistLimit;
+	unsigned int clientKeepaliveTimeout;
+	unsigned int clientHeaderTimeout;
+	unsigned int clientBodyTimeout;
 
 	HttpServerConfigRealization(const ConfigKit::Store &config)
-		: requestFreelistLimit(config["request_freelist_limit"].asUInt())
+		: requestFreelistLimit(config["request_freelist_limit"].asUInt()),
+		  clientKeepaliveTimeout(config["client_keepalive_timeout"].asUInt()),
+		  clientHeaderTimeout(config["client_header_timeout"].asUInt()),
+		  clientBodyTimeout(config["client_body_timeout"].asUInt())
 		{ }
 
 	void swap(HttpServerConfigRealization &other) BOOST_NOEXCEPT_OR_NOTHROW {
 		std::swap(requestFreelistLimit, other.requestFreelistLimit);
+		std::swap(clientKeepaliveTimeout, other.clientKeepaliveTimeout);
+		std::swap(clientHeaderTimeout, other.clientHeaderTimeout);
+		std::swap(clientBodyTimeout, other.clientBodyTimeout);
 	}
 };
 
@@ -147,6 +161,14 @@ private:
 
 	/***** Configuration *****/
 
+	/** The expected size of a new client's first read: a small request header. */
+	static const unsigned int INITIAL_READ_SIZE_HINT = 256;
+	static const size_t MAX_REQUEST_POOL_SIZE = 256 * 1024;
+	/** Buckets of < 4 KB, < 8 KB, ..., < 256 KB and >= 256 KB. */
+	static const unsigned int REQUEST_POOL_USAGE_HISTOGRAM_SIZE = 8;
+	/** Buckets of 0, 1, 2-3, 4-7 and >= 8 large allocations. */
+	static const unsigned int REQUEST_POOL_LARGE_ALLOC_HISTOGRAM_SIZE = 5;
+
 	HttpServerConfigRealization configRlz;
 
 
@@ -155,6 +177,13 @@ private:
 	RequestHooksImpl requestHooksImpl;
 	object_pool<HttpHeaderParserState> headerParserStatePool;
 
+	/** Block size for new request palloc pools; see recycleRequestPool(). */
+	size_t requestPoolSize;
+	double requestPoolUsageAverage;
+	double requestPoolMaxAllocAverage;
+	unsigned long requestPoolUsageHistogram[REQUEST_POOL_USAGE_HISTOGRAM_SIZE];
+	unsigned long requestPoolLargeAllocHistogram[REQUEST_POOL_LARGE_ALLOC_HISTOGRAM_SIZE];
+
 
 	/***** Request object creation and destruction *****/
 
@@ -246,12 +275,102 @@ private:
 	}
 
 
+	/***** Request pool management *****/
+
+	/**
+	 * Resets the request's palloc pool so that the request object, which
+	 * is kept in the freelist, reuses it for the next request. Because each
+	 * server runs on a single thread, this freelist acts as a per-thread cache
+	 * of pools.
+	 *
+	 * The pool is destroyed instead if it had to grow beyond a single block,
+	 * or if its size no longer matches `requestPoolSize`. That size follows a
+	 * moving average of how much memory requests actually use, so that in the
+	 * steady state requests neither allocate extra blocks nor large objects.
+	 */
+	void recycleRequestPool(Request *req) {
+		size_t used = psg_pool_used_size(req->pool);
+		size_t blockSize = psg_pool_block_size(req->pool);
+
+		if (used > 0) {
+			recordRequestPoolUsage(used, req->pool->nlarge, req->pool->max_alloc_size);
+		}
+		if (!psg_reset_pool(req->pool, blockSize) || blockSize != requestPoolSize) {
+			psg_destroy_pool(req->pool);
+			req->pool = NULL;
+		}
+	}
+
+	void recordRequestPoolUsage(size_t used, unsigned int nlarge, size_t maxAllocSize) {
+		unsigned int i;
+		size_t bound;
+
+		for (i = 0, bound = 4096; i < REQUEST_POOL_USAGE_HISTOGRAM_SIZE - 1 && used >= bound; i++) {
+			bound *= 2;
+		}
+		requestPoolUsageHistogram[i]++;
+
+		for (i = 0; i < REQUEST_POOL_LARGE_ALLOC_HISTOGRAM_SIZE - 1 && nlarge > 0; i++) {
+			nlarge /= 2;
+		}
+		requestPoolLargeAllocHistogram[i]++;
+
+		// Leave 50% headroom on top of the average usage, make blocks
+		// large enough to serve the typical largest allocation (see
+		// psg_create_pool()), and only use powers of two so that small
+		// fluctuations don't cause pools to be recreated.
+		requestPoolUsageAverage = expMovingAverage(requestPoolUsageAverage,
+			used, 0.05);
+		requestPoolMaxAllocAverage = expMovingAverage(requestPoolMaxAllocAverage,
+			maxAllocSize, 0.05);
+		requestPoolSize = PSG_DEFAULT_POOL_SIZE;
+		while (requestPoolSize < MAX_REQUEST_POOL_SIZE
+			&& (requestPoolSize < requestPoolUsageAverage * 1.5 + sizeof(psg_pool_t)
+			 || (requestPoolSize - sizeof(psg_pool_t)) / 4 < requestPoolMaxAllocAverage))
+		{
+			requestPoolSize *= 2;
+		}
+	}
+
+	Json::Value inspectRequestPoolsAsJson() const {
+		Json::Value doc;
+		Json::Value usageHistogram(Json::arrayValue);
+		Json::Value largeAllocHistogram(Json::arrayValue);
+		unsigned int i;
+		size_t bound;
+
+		for (i = 0, bound = 0; i < REQUEST_POOL_USAGE_HISTOGRAM_SIZE; i++) {
+			Json::Value bucket;
+			bucket["min_size"] = byteSizeToJson(bound);
+			bucket["count"] = (Json::UInt64) requestPoolUsageHistogram[i];
+			usageHistogram.append(bucket);
+			bound = (bound == 0) ? 4096 : bound * 2;
+		}
+		for (i = 0, bound = 0; i < REQUEST_POOL_LARGE_ALLOC_HISTOGRAM_SIZE; i++) {
+			Json::Value bucket;
+			bucket["min_large_allocations"] = (Json::UInt) bound;
+			bucket["count"] = (Json::UInt64) requestPoolLargeAllocHistogram[i];
+			largeAllocHistogram.append(bucket);
+			bound = (bound == 0) ? 1 : bound * 2;
+		}
+
+		doc["pool_size"] = byteSizeToJson(requestPoolSize);
+		if (requestPoolUsageAverage != -1) {
+			doc["average_usage"] = byteSizeToJson(requestPoolUsageAverage);
+		}
+		doc["usage_histogram"] = usageHistogram;
+		doc["large_allocations_histogram"] = largeAllocHistogram;
+		return doc;
+	}
+
+
 	/***** Request deinitialization and preparation for next request *****/
 
 	void deinitializeRequestAndAddToFreelist(Client *client, Request *req) {
 		assert(client->currentRequest == req);
 
 		if (req->httpState != Request::WAITING_FOR_REFERENCES) {
+			cancelClientTimeout(client);
 			req->httpState = Request::WAITING_FOR_REFERENCES;
 			deinitializeRequest(client, req);
 			assert(req->ended());
@@ -271,10 +390,7 @@ private:
 		P_ASSERT_EQ(req->httpState, Request::WAITING_FOR_REFERENCES);
 		assert(req->pool != NULL);
 		c->currentRequest = NULL;
-		if (!psg_reset_pool(req->pool, PSG_DEFAULT_POOL_SIZE)) {
-			psg_destroy_pool(req->pool);
-			req->pool = NULL;
-		}
+		recycleRequestPool(req);
 		unrefRequest(req, __FILE__, __LINE__);
 		if (keepAlive) {
 			SKC_TRACE(c, 3, "Keeping alive connection, handling next request");
@@ -303,6 +419,68 @@ private:
 		client->currentRequest = req = checkoutRequestObject(client);
 		req->client = client;
 		reinitializeRequest(client, req);
+
+		if (client->requestsBegun == 0) {
+			scheduleClientTimeout(client, configRlz.clientHeaderTimeout);
+		} else {
+			scheduleClientTimeout(client, configRlz.clientKeepaliveTimeout);
+		}
+	}
+
+
+	/***** Client timeouts *****/
+
+	/**
+	 * Arms the client's timeout timer with the given timeout in seconds,
+	 * or disarms it if the timeout is 0. Timeouts are re-armed on every read,
+	 * so they are kept in the context's TimerWheel instead of in libev timers.
+	 */
+	void scheduleClientTimeout(Client *client, unsigned int timeout) {
+		if (timeout == 0) {
+			cancelClientTimeout(client);
+		} else {
+			this->getContext()->timerWheel.schedule(&client->timeoutTimer, timeout);
+		}
+	}
+
+	OXT_FORCE_INLINE
+	void cancelClientTimeout(Client *client) {
+		this->getContext()->timerWheel.cancel(&client->timeoutTimer);
+	}
+
+	static void onClientTimeout(TimerWheel::Timer *timer) {
+		Client *client   = static_cast<Client *>(static_cast<BaseClient *>(timer->userData));
+		HttpServer *self = static_cast<HttpServer *>(HttpServer::getServerFromClient(client));
+		self->handleClientTimeout(client);
+	}
+
+	void handleClientTimeout(Client *client) {
+		Request *req = client->currentRequest;
+		if (req == NULL || req->ended()) {
+			return;
+		}
+
+		if (req->httpState == Request::PARSING_HEADERS) {
+			if (client->requestsBegun > 0 && req->lastDataReceiveTime == 0) {
+				SKC_DEBUG(client, "Keep-alive timeout reached; disconnecting client");
+			} else {
+				SKC_INFO(client, "Timed out while receiving the request header; "
+					"disconnecting client");
+			}
+			this->disconnect(&client);
+		} else if (req->bodyFullyRead()) {
+			return;
+		} else if ((req->bodyChannel.consumedCallback != NULL || !client->input.isStarted())
+			&& !isReadingRequestBodyDirectly(client, req))
+		{
+			// We have stopped reading the body because the body channel's
+			// consumer is busy, so the client isn't the one being slow.
+			scheduleClientTimeout(client, configRlz.clientBodyTimeout);
+		} else {
+			SKC_INFO(client, "Timed out while receiving the request body; "
+				"disconnecting client");
+			this->disconnect(&client);
+		}
 	}
 
 
@@ -330,6 +508,20 @@ private:
 			headerParserStatePool.destroy(req->parserState.headerParser);
 			req->parserState.headerParser = NULL;
 
+			if (req->httpState == Request::PARSING_BODY
+			 || req->httpState == Request::PARSING_CHUNKED_BODY)
+			{
+				scheduleClientTimeout(client, configRlz.clientBodyTimeout);
+				if (req->bodyType == Request::RBT_CONTENT_LENGTH) {
+					// Read the body into buffers that fit it.
+					client->input.readSizeHint = std::min<boost::uint64_t>(
+						req->aux.bodyInfo.contentLength,
+						FdSourceChannel::MAX_READ_SIZE_HINT);
+				}
+			} else {
+				cancelClientTimeout(client);
+			}
+
 			if (HttpServer::serverState == HttpServer::SHUTTING_DOWN
 			 && shouldDisconnectClientOnShutdown(client))
 			{
@@ -404,6 +596,11 @@ private:
 			assert(maxRemaining > 0);
 			remaining = std::min<boost::uint64_t>(buffer.size(), maxRemaining);
 			req->bodyAlreadyRead += remaining;
+			if (req->bodyFullyRead()) {
+				cancelClientTimeout(client);
+			} else {
+				scheduleClientTimeout(client, configRlz.clientBodyTimeout);
+			}
 			SKC_TRACE(client, 3, "Request body: " <<
 				req->bodyAlreadyRead << " of " <<
 				req->aux.bodyInfo.contentLength << " bytes already read");
@@ -463,6 +660,11 @@ private:
 
 			HttpChunkedEvent event(createChunkedBodyParser(req).feed(buffer));
 			req->bodyAlreadyRead += event.consumed;
+			if (event.end) {
+				cancelClientTimeout(client);
+			} else {
+				scheduleClientTimeout(client, configRlz.clientBodyTimeout);
+			}
 
 			switch (event.type) {
 			case HttpChunkedEvent::NONE:
@@ -742,6 +944,8 @@ protected:
 	virtual void onClientObjectCreated(Client *client) {
 		ParentClass::onClientObjectCreated(client);
 		client->output.setDataFlushedCallback(_onClientOutputDataFlushed);
+		client->timeoutTimer.callback = onClientTimeout;
+		client->timeoutTimer.userData = static_cast<BaseClient *>(client);
 	}
 
 	virtual void onClientAccepted(Client *client) {
@@ -760,6 +964,14 @@ protected:
 		bool ended = req->ended();
 
 		if (!ended) {
+			if (req->httpState == Request::PARSING_HEADERS
+			 && req->lastDataReceiveTime == 0
+			 && client->requestsBegun > 0)
+			{
+				// The keep-alive period is over and a new request header
+				// is coming in.
+				scheduleClientTimeout(client, configRlz.clientHeaderTimeout);
+			}
 			req->lastDataReceiveTime = ev_now(this->getLoop());
 		}
 		if (detectNextRequestEarlyReadError(client, req, buffer, errcode)) {
@@ -803,6 +1015,7 @@ protected:
 
 	virtual void onClientDisconnecting(Client *client) {
 		ParentClass::onClientDisconnecting(client);
+		cancelClientTimeout(client);
 
 		// Handle client being disconnect()'ed without endRequest().
 
@@ -880,6 +1093,18 @@ protected:
 		return false;
 	}
 
+	/**
+	 * Whether the subclass is reading the request body directly from the
+	 * client socket (e.g. with splice()) instead of through `client->input`,
+	 * and is waiting for the client to send more of it. The request body
+	 * timeout is then enforced even though `client->input` is stopped.
+	 * Subclasses that return true must call `rearmRequestBodyTimeout()`
+	 * whenever they make progress reading the body.
+	 */
+	virtual bool isReadingRequestBodyDirectly(Client *client, Request *req) {
+		return false;
+	}
+
 	virtual LoggingKit::Level getClientOutputErrorDisconnectionLogLevel(
 		Client *client, int errcode) const
 	{
@@ -892,6 +1117,9 @@ protected:
 
 	virtual void reinitializeClient(Client *client, int fd) {
 		ParentClass::reinitializeClient(client, fd);
+		// Most request headers fit in a small buffer. From there on, the
+		// channel adapts the hint to how much the client actually sends.
+		client->input.readSizeHint = INITIAL_READ_SIZE_HINT;
 		client->requestsBegun = 0;
 		assert(client->currentRequest == NULL);
 	}
@@ -910,7 +1138,7 @@ protected:
 		if (OXT_UNLIKELY(req->pool == NULL)) {
 			// We assume that most of the time, the pool from the
 			// last request is reset and reused.
-			req->pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+			req->pool = psg_create_pool(requestPoolSize);
 		}
 		psg_lstr_init(&req->path);
 		req->bodyChannel.reinitialize();
@@ -953,9 +1181,8 @@ protected:
 			it.next();
 		}
 
-		if (req->pool != NULL && !psg_reset_pool(req->pool, PSG_DEFAULT_POOL_SIZE)) {
-			psg_destroy_pool(req->pool);
-			req->pool = NULL;
+		if (req->pool != NULL) {
+			recycleRequestPool(req);
 		}
 
 		req->httpState = Request::WAITING_FOR_REFERENCES;
@@ -983,9 +1210,14 @@ public:
 		  requestBeginSpeed1m(-1),
 		  requestBeginSpeed1h(-1),
 		  configRlz(ParentClass::config),
-		  headerParserStatePool(16, 256)
+		  headerParserStatePool(16, 256),
+		  requestPoolSize(PSG_DEFAULT_POOL_SIZE),
+		  requestPoolUsageAverage(-1),
+		  requestPoolMaxAllocAverage(-1)
 	{
 		STAILQ_INIT(&freeRequests);
+		memset(requestPoolUsageHistogram, 0, sizeof(requestPoolUsageHistogram));
+		memset(requestPoolLargeAllocHistogram, 0, sizeof(requestPoolLargeAllocHistogram));
 	}
 
 
@@ -1225,6 +1457,14 @@ public:
 	}
 
 
+	/**
+	 * Re-arms the client_body_timeout. See `isReadingRequestBodyDirectly()`.
+	 */
+	void rearmRequestBodyTimeout(Client *client) {
+		scheduleClientTimeout(client, configRlz.clientBodyTimeout);
+	}
+
+
 	/***** Configuration and introspection *****/
 
 	bool prepareConfigChange(const Json::Value &updates,
@@ -1253,6 +1493,7 @@ public:
 		doc["request_begin_speed"]["1h"] = averageSpeedToJson(
 			capFloatPrecision(requestBeginSpeed1h * 60),
 			"minute", "1 hour", -1);
+		doc["request_pools"] = inspectRequestPoolsAsJson();
 		return doc;
 	}
 
@@ -23,19 +23,16 @@
  *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  *  THE SOFTWARE.
  */
+#include <cstdio>
+#include <cstdlib>
 #include <DataStructures/HashedStaticString.h>
+#include <ServerKit/KnownHeaders.h>
 
 namespace Passenger {
 namespace ServerKit {
 
 
 // Define 'extern' so that the compiler doesn't output warnings.
-extern const HashedStaticString HTTP_COOKIE;
-extern const HashedStaticString HTTP_SET_COOKIE;
-extern const HashedStaticString HTTP_CONTENT_LENGTH;
-extern const HashedStaticString HTTP_TRANSFER_ENCODING;
-extern const HashedStaticString HTTP_X_SENDFILE;
-extern const HashedStaticString HTTP_X_ACCEL_REDIRECT;
 extern const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[];
 extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
 
@@ -48,12 +45,43 @@ const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[] =
 	"Internal server error\n";
 const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE =
 	sizeof(DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE) - 1;
-const HashedStaticString HTTP_COOKIE("cookie");
-const HashedStaticString HTTP_SET_COOKIE("set-cookie");
-const HashedStaticString HTTP_CONTENT_LENGTH("content-length");
-const HashedStaticString HTTP_TRANSFER_ENCODING("transfer-encoding");
-const HashedStaticString HTTP_X_SENDFILE("x-sendfile");
-const HashedStaticString HTTP_X_ACCEL_REDIRECT("x-accel-redirect");
+
+const StaticString KNOWN_HEADER_NAMES[KNOWN_HEADER_COUNT] = {
+	StaticString(),
+	#define SERVER_KIT_KNOWN_HEADER_NAME(id, name) StaticString(name, sizeof(name) - 1),
+	SERVER_KIT_KNOWN_HEADERS(SERVER_KIT_KNOWN_HEADER_NAME)
+	#undef SERVER_KIT_KNOWN_HEADER_NAME
+};
+boost::uint8_t knownHeaderSlots[SERVER_KIT_KNOWN_HEADER_SLOTS];
+
+static struct KnownHeaderSlotsInitializer {
+	KnownHeaderSlotsInitializer() {
+		// This runs before main() and LoggingKit, so report problems
+		// to stderr directly. Release builds must fail here too: a
+		// collision would make lookupKnownHeaderId() silently miss a
+		// known header.
+		for (unsigned int i = 1; i < KNOWN_HEADER_COUNT; i++) {
+			const StaticString &name = KNOWN_HEADER_NAMES[i];
+			if (name.size() > SERVER_KIT_KNOWN_HEADER_MAX_SIZE) {
+				fprintf(stderr, "BUG: known header name '%s' is longer than "
+					"SERVER_KIT_KNOWN_HEADER_MAX_SIZE (%d)\n",
+					name.data(), SERVER_KIT_KNOWN_HEADER_MAX_SIZE);
+				abort();
+			}
+
+			unsigned int slot = knownHeaderSlot(name.data(), name.size());
+			if (knownHeaderSlots[slot] != KNOWN_HEADER_NONE) {
+				fprintf(stderr, "BUG: knownHeaderSlot() is not a perfect hash: "
+					"known headers '%s' and '%s' both map to slot %u. Update "
+					"the multipliers in ServerKit/KnownHeaders.h\n",
+					KNOWN_HEADER_NAMES[knownHeaderSlots[slot]].data(),
+					name.data(), slot);
+				abort();
+			}
+			knownHeaderSlots[slot] = (boost::uint8_t) i;
+		}
+	}
+} knownHeaderSlotsInitializer;
 
 
 } // namespace ServerKit
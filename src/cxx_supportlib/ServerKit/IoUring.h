@@ -0,0 +1,529 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_IO_URING_H_
+#define _PASSENGER_SERVER_KIT_IO_URING_H_
+
+#if defined(__linux__) && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+		#include <linux/io_uring.h>
+		// Multishot accept and provided buffer rings were introduced at the
+		// same time (Linux 5.19). Older headers lack the former.
+		#ifdef IORING_ACCEPT_MULTISHOT
+			#define SERVER_KIT_HAVE_IO_URING
+		#endif
+	#endif
+#endif
+
+#ifdef SERVER_KIT_HAVE_IO_URING
+
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <cerrno>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <ev.h>
+#include <jsoncpp/json.h>
+#include <MemoryKit/mbuf.h>
+#include <Exceptions.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+/**
+ * An io_uring instance that is driven by a libev event loop, as an
+ * alternative to readiness notification plus one system call per I/O
+ * event. Operations that are started during an event loop iteration are
+ * submitted together right before the loop polls for events, and their
+ * completions are processed together when the ring's file descriptor
+ * becomes readable.
+ *
+ * Reads use a ring of provided buffers which are taken directly from the
+ * `mbuf_pool`, so that a completed read is passed on as an mbuf without
+ * copying. The buffer is replaced with a fresh mbuf block right away.
+ *
+ * Each operation is identified by a non-zero number. Cancelling an
+ * operation detaches its callback immediately, so the caller may reuse or
+ * destroy the callback's user data right away.
+ *
+ * Not thread-safe; may only be used from the event loop's thread.
+ */
+class IoUring {
+public:
+	/**
+	 * Called for every completion of an operation. `buffer` contains the
+	 * data read, if the operation was a read that returned data. The
+	 * callback may take it over. If `IORING_CQE_F_MORE` is not set in
+	 * `cqe->flags` then this is the operation's last completion.
+	 */
+	typedef void (*Callback)(IoUring *ring, const struct io_uring_cqe *cqe,
+		MemoryKit::mbuf &buffer, void *userData);
+
+	enum {
+		QUEUE_DEPTH = 1024,
+		BUFFER_COUNT = 512,
+		BUFFER_GROUP_ID = 0
+	};
+
+private:
+	struct Operation {
+		Callback callback;
+		void *userData;
+		unsigned int nextFree;
+		boost::uint8_t opcode;
+	};
+
+	struct ev_loop *loop;
+	struct MemoryKit::mbuf_pool *pool;
+	int fd;
+
+	void *sqRing, *cqRing;
+	size_t sqRingSize, cqRingSize;
+	struct io_uring_sqe *sqes;
+	size_t sqesSize;
+	unsigned int *sqHead, *sqTail, *sqArray;
+	unsigned int sqMask, sqEntries, sqLocalTail, sqSubmitted;
+	unsigned int *cqHead, *cqTail;
+	unsigned int cqMask;
+	struct io_uring_cqe *cqes;
+
+	// We don't use `struct io_uring_buf_ring` because its flexible array
+	// member has a different layout in C++. The ring's tail overlaps the
+	// reserved field of the first entry.
+	struct io_uring_buf *bufferRing;
+	size_t bufferRingSize;
+	unsigned short bufferRingTail;
+	MemoryKit::mbuf buffers[BUFFER_COUNT];
+
+	vector<Operation> operations;
+	unsigned int freeOperation;
+	unsigned int pendingOperations;
+
+	struct ev_io completionWatcher;
+	struct ev_prepare submissionWatcher;
+
+	static int callSetup(unsigned int entries, struct io_uring_params *params) {
+		return (int) syscall(__NR_io_uring_setup, entries, params);
+	}
+
+	static int callEnter(int fd, unsigned int toSubmit, unsigned int minComplete,
+		unsigned int flags)
+	{
+		return (int) syscall(__NR_io_uring_enter, fd, toSubmit, minComplete,
+			flags, NULL, 0);
+	}
+
+	static int callRegister(int fd, unsigned int opcode, void *arg, unsigned int nargs) {
+		return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nargs);
+	}
+
+	static void *mapRing(int fd, size_t size, off_t offset) {
+		void *result = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, offset);
+		if (result == MAP_FAILED) {
+			int e = errno;
+			throw SystemException("Cannot map an io_uring ring", e);
+		}
+		return result;
+	}
+
+	static void _onCompletionsAvailable(EV_P_ struct ev_io *io, int revents) {
+		static_cast<IoUring *>(io->data)->processCompletions();
+	}
+
+	static void _onBeforePoll(EV_P_ struct ev_prepare *prepare, int revents) {
+		static_cast<IoUring *>(prepare->data)->submit();
+	}
+
+	void setup() {
+		struct io_uring_params params;
+
+		memset(&params, 0, sizeof(params));
+		params.flags = IORING_SETUP_CQSIZE;
+		// Multishot accepts can produce many completions per submission.
+		params.cq_entries = QUEUE_DEPTH * 4;
+		fd = callSetup(QUEUE_DEPTH, &params);
+		if (fd == -1) {
+			int e = errno;
+			throw SystemException("Cannot create an io_uring instance", e);
+		}
+
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP) {
+			sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+		}
+		sqRing = mapRing(fd, sqRingSize, IORING_OFF_SQ_RING);
+		if (params.features & IORING_FEAT_SINGLE_MMAP) {
+			cqRing = sqRing;
+		} else {
+			cqRing = mapRing(fd, cqRingSize, IORING_OFF_CQ_RING);
+		}
+		sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+		sqes = (struct io_uring_sqe *) mapRing(fd, sqesSize, IORING_OFF_SQES);
+
+		char *sq = (char *) sqRing;
+		sqHead  = (unsigned int *) (sq + params.sq_off.head);
+		sqTail  = (unsigned int *) (sq + params.sq_off.tail);
+		sqArray = (unsigned int *) (sq + params.sq_off.array);
+		sqMask  = *(unsigned int *) (sq + params.sq_off.ring_mask);
+		sqEntries = params.sq_entries;
+		sqLocalTail = sqSubmitted = *sqTail;
+
+		char *cq = (char *) cqRing;
+		cqHead = (unsigned int *) (cq + params.cq_off.head);
+		cqTail = (unsigned int *) (cq + params.cq_off.tail);
+		cqMask = *(unsigned int *) (cq + params.cq_off.ring_mask);
+		cqes   = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+	}
+
+	void setupBufferRing() {
+		struct io_uring_buf_reg reg;
+
+		bufferRingSize = BUFFER_COUNT * sizeof(struct io_uring_buf);
+		bufferRing = (struct io_uring_buf *) mmap(NULL, bufferRingSize,
+			PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+		if (bufferRing == MAP_FAILED) {
+			int e = errno;
+			bufferRing = NULL;
+			throw SystemException("Cannot allocate an io_uring buffer ring", e);
+		}
+
+		memset(&reg, 0, sizeof(reg));
+		reg.ring_addr = (boost::uint64_t) (uintptr_t) bufferRing;
+		reg.ring_entries = BUFFER_COUNT;
+		reg.bgid = BUFFER_GROUP_ID;
+		if (callRegister(fd, IORING_REGISTER_PBUF_RING, &reg, 1) == -1) {
+			int e = errno;
+			throw SystemException("Cannot register an io_uring buffer ring", e);
+		}
+
+		bufferRingTail = 0;
+		for (unsigned int i = 0; i < BUFFER_COUNT; i++) {
+			buffers[i] = MemoryKit::mbuf_get(pool);
+			if (buffers[i].empty()) {
+				throw RuntimeException("Cannot allocate an mbuf block for io_uring");
+			}
+			addBuffer(i);
+		}
+		publishBuffers();
+	}
+
+	void cleanup() {
+		for (unsigned int i = 0; i < BUFFER_COUNT; i++) {
+			buffers[i] = MemoryKit::mbuf();
+		}
+		if (bufferRing != NULL) {
+			munmap(bufferRing, bufferRingSize);
+		}
+		if (sqes != NULL) {
+			munmap(sqes, sqesSize);
+		}
+		if (cqRing != NULL && cqRing != sqRing) {
+			munmap(cqRing, cqRingSize);
+		}
+		if (sqRing != NULL) {
+			munmap(sqRing, sqRingSize);
+		}
+		if (fd != -1) {
+			close(fd);
+		}
+	}
+
+	void addBuffer(unsigned int bid) {
+		struct io_uring_buf *buf = &bufferRing[bufferRingTail & (BUFFER_COUNT - 1)];
+		buf->addr = (boost::uint64_t) (uintptr_t) buffers[bid].start;
+		buf->len = buffers[bid].size();
+		buf->bid = bid;
+		bufferRingTail++;
+	}
+
+	void publishBuffers() {
+		__atomic_store_n(&bufferRing[0].resv, bufferRingTail, __ATOMIC_RELEASE);
+	}
+
+	unsigned int allocateOperation(Callback callback, void *userData) {
+		unsigned int index;
+		if (freeOperation != 0) {
+			index = freeOperation - 1;
+			freeOperation = operations[index].nextFree;
+		} else {
+			index = operations.size();
+			operations.push_back(Operation());
+		}
+		operations[index].callback = callback;
+		operations[index].userData = userData;
+		operations[index].nextFree = 0;
+		pendingOperations++;
+		return index + 1;
+	}
+
+	void freeOperationSlot(unsigned int id) {
+		operations[id - 1].nextFree = freeOperation;
+		freeOperation = id;
+		pendingOperations--;
+	}
+
+	struct io_uring_sqe *getSqe() {
+		if (sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) == sqEntries) {
+			submit();
+			if (sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) == sqEntries) {
+				throw RuntimeException("io_uring submission queue is full");
+			}
+		}
+
+		unsigned int index = sqLocalTail & sqMask;
+		struct io_uring_sqe *sqe = &sqes[index];
+		memset(sqe, 0, sizeof(*sqe));
+		sqArray[index] = index;
+		sqLocalTail++;
+		return sqe;
+	}
+
+	unsigned int prepare(struct io_uring_sqe *sqe, Callback callback, void *userData) {
+		unsigned int id = allocateOperation(callback, userData);
+		operations[id - 1].opcode = sqe->opcode;
+		sqe->user_data = id;
+		return id;
+	}
+
+	void recycleBuffer(const struct io_uring_cqe *cqe) {
+		addBuffer(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+		publishBuffers();
+	}
+
+	MemoryKit::mbuf takeBuffer(const struct io_uring_cqe *cqe) {
+		unsigned int bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+		MemoryKit::mbuf result(buffers[bid], 0, cqe->res);
+		MemoryKit::mbuf replacement(MemoryKit::mbuf_get(pool));
+		if (OXT_LIKELY(!replacement.empty())) {
+			buffers[bid] = replacement;
+			addBuffer(bid);
+			publishBuffers();
+		} else {
+			// Out of memory. Reads fail with ENOBUFS if the
+			// ring runs dry, and are then retried.
+			buffers[bid] = MemoryKit::mbuf();
+		}
+		return result;
+	}
+
+public:
+	unsigned long long totalSubmissions;
+	unsigned long long totalCompletions;
+	unsigned long long totalEnterCalls;
+
+	/**
+	 * @throws SystemException The kernel does not support io_uring, or does
+	 *                         not support the features that we need.
+	 * @throws RuntimeException
+	 */
+	IoUring(struct ev_loop *_loop, struct MemoryKit::mbuf_pool *_pool)
+		: loop(_loop),
+		  pool(_pool),
+		  fd(-1),
+		  sqRing(NULL),
+		  cqRing(NULL),
+		  sqes(NULL),
+		  bufferRing(NULL),
+		  freeOperation(0),
+		  pendingOperations(0),
+		  totalSubmissions(0),
+		  totalCompletions(0),
+		  totalEnterCalls(0)
+	{
+		try {
+			setup();
+			setupBufferRing();
+		} catch (...) {
+			cleanup();
+			throw;
+		}
+
+		ev_io_init(&completionWatcher, _onCompletionsAvailable, fd, EV_READ);
+		completionWatcher.data = this;
+		ev_io_start(loop, &completionWatcher);
+		ev_prepare_init(&submissionWatcher, _onBeforePoll);
+		submissionWatcher.data = this;
+		ev_prepare_start(loop, &submissionWatcher);
+	}
+
+	~IoUring() {
+		ev_io_stop(loop, &completionWatcher);
+		ev_prepare_stop(loop, &submissionWatcher);
+		cleanup();
+	}
+
+	/**
+	 * Starts accepting connections on the given listening socket until
+	 * cancelled. Each accepted connection results in a completion whose
+	 * `res` is the new (non-blocking) client socket, or a negative errno.
+	 */
+	unsigned int acceptMultishot(int serverFd, Callback callback, void *userData) {
+		struct io_uring_sqe *sqe = getSqe();
+		sqe->opcode = IORING_OP_ACCEPT;
+		sqe->fd = serverFd;
+		sqe->accept_flags = SOCK_NONBLOCK;
+		sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+		return prepare(sqe, callback, userData);
+	}
+
+	/**
+	 * Reads from the given file descriptor into a provided buffer. The
+	 * completion's `res` is the number of bytes read, 0 on EOF, or a
+	 * negative errno. `-ENOBUFS` means that no buffers were available.
+	 */
+	unsigned int read(int fd, Callback callback, void *userData) {
+		struct io_uring_sqe *sqe = getSqe();
+		sqe->opcode = IORING_OP_READ;
+		sqe->fd = fd;
+		sqe->off = (boost::uint64_t) -1;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = BUFFER_GROUP_ID;
+		return prepare(sqe, callback, userData);
+	}
+
+	/**
+	 * Schedules a completion without performing any I/O. Useful for
+	 * calling back from the event loop with the same cancellation
+	 * semantics as real operations.
+	 */
+	unsigned int nop(Callback callback, void *userData) {
+		struct io_uring_sqe *sqe = getSqe();
+		sqe->opcode = IORING_OP_NOP;
+		return prepare(sqe, callback, userData);
+	}
+
+	/**
+	 * Cancels the given operation. Its callback will not be called
+	 * anymore, even if the kernel had already completed it.
+	 */
+	void cancel(unsigned int id) {
+		assert(id != 0);
+		assert(operations[id - 1].callback != NULL);
+		operations[id - 1].callback = NULL;
+		operations[id - 1].userData = NULL;
+
+		struct io_uring_sqe *sqe = getSqe();
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->addr = id;
+		sqe->user_data = 0;
+	}
+
+	/**
+	 * Submits all operations that were started since the last call.
+	 * Called automatically before the event loop polls for events.
+	 */
+	void submit() {
+		unsigned int count = sqLocalTail - sqSubmitted;
+		if (count == 0) {
+			return;
+		}
+
+		__atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+		int ret;
+		do {
+			ret = callEnter(fd, count, 0, 0);
+		} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+		totalEnterCalls++;
+		if (ret > 0) {
+			sqSubmitted += ret;
+			totalSubmissions += ret;
+		}
+		// On EAGAIN or EBUSY the kernel is short on resources or the
+		// completion queue overflowed. The remaining entries are
+		// submitted in the next event loop iteration.
+	}
+
+	void processCompletions() {
+		unsigned int head = *cqHead;
+		unsigned int tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+		while (head != tail) {
+			for (; head != tail; head++) {
+				struct io_uring_cqe cqe = cqes[head & cqMask];
+				__atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+				totalCompletions++;
+
+				unsigned int id = (unsigned int) cqe.user_data;
+				if (id == 0) {
+					// Completion of a cancellation request.
+					continue;
+				}
+
+				Operation &op = operations[id - 1];
+				Callback callback = op.callback;
+				void *userData = op.userData;
+				boost::uint8_t opcode = op.opcode;
+				if (!(cqe.flags & IORING_CQE_F_MORE)) {
+					freeOperationSlot(id);
+				}
+
+				if (callback == NULL) {
+					// The operation was cancelled, but may have completed anyway.
+					if (cqe.flags & IORING_CQE_F_BUFFER) {
+						recycleBuffer(&cqe);
+					}
+					if (opcode == IORING_OP_ACCEPT && cqe.res >= 0) {
+						close(cqe.res);
+					}
+				} else if (cqe.flags & IORING_CQE_F_BUFFER) {
+					MemoryKit::mbuf buffer(takeBuffer(&cqe));
+					callback(this, &cqe, buffer, userData);
+				} else {
+					MemoryKit::mbuf buffer;
+					callback(this, &cqe, buffer, userData);
+				}
+			}
+			tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+		}
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		doc["total_submissions"] = (Json::UInt64) totalSubmissions;
+		doc["total_completions"] = (Json::UInt64) totalCompletions;
+		doc["total_enter_calls"] = (Json::UInt64) totalEnterCalls;
+		doc["pending_operations"] = (Json::UInt) pendingOperations;
+		return doc;
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* SERVER_KIT_HAVE_IO_URING */
+
+#endif /* _PASSENGER_SERVER_KIT_IO_URING_H_ */
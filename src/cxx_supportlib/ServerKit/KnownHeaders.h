@@ -0,0 +1,179 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_KNOWN_HEADERS_H_
+#define _PASSENGER_SERVER_KIT_KNOWN_HEADERS_H_
+
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <StaticString.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+/**
+ * Well-known HTTP header names, in downcased form. HeaderTable indexes
+ * headers with these names by their KnownHeaderId, so that looking them up
+ * is an array access instead of a hash table probe plus key comparison.
+ */
+#define SERVER_KIT_KNOWN_HEADERS(X) \
+	X(ACCEPT,                      "accept") \
+	X(ACCEPT_CHARSET,              "accept-charset") \
+	X(ACCEPT_ENCODING,             "accept-encoding") \
+	X(ACCEPT_LANGUAGE,             "accept-language") \
+	X(ACCEPT_RANGES,               "accept-ranges") \
+	X(ACCESS_CONTROL_ALLOW_ORIGIN, "access-control-allow-origin") \
+	X(AGE,                         "age") \
+	X(ALLOW,                       "allow") \
+	X(AUTHORIZATION,               "authorization") \
+	X(CACHE_CONTROL,               "cache-control") \
+	X(CONNECTION,                  "connection") \
+	X(CONTENT_DISPOSITION,         "content-disposition") \
+	X(CONTENT_ENCODING,            "content-encoding") \
+	X(CONTENT_LANGUAGE,            "content-language") \
+	X(CONTENT_LENGTH,              "content-length") \
+	X(CONTENT_LOCATION,            "content-location") \
+	X(CONTENT_RANGE,               "content-range") \
+	X(CONTENT_SECURITY_POLICY,     "content-security-policy") \
+	X(CONTENT_TYPE,                "content-type") \
+	X(COOKIE,                      "cookie") \
+	X(DATE,                        "date") \
+	X(DNT,                         "dnt") \
+	X(ETAG,                        "etag") \
+	X(EXPECT,                      "expect") \
+	X(EXPIRES,                     "expires") \
+	X(FORWARDED,                   "forwarded") \
+	X(FROM,                        "from") \
+	X(HOST,                        "host") \
+	X(IF_MATCH,                    "if-match") \
+	X(IF_MODIFIED_SINCE,           "if-modified-since") \
+	X(IF_NONE_MATCH,               "if-none-match") \
+	X(IF_RANGE,                    "if-range") \
+	X(IF_UNMODIFIED_SINCE,         "if-unmodified-since") \
+	X(KEEP_ALIVE,                  "keep-alive") \
+	X(LAST_MODIFIED,               "last-modified") \
+	X(LINK,                        "link") \
+	X(LOCATION,                    "location") \
+	X(MAX_FORWARDS,                "max-forwards") \
+	X(ORIGIN,                      "origin") \
+	X(PRAGMA,                      "pragma") \
+	X(PROXY_AUTHENTICATE,          "proxy-authenticate") \
+	X(PROXY_AUTHORIZATION,         "proxy-authorization") \
+	X(RANGE,                       "range") \
+	X(REFERER,                     "referer") \
+	X(RETRY_AFTER,                 "retry-after") \
+	X(SERVER,                      "server") \
+	X(SET_COOKIE,                  "set-cookie") \
+	X(STATUS,                      "status") \
+	X(STRICT_TRANSPORT_SECURITY,   "strict-transport-security") \
+	X(TE,                          "te") \
+	X(TRAILER,                     "trailer") \
+	X(TRANSFER_ENCODING,           "transfer-encoding") \
+	X(UPGRADE,                     "upgrade") \
+	X(UPGRADE_INSECURE_REQUESTS,   "upgrade-insecure-requests") \
+	X(USER_AGENT,                  "user-agent") \
+	X(VARY,                        "vary") \
+	X(VIA,                         "via") \
+	X(WARNING,                     "warning") \
+	X(WWW_AUTHENTICATE,            "www-authenticate") \
+	X(X_ACCEL_REDIRECT,            "x-accel-redirect") \
+	X(X_CONTENT_TYPE_OPTIONS,      "x-content-type-options") \
+	X(X_FORWARDED_FOR,             "x-forwarded-for") \
+	X(X_FORWARDED_HOST,            "x-forwarded-host") \
+	X(X_FORWARDED_PROTO,           "x-forwarded-proto") \
+	X(X_FRAME_OPTIONS,             "x-frame-options") \
+	X(X_POWERED_BY,                "x-powered-by") \
+	X(X_REAL_IP,                   "x-real-ip") \
+	X(X_REQUEST_ID,                "x-request-id") \
+	X(X_REQUESTED_WITH,            "x-requested-with") \
+	X(X_SENDFILE,                  "x-sendfile") \
+	X(X_XSS_PROTECTION,            "x-xss-protection")
+
+enum KnownHeaderId {
+	KNOWN_HEADER_NONE,
+	#define SERVER_KIT_KNOWN_HEADER_ENUM(id, name) KNOWN_HEADER_ ## id,
+	SERVER_KIT_KNOWN_HEADERS(SERVER_KIT_KNOWN_HEADER_ENUM)
+	#undef SERVER_KIT_KNOWN_HEADER_ENUM
+	KNOWN_HEADER_COUNT
+};
+
+/** The longest known header name is this long. */
+#define SERVER_KIT_KNOWN_HEADER_MAX_SIZE 27
+#define SERVER_KIT_KNOWN_HEADER_SLOTS 256
+
+/** Names indexed by KnownHeaderId. The name for KNOWN_HEADER_NONE is empty. */
+extern const StaticString KNOWN_HEADER_NAMES[KNOWN_HEADER_COUNT];
+/**
+ * Perfect hash table that maps knownHeaderSlot() to a KnownHeaderId.
+ * Populated during static initialization in Implementation.cpp.
+ */
+extern boost::uint8_t knownHeaderSlots[SERVER_KIT_KNOWN_HEADER_SLOTS];
+
+
+/**
+ * A hash function that has no collisions among the known header names.
+ * The multipliers were found by a brute-force search. If you add a
+ * name to SERVER_KIT_KNOWN_HEADERS then HeaderTableTest will tell you
+ * whether they still work.
+ */
+inline unsigned int
+knownHeaderSlot(const char *name, size_t size) {
+	return (unsigned int) (size * 18
+		+ (unsigned char) name[0] * 19
+		+ (unsigned char) name[size - 1] * 24
+		+ (unsigned char) name[size / 2])
+		& (SERVER_KIT_KNOWN_HEADER_SLOTS - 1);
+}
+
+/**
+ * Returns the KnownHeaderId for the given downcased header name,
+ * or KNOWN_HEADER_NONE if it's not a known header.
+ */
+inline KnownHeaderId
+lookupKnownHeaderId(const char *name, size_t size) {
+	if (size == 0 || size > SERVER_KIT_KNOWN_HEADER_MAX_SIZE) {
+		return KNOWN_HEADER_NONE;
+	}
+
+	KnownHeaderId id = (KnownHeaderId) knownHeaderSlots[knownHeaderSlot(name, size)];
+	if (id != KNOWN_HEADER_NONE
+	 && KNOWN_HEADER_NAMES[id].size() == size
+	 && memcmp(KNOWN_HEADER_NAMES[id].data(), name, size) == 0)
+	{
+		return id;
+	} else {
+		return KNOWN_HEADER_NONE;
+	}
+}
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_KNOWN_HEADERS_H_ */
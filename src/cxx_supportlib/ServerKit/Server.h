@@ -53,6 +53,7 @@
 #include <errno.h>
 #include <pthread.h>
 #include <cstdio>
+#include <cstring>
 #include <jsoncpp/json.h>
 #include <SmallVector.h>
 
@@ -295,6 +296,11 @@ private:
 	ev::timer acceptResumptionWatcher;
 	ev::timer statisticsUpdateWatcher;
 	ev::io endpoints[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+	#ifdef SERVER_KIT_HAVE_IO_URING
+		// Multishot accept operations, used instead of `endpoints`
+		// if the context uses io_uring.
+		unsigned int acceptOperations[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+	#endif
 
 
 	/***** Private methods *****/
@@ -348,21 +354,90 @@ private:
 			serverState = TOO_MANY_FDS;
 			acceptResumptionWatcher.set(3, 0);
 			acceptResumptionWatcher.start();
-			for (uint8_t i = 0; i < nEndpoints; i++) {
-				ev_io_stop(ctx->libev->getLoop(), &endpoints[i]);
-			}
+			stopAccepting();
 		}
 
 		onClientsAccepted(acceptedClients, acceptCount);
 	}
 
+	#ifdef SERVER_KIT_HAVE_IO_URING
+		static void _onIoUringAccepted(IoUring *ring, const struct io_uring_cqe *cqe,
+			MemoryKit::mbuf &buffer, void *userData)
+		{
+			static_cast<BaseServer *>(userData)->onIoUringAccepted(cqe);
+		}
+
+		void onIoUringAccepted(const struct io_uring_cqe *cqe) {
+			TRACE_POINT();
+			uint8_t i;
+
+			for (i = 0; i < nEndpoints; i++) {
+				if (acceptOperations[i] != 0
+				 && (unsigned int) cqe->user_data == acceptOperations[i])
+				{
+					break;
+				}
+			}
+			assert(i < nEndpoints);
+			if (!(cqe->flags & IORING_CQE_F_MORE)) {
+				acceptOperations[i] = 0;
+			}
+
+			if (cqe->res >= 0) {
+				P_ASSERT_EQ(serverState, ACTIVE);
+				feedNewClients(&cqe->res, 1);
+			} else if (cqe->res != -EAGAIN && cqe->res != -EINTR && cqe->res != -ECONNABORTED) {
+				int errcode = -cqe->res;
+				SKS_ERROR("Cannot accept client: " << getErrorDesc(errcode) <<
+					" (errno=" << errcode << "). " <<
+					"Stop accepting clients for 3 seconds. " <<
+					"Current client count: " << activeClientCount);
+				serverState = TOO_MANY_FDS;
+				acceptResumptionWatcher.set(3, 0);
+				acceptResumptionWatcher.start();
+				stopAccepting();
+				return;
+			}
+
+			if (acceptOperations[i] == 0 && serverState == ACTIVE) {
+				// The kernel ended the multishot accept, e.g. because
+				// the completion queue overflowed.
+				acceptOperations[i] = ctx->ioUring->acceptMultishot(endpoints[i].fd,
+					_onIoUringAccepted, this);
+			}
+		}
+	#endif
+
+	void startAccepting(uint8_t i) {
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			if (ctx->ioUring != NULL) {
+				acceptOperations[i] = ctx->ioUring->acceptMultishot(endpoints[i].fd,
+					_onIoUringAccepted, this);
+				return;
+			}
+		#endif
+		ev_io_start(ctx->libev->getLoop(), &endpoints[i]);
+	}
+
+	void stopAccepting() {
+		for (uint8_t i = 0; i < nEndpoints; i++) {
+			#ifdef SERVER_KIT_HAVE_IO_URING
+				if (acceptOperations[i] != 0) {
+					ctx->ioUring->cancel(acceptOperations[i]);
+					acceptOperations[i] = 0;
+				}
+			#endif
+			ev_io_stop(ctx->libev->getLoop(), &endpoints[i]);
+		}
+	}
+
 	void onAcceptResumeTimeout(ev::timer &timer, int revents) {
 		TRACE_POINT();
 		P_ASSERT_EQ(serverState, TOO_MANY_FDS);
 		SKS_NOTICE("Resuming accepting new clients");
 		serverState = ACTIVE;
 		for (uint8_t i = 0; i < nEndpoints; i++) {
-			ev_io_start(ctx->libev->getLoop(), &endpoints[i]);
+			startAccepting(i);
 		}
 	}
 
@@ -726,6 +801,9 @@ public:
 		STAILQ_INIT(&freeClients);
 		TAILQ_INIT(&activeClients);
 		TAILQ_INIT(&disconnectedClients);
+		#ifdef SERVER_KIT_HAVE_IO_URING
+			memset(acceptOperations, 0, sizeof(acceptOperations));
+		#endif
 
 		acceptResumptionWatcher.set(context->libev->getLoop());
 		acceptResumptionWatcher.set<
@@ -783,7 +861,7 @@ public:
 		}
 		ev_io_init(&endpoints[nEndpoints], _onAcceptable, fd, EV_READ);
 		endpoints[nEndpoints].data = this;
-		ev_io_start(ctx->libev->getLoop(), &endpoints[nEndpoints]);
+		startAccepting(nEndpoints);
 		nEndpoints++;
 
 		#undef EXTENSION_EOPNOTSUPP
@@ -804,9 +882,7 @@ public:
 
 		// Stop listening on all endpoints.
 		acceptResumptionWatcher.stop();
-		for (uint8_t i = 0; i < nEndpoints; i++) {
-			ev_io_stop(ctx->libev->getLoop(), &endpoints[i]);
-		}
+		stopAccepting();
 
 		if (activeClientCount == 0 && disconnectedClientCount == 0) {
 			finishShutdown();
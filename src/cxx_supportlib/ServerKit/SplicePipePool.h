@@ -0,0 +1,139 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_SPLICE_PIPE_POOL_H_
+#define _PASSENGER_SERVER_KIT_SPLICE_PIPE_POOL_H_
+
+#ifdef __linux__
+	#define SERVER_KIT_HAVE_SPLICE
+#endif
+
+#ifdef SERVER_KIT_HAVE_SPLICE
+
+#include <Utils/IOUtils.h>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+/**
+ * A per-thread pool of non-blocking pipes for moving data between two
+ * sockets with splice(), without copying it to user space. Creating a pipe
+ * costs two file descriptors and a few system calls, so pipes that were
+ * emptied are kept for reuse. A pipe that still contains data cannot be
+ * reused, and is closed instead.
+ *
+ * Not thread-safe.
+ */
+class SplicePipePool {
+public:
+	/** The capacity that we try to give each pipe. */
+	static const int PIPE_SIZE = 256 * 1024;
+
+	struct Pipe {
+		int readEnd;
+		int writeEnd;
+	};
+
+private:
+	vector<Pipe> freePipes;
+	unsigned int maxFreePipes;
+
+	static void closePipe(const Pipe &pipe) {
+		safelyClose(pipe.readEnd, true);
+		safelyClose(pipe.writeEnd, true);
+	}
+
+public:
+	SplicePipePool(unsigned int _maxFreePipes = 16)
+		: maxFreePipes(_maxFreePipes)
+		{ }
+
+	~SplicePipePool() {
+		clear();
+	}
+
+	/**
+	 * Obtains an empty pipe. Returns false and sets errno if a new pipe
+	 * could not be created.
+	 */
+	bool acquire(Pipe &pipe) {
+		if (!freePipes.empty()) {
+			pipe = freePipes.back();
+			freePipes.pop_back();
+			return true;
+		}
+
+		int fds[2];
+		if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) == -1) {
+			return false;
+		}
+		// Larger pipes mean fewer splice() calls. The kernel may
+		// refuse, in which case the default size is fine.
+		#ifdef F_SETPIPE_SZ
+			fcntl(fds[1], F_SETPIPE_SZ, PIPE_SIZE);
+		#endif
+		pipe.readEnd = fds[0];
+		pipe.writeEnd = fds[1];
+		return true;
+	}
+
+	/**
+	 * Returns a pipe obtained from acquire(). `empty` must be false if
+	 * not all data written to the pipe has been read from it.
+	 */
+	void release(const Pipe &pipe, bool empty) {
+		if (empty && freePipes.size() < maxFreePipes) {
+			freePipes.push_back(pipe);
+		} else {
+			closePipe(pipe);
+		}
+	}
+
+	void clear() {
+		vector<Pipe>::const_iterator it, end = freePipes.end();
+		for (it = freePipes.begin(); it != end; it++) {
+			closePipe(*it);
+		}
+		freePipes.clear();
+	}
+
+	unsigned int getFreeCount() const {
+		return freePipes.size();
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* SERVER_KIT_HAVE_SPLICE */
+
+#endif /* _PASSENGER_SERVER_KIT_SPLICE_PIPE_POOL_H_ */
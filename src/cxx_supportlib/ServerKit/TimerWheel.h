@@ -0,0 +1,272 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_
+#define _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_
+
+#include <psg_sysqueue.h>
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <ev++.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <jsoncpp/json.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/**
+ * A coarse-grained hashed timer wheel, for timeouts that are armed, re-armed
+ * and cancelled far more often than they actually fire, such as client
+ * keep-alive and read timeouts.
+ *
+ * Arming, re-arming and cancelling a timer are O(1) list operations, whereas
+ * a libev timer costs an O(log n) heap operation each time. All timers in a
+ * wheel are driven by a single libev timer, which only runs while there are
+ * armed timers.
+ *
+ * Timers are put in one of `SLOTS` slots according to their expiry tick.
+ * Timers that expire more than one revolution into the future stay in their
+ * slot for `rounds` more revolutions. A timer never fires early, but it may
+ * fire up to two resolution intervals late.
+ *
+ * Timers are intrusive: embed a `TimerWheel::Timer` in the object that owns
+ * the timeout, and make sure to cancel it before that object goes away.
+ *
+ * Not thread-safe; all methods must be called from the event loop thread.
+ */
+class TimerWheel {
+public:
+	struct Timer;
+	typedef void (*Callback)(Timer *timer);
+
+	struct Timer {
+		TAILQ_ENTRY(Timer) nextTimer;
+		Callback callback;
+		void *userData;
+		/** Index of the list this timer is in, or NOT_ARMED. */
+		unsigned int slot;
+		unsigned int rounds;
+
+		Timer()
+			: callback(NULL),
+			  userData(NULL),
+			  slot(NOT_ARMED),
+			  rounds(0)
+			{ }
+
+		OXT_FORCE_INLINE
+		bool armed() const {
+			return slot != NOT_ARMED;
+		}
+	};
+
+	static const unsigned int SLOTS = 512;
+	static const unsigned int NOT_ARMED = ~0u;
+
+private:
+	TAILQ_HEAD(TimerList, Timer);
+
+	/**
+	 * The first `SLOTS` lists are the wheel's slots. The last one holds
+	 * timers that have expired, but whose callbacks have not been called yet.
+	 */
+	TimerList lists[SLOTS + 1];
+	struct ev_loop *loop;
+	ev::timer watcher;
+	ev_tstamp resolution;
+	ev_tstamp lastTickTime;
+	unsigned int currentSlot;
+	unsigned int count;
+
+	static const unsigned int EXPIRED = SLOTS;
+
+	void onTimeout(ev::timer &timer, int revents) {
+		tick(ev_now(loop));
+	}
+
+	void expireSlot(unsigned int slot) {
+		Timer *timer = TAILQ_FIRST(&lists[slot]);
+		while (timer != NULL) {
+			Timer *next = TAILQ_NEXT(timer, nextTimer);
+			if (timer->rounds == 0) {
+				TAILQ_REMOVE(&lists[slot], timer, nextTimer);
+				TAILQ_INSERT_TAIL(&lists[EXPIRED], timer, nextTimer);
+				timer->slot = EXPIRED;
+			} else {
+				timer->rounds--;
+			}
+			timer = next;
+		}
+	}
+
+	void fireExpiredTimers() {
+		// Callbacks may arm or cancel any timer, including timers
+		// that are still in the expired list.
+		while (!TAILQ_EMPTY(&lists[EXPIRED])) {
+			Timer *timer = TAILQ_FIRST(&lists[EXPIRED]);
+			TAILQ_REMOVE(&lists[EXPIRED], timer, nextTimer);
+			timer->slot = NOT_ARMED;
+			count--;
+			timer->callback(timer);
+		}
+	}
+
+public:
+	TimerWheel(struct ev_loop *_loop, ev_tstamp _resolution = 1)
+		: loop(_loop),
+		  resolution(_resolution),
+		  lastTickTime(0),
+		  currentSlot(0),
+		  count(0)
+	{
+		for (unsigned int i = 0; i <= SLOTS; i++) {
+			TAILQ_INIT(&lists[i]);
+		}
+		watcher.set(_loop);
+		watcher.set<TimerWheel, &TimerWheel::onTimeout>(this);
+	}
+
+	~TimerWheel() {
+		watcher.stop();
+	}
+
+	/**
+	 * Sets the interval, in seconds, at which the wheel advances.
+	 *
+	 * @pre empty()
+	 */
+	void setResolution(ev_tstamp value) {
+		assert(empty());
+		watcher.stop();
+		resolution = value;
+	}
+
+	ev_tstamp getResolution() const {
+		return resolution;
+	}
+
+	/**
+	 * Arms `timer` so that its callback is called once `timeout` seconds
+	 * have passed. If the timer is already armed then it is re-armed.
+	 */
+	void schedule(Timer *timer, ev_tstamp timeout) {
+		assert(timer->callback != NULL);
+		cancel(timer);
+
+		if (!watcher.is_active()) {
+			lastTickTime = ev_now(loop);
+			watcher.start(resolution, resolution);
+		}
+
+		// Up to a whole tick may have passed since lastTickTime,
+		// so add one to ensure that the timer doesn't fire early.
+		boost::uint64_t ticks = (boost::uint64_t) std::ceil(timeout / resolution) + 1;
+		timer->slot = (unsigned int) ((currentSlot + ticks) % SLOTS);
+		timer->rounds = (unsigned int) std::min<boost::uint64_t>(
+			(ticks - 1) / SLOTS, ~0u);
+		TAILQ_INSERT_TAIL(&lists[timer->slot], timer, nextTimer);
+		count++;
+	}
+
+	/** Disarms `timer`. Does nothing if it isn't armed. */
+	OXT_FORCE_INLINE
+	void cancel(Timer *timer) {
+		if (timer->armed()) {
+			TAILQ_REMOVE(&lists[timer->slot], timer, nextTimer);
+			timer->slot = NOT_ARMED;
+			count--;
+		}
+	}
+
+	/**
+	 * Advances the wheel by the number of whole ticks that have passed
+	 * between the last tick and `now`, and calls the callbacks of all timers
+	 * that expired. Normally called by the libev timer, but tests may call
+	 * it directly.
+	 */
+	void tick(ev_tstamp now) {
+		boost::uint64_t elapsed = (boost::uint64_t) std::floor(
+			(now - lastTickTime) / resolution + 0.001);
+		if (elapsed == 0) {
+			return;
+		}
+
+		lastTickTime += elapsed * resolution;
+		if (elapsed > SLOTS) {
+			// The loop has been blocked for more than a revolution. Skip
+			// the whole revolutions that passed, expiring every timer
+			// that would have expired during them.
+			boost::uint64_t revolutions = (elapsed - 1) / SLOTS;
+			for (unsigned int i = 0; i < SLOTS; i++) {
+				Timer *timer, *next;
+				TAILQ_FOREACH_SAFE (timer, &lists[i], nextTimer, next) {
+					if (timer->rounds < revolutions) {
+						TAILQ_REMOVE(&lists[i], timer, nextTimer);
+						TAILQ_INSERT_TAIL(&lists[EXPIRED], timer, nextTimer);
+						timer->slot = EXPIRED;
+					} else {
+						timer->rounds -= (unsigned int) revolutions;
+					}
+				}
+			}
+			elapsed -= revolutions * SLOTS;
+		}
+		while (elapsed > 0) {
+			currentSlot = (currentSlot + 1) % SLOTS;
+			expireSlot(currentSlot);
+			elapsed--;
+		}
+
+		fireExpiredTimers();
+		if (count == 0) {
+			watcher.stop();
+		}
+	}
+
+	/** The number of armed timers. */
+	unsigned int size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		doc["timers"] = count;
+		doc["resolution"] = resolution;
+		return doc;
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_ */
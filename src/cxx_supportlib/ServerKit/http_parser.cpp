@@ -28,6 +28,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
 
 #ifndef ULLONG_MAX
 # define ULLONG_MAX ((boost::uint64_t) -1) /* 2^64-1 */
@@ -57,6 +60,21 @@ do {                                                                 \
 } while(0)
 
 
+/* Advance p to just before TO, so that the main loop continues at TO. Used
+ * for skipping over runs of bytes that don't change the parser state.
+ */
+#define SKIP_TO(to)                                                  \
+do {                                                                 \
+  const char *to_ = (to);                                            \
+  parser->nread += (boost::uint32_t) (to_ - p - 1);                  \
+  if (parser->nread > (HTTP_MAX_HEADER_SIZE)) {                      \
+    SET_ERRNO(HPE_HEADER_OVERFLOW);                                  \
+    goto error;                                                      \
+  }                                                                  \
+  p = to_ - 1;                                                       \
+} while (0)
+
+
 /* Run the notify callback FOR, returning ER if it fails */
 #define CALLBACK_NOTIFY_(FOR, ER)                                    \
 do {                                                                 \
@@ -384,6 +402,10 @@ enum http_host_state
 #endif
 
 
+#define IS_PLAIN_URL_CHAR(c)                                                   \
+  ((c) > 0x20 && (c) < 0x7f && (c) != '?' && (c) != '#')
+
+
 #define start_state (parser->type == HTTP_REQUEST ? s_start_req : s_start_res)
 
 
@@ -414,6 +436,68 @@ static struct {
 
 int http_message_needs_eof(const http_parser *parser);
 
+/* Returns the first CR or LF in [p, end), or end if there is none.
+ * Header values are scanned with this, which makes large headers
+ * like cookies much cheaper to parse than going byte by byte.
+ */
+static inline const char *
+find_cr_or_lf(const char *p, const char *end)
+{
+#ifdef __SSE2__
+  const __m128i cr = _mm_set1_epi8(CR);
+  const __m128i lf = _mm_set1_epi8(LF);
+
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    int mask = _mm_movemask_epi8(_mm_or_si128(
+      _mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+  while (p != end && *p != CR && *p != LF) {
+    p++;
+  }
+  return p;
+}
+
+/* Returns the first byte in [p, end) that is not IS_PLAIN_URL_CHAR(),
+ * or end if there is none. Such bytes never cause a state transition
+ * while parsing the path, query string or fragment.
+ */
+static inline const char *
+find_url_delimiter(const char *p, const char *end)
+{
+#ifdef __SSE2__
+  /* Bytes >= 0x80 are negative in signed comparisons, so they fail
+   * the lower bound check.
+   */
+  const __m128i lower = _mm_set1_epi8(0x20);
+  const __m128i upper = _mm_set1_epi8(0x7f);
+  const __m128i question_mark = _mm_set1_epi8('?');
+  const __m128i hash = _mm_set1_epi8('#');
+
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i plain = _mm_and_si128(_mm_cmpgt_epi8(v, lower),
+      _mm_cmplt_epi8(v, upper));
+    plain = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(v, question_mark),
+      _mm_cmpeq_epi8(v, hash)), plain);
+    int mask = _mm_movemask_epi8(plain) ^ 0xffff;
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+  while (p != end && IS_PLAIN_URL_CHAR(*p)) {
+    p++;
+  }
+  return p;
+}
+
 /* Our URL parser.
  *
  * This is designed to be shared by http_parser_execute() for URL validation,
@@ -1100,6 +1184,11 @@ size_t http_parser_execute (http_parser *parser,
               SET_ERRNO(HPE_INVALID_URL);
               goto error;
             }
+            if (parser->state == s_req_path
+                || parser->state == s_req_query_string
+                || parser->state == s_req_fragment) {
+              SKIP_TO(find_url_delimiter(p + 1, data + len));
+            }
         }
         break;
       }
@@ -1475,6 +1564,10 @@ size_t http_parser_execute (http_parser *parser,
 
       case s_header_value:
       {
+        if (parser->header_state == h_general && ch != CR && ch != LF) {
+          SKIP_TO(find_cr_or_lf(p + 1, data + len));
+          break;
+        }
 
         if (ch == CR) {
           parser->state = s_header_almost_done;
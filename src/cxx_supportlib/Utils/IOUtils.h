@@ -149,6 +149,9 @@ vector<string> resolveHostname(const string &hostname,
  * @param file The name of the source file that called this function,
  *             for file descriptor logging purposes.
  * @param line The line in the source file that called this function.
+ * @param reusePort If <tt>address</tt> is a TCP address, whether SO_REUSEPORT
+ *                  should be set on the socket. See createTcpServer().
+ *                  Otherwise this argument is ignored.
  * @return The file descriptor of the newly created server socket.
  * @throws ArgumentException The given address cannot be parsed.
  * @throws RuntimeException Something went wrong.
@@ -160,7 +163,8 @@ int createServer(const StaticString &address,
 	unsigned int backlogSize = 0,
 	bool autoDelete = true,
 	const char *file = __FILE__,
-	unsigned int line = __LINE__);
+	unsigned int line = __LINE__,
+	bool reusePort = false);
 
 /**
  * Create a new Unix server socket which is bounded to <tt>filename</tt>.
@@ -196,8 +200,15 @@ int createUnixServer(const StaticString &filename,
  * @param file The name of the source file that called this function,
  *             for file descriptor logging purposes.
  * @param line The line in the source file that called this function.
+ * @param reusePort Whether to set SO_REUSEPORT on the socket. This allows
+ *                  multiple sockets to be bound to the same address and port,
+ *                  in which case the kernel distributes incoming connections
+ *                  among them. Only sockets owned by the same effective user
+ *                  can join such a group.
  * @return The file descriptor of the newly created server socket.
- * @throws SystemException Something went wrong while creating the server socket.
+ * @throws SystemException Something went wrong while creating the server socket,
+ *                         or <tt>reusePort</tt> is set but SO_REUSEPORT is
+ *                         not supported on this platform.
  * @throws ArgumentException The given address cannot be parsed.
  * @throws boost::thread_interrupted A system call has been interrupted.
  * @ingroup Support
@@ -206,7 +217,25 @@ int createTcpServer(const char *address = "0.0.0.0",
 	unsigned short port = 0,
 	unsigned int backlogSize = 0,
 	const char *file = __FILE__,
-	unsigned int line = __LINE__);
+	unsigned int line = __LINE__,
+	bool reusePort = false);
+
+/**
+ * Attaches a classic BPF program to a group of SO_REUSEPORT TCP server sockets
+ * (see createTcpServer()), which makes the kernel hand a new connection to
+ * the socket at index <tt>cpu % groupSize</tt>, where <tt>cpu</tt> is the
+ * CPU that processed the incoming packet. Sockets are indexed in the order
+ * in which they were created. If the thread that serves socket N is pinned
+ * to CPU N, then a connection is handled entirely on a single CPU.
+ *
+ * The program applies to the entire group, so it only needs to be attached
+ * to one of the sockets.
+ *
+ * @throws SystemException The program cannot be attached, for example
+ *                         because the platform does not support it (ENOSYS).
+ * @ingroup Support
+ */
+void attachReusePortCpuSteering(int fd, unsigned int groupSize);
 
 /**
  * Connect to a server at the given address in a blocking manner.
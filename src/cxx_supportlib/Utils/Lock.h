@@ -23,6 +23,19 @@ public:
 	}
 };
 
+/** Like DynamicScopedLock, but for arbitrary Lockable types. */
+template<typename Lockable>
+class GenericDynamicScopedLock: public boost::unique_lock<Lockable> {
+public:
+	GenericDynamicScopedLock(Lockable &m, bool lockNow = true)
+		: boost::unique_lock<Lockable>(m, boost::defer_lock)
+	{
+		if (lockNow) {
+			this->lock();
+		}
+	}
+};
+
 } // namespace Passenger
 
 #endif /* _PASSENGER_LOCK_H_ */
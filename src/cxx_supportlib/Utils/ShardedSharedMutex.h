@@ -0,0 +1,176 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARDED_SHARED_MUTEX_H_
+#define _PASSENGER_SHARDED_SHARED_MUTEX_H_
+
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/macros.hpp>
+#include <sched.h>
+
+namespace Passenger {
+
+
+/**
+ * A reader-writer lock that is optimized for the case in which shared
+ * (reader) locks are taken very frequently by many threads, and exclusive
+ * (writer) locks are taken comparatively rarely.
+ *
+ * Readers do not touch any shared cache line in the common case: every
+ * thread is assigned to one of `SHARD_COUNT` cache line-sized reader
+ * counters, and acquiring a shared lock only increments that thread's own
+ * counter and checks whether a writer is active. Writers first serialize
+ * among themselves through a normal mutex, then announce themselves and
+ * wait until all reader counters have drained.
+ *
+ * Writers have priority over readers: a reader that notices an active
+ * writer backs off and waits until the writer is done. This prevents
+ * writers (which in Passenger perform things like spawning and garbage
+ * collection) from being starved by a steady stream of readers.
+ *
+ * Critical sections protected by a shared lock should be short, because
+ * writers spin (with yielding) while waiting for readers to drain.
+ *
+ * This class satisfies the Boost SharedLockable concept, so it can be used
+ * with `boost::unique_lock`, `boost::lock_guard` and `boost::shared_lock`.
+ * Use `boost::condition_variable_any` to wait on an exclusive lock.
+ *
+ * Shared locks are not recursive: a thread that holds a shared lock must
+ * not attempt to acquire another one (nor an exclusive one) on the same
+ * object, otherwise it can deadlock with a pending writer.
+ */
+class ShardedSharedMutex {
+public:
+	enum {
+		SHARD_COUNT = 32,
+		CACHE_LINE_SIZE = 64
+	};
+
+private:
+	struct Shard {
+		boost::atomic<int> readers;
+		char padding[CACHE_LINE_SIZE - sizeof(boost::atomic<int>)];
+
+		Shard()
+			: readers(0)
+			{ }
+	};
+
+	Shard shards[SHARD_COUNT];
+	boost::atomic<bool> writerActive;
+	char padding[CACHE_LINE_SIZE - sizeof(boost::atomic<bool>)];
+	boost::mutex writerSyncher;
+
+	static unsigned int getShardIndex() {
+		static boost::atomic<unsigned int> nextIndex(0);
+		static __thread int index = -1;
+		if (OXT_UNLIKELY(index == -1)) {
+			index = nextIndex.fetch_add(1, boost::memory_order_relaxed) % SHARD_COUNT;
+		}
+		return index;
+	}
+
+	bool hasReaders() const {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			if (shards[i].readers.load(boost::memory_order_seq_cst) != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void waitForReadersToDrain() {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			unsigned int spins = 0;
+			while (shards[i].readers.load(boost::memory_order_seq_cst) != 0) {
+				if (++spins % 64 == 0) {
+					sched_yield();
+				}
+			}
+		}
+	}
+
+	bool tryLockSharedOnShard(Shard &shard) {
+		shard.readers.fetch_add(1, boost::memory_order_seq_cst);
+		if (OXT_LIKELY(!writerActive.load(boost::memory_order_seq_cst))) {
+			return true;
+		} else {
+			shard.readers.fetch_sub(1, boost::memory_order_release);
+			return false;
+		}
+	}
+
+public:
+	ShardedSharedMutex()
+		: writerActive(false)
+		{ }
+
+	void lock() {
+		writerSyncher.lock();
+		writerActive.store(true, boost::memory_order_seq_cst);
+		waitForReadersToDrain();
+	}
+
+	bool try_lock() {
+		if (!writerSyncher.try_lock()) {
+			return false;
+		}
+		writerActive.store(true, boost::memory_order_seq_cst);
+		if (hasReaders()) {
+			writerActive.store(false, boost::memory_order_seq_cst);
+			writerSyncher.unlock();
+			return false;
+		} else {
+			return true;
+		}
+	}
+
+	void unlock() {
+		writerActive.store(false, boost::memory_order_seq_cst);
+		writerSyncher.unlock();
+	}
+
+	void lock_shared() {
+		Shard &shard = shards[getShardIndex()];
+		while (!tryLockSharedOnShard(shard)) {
+			// Wait until the active writer is done.
+			boost::lock_guard<boost::mutex> l(writerSyncher);
+		}
+	}
+
+	bool try_lock_shared() {
+		return tryLockSharedOnShard(shards[getShardIndex()]);
+	}
+
+	void unlock_shared() {
+		shards[getShardIndex()].readers.fetch_sub(1, boost::memory_order_release);
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARDED_SHARED_MUTEX_H_ */
@@ -344,6 +344,9 @@ def locate_source_file(path)
   define_component 'AppTypes.o',
     :source   => 'AppTypes.cpp',
     :category => :other
+  define_component 'ProcessManagement/ChildReaper.o',
+    :source   => 'ProcessManagement/ChildReaper.cpp',
+    :category => :other
 
   define_component 'vendor-modified/modp_b64.o',
     :source   => 'vendor-modified/modp_b64.cpp',
@@ -58,12 +58,19 @@ module SharedConstants
     DEFAULT_WEB_APP_USER = "nobody"
     DEFAULT_APP_ENV = "production"
     DEFAULT_SPAWN_METHOD = "smart"
+    DEFAULT_SPAWN_CONCURRENCY = 1
     # Apache's unixd.h also defines DEFAULT_USER, so we avoid naming clash here.
     PASSENGER_DEFAULT_USER = "nobody"
     DEFAULT_CONCURRENCY_MODEL = "process"
     DEFAULT_STICKY_SESSIONS_COOKIE_NAME = "_passenger_route"
     DEFAULT_APP_THREAD_COUNT = 1
+    DEFAULT_APP_CONNECT_TIMEOUT = 10_000
     DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK = 1024 * 1024 * 128
+    DEFAULT_TURBOCACHE_MAX_ENTRIES = 1024
+    DEFAULT_TURBOCACHE_MAX_MEMORY = 1024 * 1024 * 16
+    DEFAULT_TURBOCACHE_MAX_BODY_SIZE = 1024 * 512
+    # Entries are preallocated, so the number of entries is capped.
+    TURBOCACHE_MAX_ENTRIES_LIMIT = 1024 * 1024
     DEFAULT_MAX_REQUEST_QUEUE_SIZE = 100
     DEFAULT_STAT_THROTTLE_RATE = 10
     DEFAULT_ANALYTICS_LOG_USER = DEFAULT_WEB_APP_USER
@@ -87,6 +94,10 @@ module SharedConstants
     # high concurrency with low mem overhead. On the upload side there is a penalty
     # but there's no real average upload size anyway so we choose mem safety instead.
     DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD = 1024 * 128
+    # When a global memory budget is used for buffering, channels holding less than
+    # this are never switched to disk, even if the budget is exhausted. This keeps
+    # small responses off the disk when the budget is taken by a few large ones.
+    DEFAULT_FILE_BUFFERED_CHANNEL_MIN_THRESHOLD = 1024 * 16
     SERVER_KIT_MAX_SERVER_ENDPOINTS = 4
 
     # Time limits
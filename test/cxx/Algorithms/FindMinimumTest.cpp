@@ -0,0 +1,85 @@
+#include <TestSupport.h>
+#include <Algorithms/FindMinimum.h>
+#include <vector>
+#include <cstdlib>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Algorithms_FindMinimumTest {
+		unsigned int reference(const vector<int> &values) {
+			unsigned int result = 0;
+			for (unsigned int i = 1; i < values.size(); i++) {
+				if (values[i] < values[result]) {
+					result = i;
+				}
+			}
+			return result;
+		}
+
+		void check(const vector<int> &values, int lowerBound = INT_MIN) {
+			unsigned int expected = reference(values);
+			string size = toString(values.size());
+			ensure_equals(("SIMD version, size " + size).c_str(),
+				findFirstMinimumIndex(&values[0], values.size(), lowerBound),
+				expected);
+			ensure_equals(("Scalar version, size " + size).c_str(),
+				findFirstMinimumIndexScalar(&values[0], values.size(), lowerBound),
+				expected);
+		}
+	};
+
+	DEFINE_TEST_GROUP(Algorithms_FindMinimumTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It returns the position of the minimum for every array size up to 1024");
+		srand(1234);
+		for (unsigned int size = 1; size <= 1024; size++) {
+			vector<int> values;
+			for (unsigned int i = 0; i < size; i++) {
+				values.push_back(rand() - RAND_MAX / 2);
+			}
+			check(values);
+		}
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It returns the first position if the minimum occurs multiple times");
+		for (unsigned int size = 1; size <= 40; size++) {
+			for (unsigned int first = 0; first < size; first++) {
+				vector<int> values(size, 10);
+				values[first] = 3;
+				for (unsigned int i = first + 1; i < size; i += 3) {
+					values[i] = 3;
+				}
+				check(values);
+				ensure_equals(findFirstMinimumIndex(&values[0], size), first);
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("It handles extreme values");
+		for (unsigned int size = 1; size <= 20; size++) {
+			vector<int> values(size, INT_MAX);
+			check(values);
+			values[size - 1] = INT_MIN;
+			check(values);
+			values[0] = INT_MIN;
+			check(values);
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("It stops at the first value that equals the lower bound");
+		srand(5678);
+		for (unsigned int size = 1; size <= 300; size++) {
+			vector<int> values;
+			for (unsigned int i = 0; i < size; i++) {
+				values.push_back(rand() % 4);
+			}
+			check(values, 0);
+		}
+	}
+}
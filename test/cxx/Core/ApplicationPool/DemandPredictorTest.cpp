@@ -0,0 +1,99 @@
+#include <TestSupport.h>
+#include <Core/ApplicationPool/DemandPredictor.h>
+
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+using namespace std;
+
+namespace tut {
+	struct Core_ApplicationPool_DemandPredictorTest {
+		DemandPredictor predictor;
+		unsigned long long now;
+
+		Core_ApplicationPool_DemandPredictorTest() {
+			now = 1000000000;
+			predictor.sample(now);
+		}
+
+		// Simulates a sample interval in which `arrivals` requests arrived,
+		// each of which took `serviceTime` microseconds.
+		void feed(unsigned int arrivals, unsigned long long serviceTime) {
+			for (unsigned int i = 0; i < arrivals; i++) {
+				predictor.recordArrival();
+				predictor.recordCompletion(serviceTime);
+			}
+			now += DemandPredictor::SAMPLE_INTERVAL;
+			predictor.sample(now);
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ApplicationPool_DemandPredictorTest);
+
+	TEST_METHOD(1) {
+		set_test_name("erlangC() computes the probability of waiting in an M/M/c queue");
+		ensure(fabs(DemandPredictor::erlangC(2, 1) - 1 / 3.0) < 0.0001);
+		ensure_equals(DemandPredictor::erlangC(1, 1.5), 1.0);
+		ensure(DemandPredictor::erlangC(10, 2) < 0.001);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("No prediction is made until a full sample interval has passed");
+		ensure(!predictor.available());
+		ensure_equals(predictor.requiredProcesses(1, 100), 0u);
+
+		predictor.recordArrival();
+		ensure(!predictor.available());
+		ensure_equals(predictor.requiredProcesses(1, 100), 0u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Under a steady load, it sizes the group with the queueing model");
+		// 20 requests per second that take 100 ms each: an offered load of 2 Erlangs.
+		for (int i = 0; i < 5; i++) {
+			feed(100, 100000);
+		}
+		ensure(predictor.available());
+		ensure(fabs(predictor.offeredLoad() - 2) < 0.0001);
+		ensure_equals("Concurrency 1", predictor.requiredProcesses(1, 100), 5u);
+		ensure_equals("Concurrency 2", predictor.requiredProcesses(2, 100), 3u);
+		ensure_equals("Capped at the limit", predictor.requiredProcesses(1, 4), 4u);
+		ensure_equals("Unlimited concurrency", predictor.requiredProcesses(0, 100), 0u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Under a rising load, it forecasts ahead of the current arrival rate");
+		predictor.recordSpawnTime(DemandPredictor::SAMPLE_INTERVAL);
+		for (int i = 1; i <= 6; i++) {
+			feed(i * 50, 100000);
+		}
+		// The arrival rate is 60 requests per second now and rises
+		// by 10 requests per second per sample interval. The forecast
+		// looks one sample interval plus one spawn time ahead.
+		ensure(predictor.forecastArrivalRate() > 70);
+		ensure(predictor.forecastArrivalRate() <= 80.0001);
+
+		DemandPredictor steady;
+		steady.sample(1000000000);
+		for (int i = 1; i <= 6; i++) {
+			for (int j = 0; j < 300; j++) {
+				steady.recordArrival();
+				steady.recordCompletion(100000);
+			}
+			steady.sample(1000000000 + i * DemandPredictor::SAMPLE_INTERVAL);
+		}
+		ensure(predictor.requiredProcesses(1, 100) > steady.requiredProcesses(1, 100));
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("When the load disappears, the group may shrink");
+		for (int i = 0; i < 5; i++) {
+			feed(100, 100000);
+		}
+		ensure(predictor.requiredProcesses(1, 100) > 0);
+		for (int i = 0; i < 5; i++) {
+			feed(0, 0);
+		}
+		ensure(predictor.available());
+		ensure_equals(predictor.requiredProcesses(1, 100), 0u);
+	}
+}
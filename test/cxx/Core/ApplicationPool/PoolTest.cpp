@@ -4,6 +4,7 @@
 #include <LoggingKit/Context.h>
 #include <Utils/IOUtils.h>
 #include <Utils/StrIntUtils.h>
+#include <Utils/Timer.h>
 #include <MessageReadersWriters.h>
 #include <map>
 #include <vector>
@@ -28,6 +29,8 @@ namespace tut {
 		boost::mutex syncher;
 		list<SessionPtr> sessions;
 		bool retainSessions;
+		boost::atomic<bool> holdingSharedLock;
+		boost::atomic<bool> releaseSharedLock;
 
 		Core_ApplicationPool_PoolTest() {
 			retainSessions = false;
@@ -208,6 +211,22 @@ namespace tut {
 		void disableProcess(ProcessPtr process, AtomicInt *result) {
 			*result = (int) pool->disableProcess(process->getGupid());
 		}
+
+		void holdSharedPoolLock() {
+			PoolSharedLock l(pool->syncher);
+			holdingSharedLock = true;
+			while (!releaseSharedLock) {
+				usleep(1000);
+			}
+		}
+
+		void getAndCloseSessions(Options options, unsigned int iterations) {
+			Ticket ticket;
+			for (unsigned int i = 0; i < iterations; i++) {
+				SessionPtr session = pool->get(options, &ticket);
+				session->close(true);
+			}
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ApplicationPool_PoolTest, 100);
@@ -227,7 +246,7 @@ namespace tut {
 		// as the new process is done spawning.
 		Options options = createOptions();
 
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("(1)", number, 0);
 		ensure("(2)", pool->getWaitlist.empty());
@@ -262,7 +281,7 @@ namespace tut {
 		ensure(!process->isTotallyBusy());
 
 		// Verify test assertion.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("callback is immediately called", number, 2);
 	}
@@ -383,7 +402,7 @@ namespace tut {
 
 		// Now open another session. It should complete immediately
 		// and should not use the first process.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("asyncGet() completed immediately", number, 2);
 		SessionPtr session2 = currentSession;
@@ -416,7 +435,7 @@ namespace tut {
 		GroupPtr group = pool->findOrCreateGroup(options);
 		spawningKitConfig->concurrency = 2;
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			group->spawn();
 		}
 		EVENTUALLY(5,
@@ -535,7 +554,7 @@ namespace tut {
 		);
 
 		// The next asyncGet() should spawn a new process and the action should be queued.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		spawningKitConfig->spawnTime = 5000000;
 		pool->asyncGet(options, callback, false);
 		ensure(group->spawning());
@@ -619,6 +638,56 @@ namespace tut {
 		ensure_equals(pool->getGroupCount(), 0u);
 	}
 
+	TEST_METHOD(15) {
+		// If spawnConcurrency > 1, then the processes needed to satisfy
+		// minProcesses are spawned at the same time instead of one by one.
+		Options options = createOptions();
+		options.minProcesses = 4;
+		options.spawnConcurrency = 4;
+		pool->setMax(4);
+		spawningKitConfig->spawnTime = 300000;
+
+		Timer<> timer;
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("stub/rack");
+			ensure_equals(group->processesBeingSpawned, 4);
+			ensure_equals(group->capacityUsed(), 4u);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 4;
+		);
+		// Spawning one by one would take at least 1.2 seconds.
+		ensure("Processes were spawned concurrently", timer.elapsed() < 1000);
+		EVENTUALLY(5,
+			result = number == 1 && !pool->isSpawning();
+		);
+	}
+
+	TEST_METHOD(16) {
+		// Processes that are being spawned concurrently count towards the
+		// pool's capacity, so spawnConcurrency never causes the pool limits
+		// to be exceeded.
+		Options options = createOptions();
+		options.minProcesses = 6;
+		options.spawnConcurrency = 6;
+		pool->setMax(3);
+		spawningKitConfig->spawnTime = 50000;
+
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("stub/rack");
+			ensure_equals(group->processesBeingSpawned, 3);
+			ensure(pool->atFullCapacityUnlocked());
+		}
+		EVENTUALLY(5,
+			result = number == 1 && !pool->isSpawning();
+		);
+		ensure_equals(pool->getProcessCount(), 3u);
+	}
+
 	TEST_METHOD(17) {
 		// Test that restartGroupByName() spawns more processes to ensure
 		// that minProcesses and other constraints are met.
@@ -655,6 +724,62 @@ namespace tut {
 		ensure_equals(pool->getProcessCount(), 1u);
 	}
 
+	TEST_METHOD(19) {
+		// With predictive spawning, autoscale() spawns processes ahead of the
+		// forecasted demand, and shuts down surplus idle processes one at a
+		// time after the demand has disappeared.
+		Options options = createOptions();
+		options.predictiveSpawning = true;
+		pool->setMax(10);
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		ensure_equals(pool->getProcessCount(), 1u);
+		GroupPtr group = pool->groups.lookupCopy("stub/rack");
+		clearAllSessions();
+
+		const unsigned long long interval = DemandPredictor::SAMPLE_INTERVAL;
+		unsigned long long now = SystemTime::getUsec();
+		boost::container::vector<Callback> actions;
+		{
+			PoolLockGuard l(pool->syncher);
+			group->autoscale(now, actions);
+			// 20 requests per second that take 100 ms each: an offered load
+			// of 2 Erlangs. Enough samples are taken for the initial request
+			// to no longer matter.
+			for (int i = 1; i <= 10; i++) {
+				for (int j = 0; j < 100; j++) {
+					group->demandPredictor.recordArrival();
+					group->demandPredictor.recordCompletion(100000);
+				}
+				group->autoscale(now + i * interval, actions);
+			}
+			ensure_equals(group->predictedProcesses, 5u);
+			ensure(group->spawning());
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 5u && !pool->isSpawning();
+		);
+
+		{
+			PoolLockGuard l(pool->syncher);
+			int prevEnabledCount = group->enabledCount;
+			for (int i = 11; i <= 30 && group->enabledCount > 1; i++) {
+				group->autoscale(now + i * interval, actions);
+				ensure("At most one surplus process is shut down per sample",
+					group->enabledCount >= prevEnabledCount - 1);
+				prevEnabledCount = group->enabledCount;
+			}
+			ensure_equals("It shrinks down to minProcesses",
+				group->enabledCount, 1);
+		}
+		Pool::runAllActions(actions);
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 1u;
+		);
+	}
+
 
 	/*********** Test asyncGet() behavior on multiple Groups ***********/
 
@@ -836,7 +961,7 @@ namespace tut {
 		SystemTime::force(2);
 		GroupPtr barGroup = pool->get(options2, &ticket)->getGroup()->shared_from_this();
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals("(1)", barGroup->spawn(), SR_OK);
 		}
 		debug->debugger->recv("Begin spawn loop iteration 1");
@@ -859,7 +984,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -921,7 +1046,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -956,7 +1081,7 @@ namespace tut {
 		ProcessPtr process = currentSession->getProcess()->shared_from_this();
 		pool->detachProcess(process);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 		EVENTUALLY(5,
@@ -987,13 +1112,13 @@ namespace tut {
 		pool->asyncGet(options, callback);
 
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
 		}
 
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test")->spawning());
 			ensure_equals(pool->groups.lookupCopy("test")->enabledCount, 0);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
@@ -1025,7 +1150,7 @@ namespace tut {
 		spawningKitConfig->spawnTime = 90000;
 		pool->asyncGet(options2, callback);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->getWaitlist.size(), 1u);
 		}
 
@@ -1038,7 +1163,7 @@ namespace tut {
 		currentSession.reset();
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test2") != NULL);
 			ensure_equals(pool->getWaitlist.size(), 0u);
 		}
@@ -1059,7 +1184,7 @@ namespace tut {
 		currentSession.reset();
 		GroupPtr group = process->getGroup()->shared_from_this();
 		pool->detachProcess(process);
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure_equals(pool->groups.size(), 1u);
 		ensure(group->isAlive());
 		ensure(!group->garbageCollectable());
@@ -1076,18 +1201,18 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = !process->isAlive()
 				|| !process->osProcessExists();
 		);
 
 		session.reset();
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1107,7 +1232,7 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		EVENTUALLY(1,
@@ -1115,7 +1240,7 @@ namespace tut {
 		);
 
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->isDead()
 				|| !process->osProcessExists();
 		);
@@ -1124,7 +1249,7 @@ namespace tut {
 		g.clear();
 
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1154,7 +1279,7 @@ namespace tut {
 		pool->detachProcess(process);
 		debug->debugger->recv("About to start detached processes checker");
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 
@@ -1186,7 +1311,7 @@ namespace tut {
 		ensure_equals("Disabling succeeds",
 			pool->disableProcess(processes[0]->getGupid()), DR_SUCCESS);
 
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure(processes[0]->isAlive());
 		ensure_equals("Process is disabled",
 			processes[0]->enabled,
@@ -1260,7 +1385,7 @@ namespace tut {
 		TempThread thr2(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
 			this, process2, &code2));
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1279,7 +1404,7 @@ namespace tut {
 			result = code2 == DR_SUCCESS;
 		);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 2);
@@ -1307,7 +1432,7 @@ namespace tut {
 			this, session2->getProcess()->shared_from_this(), &code2));
 		EVENTUALLY(2,
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1326,7 +1451,7 @@ namespace tut {
 		);
 		{
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 2);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 0);
@@ -1385,7 +1510,7 @@ namespace tut {
 		ensure_equals(result, DR_SUCCESS);
 
 		{
-			ScopedLock l(pool->syncher);
+			PoolScopedLock l(pool->syncher);
 			GroupPtr group = processes[0]->getGroup()->shared_from_this();
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
@@ -1933,7 +2058,7 @@ namespace tut {
 		}
 		ensure_equals(number, 0);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->getWaitlist.size(),
 				3u);
 		}
@@ -2023,6 +2148,138 @@ namespace tut {
 		currentSession.reset();
 	}
 
+	TEST_METHOD(80) {
+		// If an enabled process has spare capacity, then asyncGet() and
+		// closing a session only need the Pool lock in shared mode.
+		ensureMinProcesses(1);
+		Options options = createOptions();
+		ProcessPtr process = pool->getProcesses()[0];
+
+		holdingSharedLock = false;
+		releaseSharedLock = false;
+		boost::thread thr(boost::bind(&Core_ApplicationPool_PoolTest::holdSharedPoolLock, this));
+		EVENTUALLY(5,
+			result = holdingSharedLock;
+		);
+
+		pool->asyncGet(options, callback);
+		ensure_equals("The session is checked out immediately", number, 2);
+		ensure_equals(process->sessions, 1);
+		currentSession->close(true);
+		currentSession.reset();
+		ensure_equals(process->sessions, 0);
+		ensure_equals(process->processed, 2u);
+
+		releaseSharedLock = true;
+		thr.join();
+	}
+
+	TEST_METHOD(81) {
+		// Test that concurrent asyncGet() and session closes through both
+		// the routing fast path and the slow path keep the bookkeeping
+		// consistent, for various numbers of threads.
+		Options options = createOptions();
+		options.minProcesses = 2;
+		pool->setMax(2);
+		GroupPtr group = pool->findOrCreateGroup(options);
+		spawningKitConfig->concurrency = 2;
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+
+		unsigned int threadCounts[] = { 1, 2, 4, 8, 16 };
+		const unsigned int iterations = 200;
+		unsigned int total = 0;
+		for (unsigned int i = 0; i < sizeof(threadCounts) / sizeof(unsigned int); i++) {
+			boost::thread_group threads;
+			for (unsigned int j = 0; j < threadCounts[i]; j++) {
+				threads.create_thread(boost::bind(
+					&Core_ApplicationPool_PoolTest::getAndCloseSessions,
+					this, options, iterations));
+			}
+			threads.join_all();
+			total += threadCounts[i] * iterations;
+
+			PoolLockGuard l(pool->syncher);
+			pool->fullVerifyInvariants();
+			unsigned int processed = 0;
+			foreach (const ProcessPtr &process, group->enabledProcesses) {
+				ensure_equals(process->sessions, 0);
+				ensure_equals(group->enabledProcessBusynessLevels[process->getIndex()], 0);
+				processed += process->processed;
+			}
+			ensure_equals(group->nEnabledProcessesTotallyBusy, 0);
+			ensure_equals(group->getWaitlist.size(), 0u);
+			ensure_equals(processed, total);
+		}
+	}
+
+	TEST_METHOD(82) {
+		// asyncGet() with a routing affinity hint prefers the process that
+		// the hint refers to for as long as that process is idle.
+		Options options = createOptions();
+		options.minProcesses = 2;
+		pool->setMax(2);
+		GroupPtr group = pool->findOrCreateGroup(options);
+		spawningKitConfig->concurrency = 1;
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+		ProcessPtr process1 = group->enabledProcesses[0];
+		ProcessPtr process2 = group->enabledProcesses[1];
+		RoutingAffinity affinity;
+
+		// Without a hint, routing picks the first idle process.
+		pool->asyncGet(options, callback, true, NULL, &affinity);
+		SessionPtr session1 = currentSession;
+		ensure_equals(session1->getProcess(), process1.get());
+		ensure_equals(affinity.stickySessionId, process1->getStickySessionId());
+		ensure_equals(affinity.hits, 0u);
+
+		// The hint is updated when routing picks another process.
+		pool->asyncGet(options, callback, true, NULL, &affinity);
+		SessionPtr session2 = currentSession;
+		ensure_equals(session2->getProcess(), process2.get());
+		ensure_equals(affinity.stickySessionId, process2->getStickySessionId());
+		currentSession.reset();
+		session1->close(true);
+		session1.reset();
+		session2->close(true);
+		session2.reset();
+
+		// Both processes are idle now, so the hint wins the tie.
+		pool->asyncGet(options, callback, true, NULL, &affinity);
+		session2 = currentSession;
+		ensure_equals(session2->getProcess(), process2.get());
+		ensure_equals(affinity.hits, 1u);
+
+		// A hint for a busy process is ignored.
+		RoutingAffinity affinity2 = affinity;
+		pool->asyncGet(options, callback, true, NULL, &affinity2);
+		session1 = currentSession;
+		ensure_equals(session1->getProcess(), process1.get());
+		ensure_equals(affinity2.hits, 1u);
+		ensure_equals(affinity2.stickySessionId, process1->getStickySessionId());
+		currentSession.reset();
+		session1->close(true);
+		session2->close(true);
+
+		// A stale hint is ignored.
+		affinity.stickySessionId = process1->getStickySessionId() + process2->getStickySessionId();
+		pool->asyncGet(options, callback, true, NULL, &affinity);
+		ensure_equals(currentSession->getPid(), process1->getPid());
+		ensure_equals(affinity.hits, 1u);
+		currentSession.reset();
+	}
+
 	// TODO: Persistent connections.
 	// TODO: If one closes the session before it has reached EOF, and process's maximum concurrency
 	//       has already been reached, then the pool should ping the process so that it can detect
@@ -2,6 +2,8 @@
 #include <Core/ApplicationPool/Process.h>
 #include <LoggingKit/Context.h>
 #include <Utils/IOUtils.h>
+#include <poll.h>
+#include <fcntl.h>
 
 using namespace Passenger;
 using namespace Passenger::ApplicationPool2;
@@ -38,7 +40,7 @@ namespace tut {
 			server1.assign(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__), NULL, 0);
 			getsockname(server1, (struct sockaddr *) &addr, &len);
 			socket["name"] = "main1";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -47,7 +49,7 @@ namespace tut {
 			getsockname(server2, (struct sockaddr *) &addr, &len);
 			socket = Json::Value();
 			socket["name"] = "main2";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -56,7 +58,7 @@ namespace tut {
 			getsockname(server3, (struct sockaddr *) &addr, &len);
 			socket = Json::Value();
 			socket["name"] = "main3";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -98,6 +100,10 @@ namespace tut {
 		}
 
 		ProcessPtr createProcess() {
+			return createProcess(sockets);
+		}
+
+		ProcessPtr createProcess(const Json::Value &sockets) {
 			SpawningKit::Result result;
 
 			result["type"] = "dummy";
@@ -114,6 +120,24 @@ namespace tut {
 			process->shutdownNotRequired();
 			return process;
 		}
+
+		Json::Value createUnixSocketDescription(const string &filename, int concurrency) {
+			Json::Value sockets, socket;
+			socket["name"] = "main";
+			socket["address"] = "unix:" + filename;
+			socket["protocol"] = "session";
+			socket["concurrency"] = concurrency;
+			sockets.append(socket);
+			return sockets;
+		}
+
+		void waitUntilWritable(int fd) {
+			struct pollfd pfd;
+			pfd.fd = fd;
+			pfd.events = POLLOUT;
+			pfd.revents = 0;
+			ensure("(fd becomes writable)", poll(&pfd, 1, 5000) == 1);
+		}
 	};
 
 	DEFINE_TEST_GROUP(Core_ApplicationPool_ProcessTest);
@@ -223,4 +247,253 @@ namespace tut {
 				&& gatheredOutput.find("errorPipe 2\n") != string::npos;
 		);
 	}
+
+	TEST_METHOD(6) {
+		set_test_name("beginInitiate() connects without blocking and hands the "
+			"connection back to the socket's connection pool upon close");
+		ProcessPtr process = createProcess();
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+
+		AbstractSession::InitiateStatus status = session->beginInitiate();
+		while (status != AbstractSession::INITIATED) {
+			ensure_equals(status, AbstractSession::INITIATE_WAIT_WRITABLE);
+			waitUntilWritable(session->fd());
+			status = session->continueInitiate();
+		}
+		ensure(session->initiated());
+		ensure(fcntl(session->fd(), F_GETFL) & O_NONBLOCK);
+		ensure_equals(socket->totalConnections, 1);
+
+		int fd = session->fd();
+		process->sessionClosed(session.get());
+		session->close(true, true);
+		ensure_equals(socket->totalIdleConnections, 1);
+
+		session = process->newSession();
+		ensure("(the pooled connection is reused)",
+			session->beginInitiate() == AbstractSession::INITIATED);
+		ensure_equals(session->fd(), fd);
+		process->sessionClosed(session.get());
+		session->close(false);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("beginInitiate() asks to retry later if the app's accept "
+			"backlog is full, instead of blocking");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 1, true, __FILE__, __LINE__),
+			NULL, 0);
+		vector<FileDescriptor> clients;
+		while (true) {
+			NConnect_State state;
+			setupNonBlockingSocket(state, "unix:" + filename, __FILE__, __LINE__);
+			if (!connectToServer(state)) {
+				break;
+			}
+			clients.push_back(state.s_unix.fd);
+		}
+
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 3));
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATE_RETRY_LATER);
+		ensure(!session->initiated());
+		ensure_equals(session->continueInitiate(), AbstractSession::INITIATE_RETRY_LATER);
+
+		FileDescriptor accepted(syscalls::accept(server, NULL, NULL), NULL, 0);
+		ensure_equals(session->continueInitiate(), AbstractSession::INITIATED);
+		ensure(session->initiated());
+		process->sessionClosed(session.get());
+		session->close(false);
+		ensure_equals(socket->totalConnections, 0);
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("Checking out the last pooled connection prewarms another one");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 0));
+
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+		process->sessionClosed(session.get());
+		session->close(true, true);
+		ensure_equals(socket->totalConnections, 1);
+		ensure_equals(socket->totalIdleConnections, 1);
+
+		session = process->newSession();
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+		ensure_equals("(a connection was prewarmed)", socket->totalConnections, 2);
+		ensure_equals(socket->totalIdleConnections, 1);
+
+		SessionPtr session2 = process->newSession();
+		ensure_equals(session2->beginInitiate(), AbstractSession::INITIATED);
+		ensure_equals("(another connection was prewarmed)", socket->totalConnections, 3);
+		ensure_equals(socket->totalIdleConnections, 1);
+
+		process->sessionClosed(session.get());
+		session->close(false);
+		process->sessionClosed(session2.get());
+		session2->close(false);
+		ensure_equals(socket->totalConnections, 1);
+	}
+
+	TEST_METHOD(9) {
+		set_test_name("fillConnectionPool() establishes connections up to the "
+			"target, and inspectXml() reports them");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 0));
+
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure_equals(socket->connectionPoolTarget(),
+			(int) Socket::MAX_CONNECTION_POOL_TARGET);
+		ensure_equals(socket->fillConnectionPool(),
+			(unsigned int) Socket::MAX_CONNECTION_POOL_TARGET);
+		ensure_equals(socket->totalIdleConnections,
+			(int) Socket::MAX_CONNECTION_POOL_TARGET);
+		ensure_equals("(already full)", socket->fillConnectionPool(), 0u);
+
+		stringstream stream;
+		process->inspectXml(stream);
+		ensure(containsSubstring(stream.str(),
+			"<connection_pool_target>16</connection_pool_target>"
+			"<idle_connections>16</idle_connections>"
+			"<total_connections>16</total_connections>"));
+
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+		ensure_equals("(a prewarmed connection is used)",
+			socket->totalIdleConnections, 15);
+		process->sessionClosed(session.get());
+		session->close(false);
+		ensure_equals(socket->fillConnectionPool(), 1u);
+		ensure_equals(socket->totalConnections, 16);
+	}
+
+	TEST_METHOD(10) {
+		set_test_name("Sockets with a limited concurrency are not prewarmed, "
+			"because the app dedicates a thread to every connection");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 3));
+
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure(!socket->canPrewarmConnections());
+		ensure_equals(socket->connectionPoolTarget(), 0);
+		ensure_equals(socket->fillConnectionPool(), 0u);
+		ensure_equals(socket->prewarmConnections(1), 0u);
+
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+		ensure_equals("(no connection was prewarmed)", socket->totalConnections, 1);
+		process->sessionClosed(session.get());
+		session->close(true, true);
+		ensure_equals("(keep-alive connections are still pooled)",
+			socket->totalIdleConnections, 1);
+	}
+
+	TEST_METHOD(11) {
+		set_test_name("Keep-alive connections to sockets with unlimited concurrency "
+			"are pooled, up to MAX_CONNECTION_POOL_TARGET connections");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 0));
+		vector<SessionPtr> sessions;
+		Socket *socket = NULL;
+
+		for (int i = 0; i < Socket::MAX_CONNECTION_POOL_TARGET + 2; i++) {
+			SessionPtr session = process->newSession();
+			socket = session->getSocket();
+			ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+			sessions.push_back(session);
+		}
+		ensure_equals(socket->totalConnections, Socket::MAX_CONNECTION_POOL_TARGET + 2);
+		ensure_equals(socket->totalIdleConnections, 0);
+
+		for (unsigned int i = 0; i < sessions.size(); i++) {
+			process->sessionClosed(sessions[i].get());
+			sessions[i]->close(true, true);
+		}
+		ensure_equals(socket->totalConnections, (int) Socket::MAX_CONNECTION_POOL_TARGET);
+		ensure_equals(socket->totalIdleConnections, (int) Socket::MAX_CONNECTION_POOL_TARGET);
+	}
+
+	TEST_METHOD(12) {
+		set_test_name("prewarmConnections() releases the reserved connection slot "
+			"if the connection cannot be established");
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			"/nonexistant", 0));
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure_equals(socket->prewarmConnections(1), 0u);
+		ensure_equals(socket->totalConnections, 0);
+		ensure_equals(socket->totalIdleConnections, 0);
+		process->sessionClosed(session.get());
+	}
+
+	TEST_METHOD(13) {
+		set_test_name("closeConnectionPool() closes idle connections and stops "
+			"pooling and prewarming connections");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 0));
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		ensure_equals(session->beginInitiate(), AbstractSession::INITIATED);
+		ensure_equals(socket->fillConnectionPool(), 15u);
+		ensure_equals(socket->totalConnections, 16);
+
+		socket->closeConnectionPool();
+		ensure_equals(socket->totalConnections, 1);
+		ensure_equals(socket->totalIdleConnections, 0);
+		ensure_equals("(no connections are prewarmed)", socket->fillConnectionPool(), 0u);
+
+		process->sessionClosed(session.get());
+		session->close(true, true);
+		ensure_equals("(the connection is not pooled)", socket->totalConnections, 0);
+		ensure_equals(socket->totalIdleConnections, 0);
+	}
+
+	TEST_METHOD(14) {
+		set_test_name("triggerShutdown() closes the connection pools, so that "
+			"idle connections don't keep the app from exiting");
+		TempDir tmpdir("tmp.process");
+		string filename = "tmp.process/socket";
+		FileDescriptor server(createUnixServer(filename, 0, true, __FILE__, __LINE__),
+			NULL, 0);
+		ProcessPtr process = createProcess(createUnixSocketDescription(
+			absolutizePath(filename), 0));
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+		process->sessionClosed(session.get());
+		ensure_equals(socket->fillConnectionPool(), 16u);
+
+		FileDescriptor accepted(syscalls::accept(server, NULL, NULL), NULL, 0);
+		process->triggerShutdown();
+		ensure_equals(socket->totalConnections, 0);
+		ensure_equals(socket->totalIdleConnections, 0);
+
+		char buf;
+		ensure_equals("(the app sees EOF)", syscalls::read(accepted, &buf, 1), (ssize_t) 0);
+	}
 }
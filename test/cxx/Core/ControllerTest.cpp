@@ -19,20 +19,41 @@ namespace tut {
 				ApplicationPool2::GetCallback callback)
 			{
 				callback(sessionToReturn, exceptionToReturn);
-				sessionToReturn.reset();
+				if (!keepSessionToReturn) {
+					sessionToReturn.reset();
+				}
 			}
 
 		public:
 			ApplicationPool2::AbstractSessionPtr sessionToReturn;
 			ApplicationPool2::ExceptionPtr exceptionToReturn;
+			bool keepSessionToReturn;
 
 			MyController(ServerKit::Context *context,
 				const Core::ControllerSchema &schema,
 				const Json::Value &initialConfig)
-				: Core::Controller(context, schema, initialConfig)
+				: Core::Controller(context, schema, initialConfig),
+				  keepSessionToReturn(false)
 				{ }
 		};
 
+		/**
+		 * A TestSession that can be handed out for many requests, for
+		 * benchmarking the steady-state request path. Setting up the
+		 * socket pair is not part of that path, so allocations made
+		 * while doing so are not counted.
+		 */
+		class BenchmarkSession: public TestSession {
+		public:
+			AtomicInt initiations;
+
+			virtual void initiate(bool blocking = true) {
+				AllocationCountingSuspender suspender;
+				TestSession::initiate(blocking);
+				initiations++;
+			}
+		};
+
 		BackgroundEventLoop bg;
 		ServerKit::Context context;
 		Core::ControllerSchema schema;
@@ -43,6 +64,7 @@ namespace tut {
 		Json::Value config;
 		int serverSocket;
 		TestSession testSession;
+		BenchmarkSession benchmarkSession;
 		FileDescriptor clientConnection;
 		BufferedIO clientConnectionIO;
 		string peerRequestHeader;
@@ -51,6 +73,9 @@ namespace tut {
 			: bg(false, true),
 			  context(bg.safe, bg.libuv_loop)
 		{
+			if (getenv("SERVER_KIT_TEST_IO_URING") != NULL) {
+				context.enableIoUring();
+			}
 			config["thread_number"] = 1;
 			config["multi_app"] = false;
 			config["app_root"] = "stub/rack";
@@ -137,6 +162,20 @@ namespace tut {
 			controller->sessionToReturn.reset(&testSession, false);
 		}
 
+		/**
+		 * Makes the controller use the given session for every request,
+		 * instead of only for the next one.
+		 */
+		void keepReturningSession(TestSession *session) {
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_keepReturningSession,
+				this, session));
+		}
+
+		void _keepReturningSession(TestSession *session) {
+			controller->sessionToReturn.reset(session);
+			controller->keepSessionToReturn = true;
+		}
+
 		MyController::State getServerState() {
 			Controller::State result;
 			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getServerState,
@@ -159,6 +198,19 @@ namespace tut {
 			*result = controller->totalBytesConsumed;
 		}
 
+		#ifdef SERVER_KIT_HAVE_SPLICE
+			boost::uint64_t getTotalBytesSpliced() {
+				boost::uint64_t result;
+				bg.safe->runSync(boost::bind(&Core_ControllerTest::_getTotalBytesSpliced,
+					this, &result));
+				return result;
+			}
+
+			void _getTotalBytesSpliced(boost::uint64_t *result) {
+				*result = controller->getTotalBytesSpliced();
+			}
+		#endif
+
 		string readPeerRequestHeader(string *peerRequestHeader = NULL) {
 			if (peerRequestHeader == NULL) {
 				peerRequestHeader = &this->peerRequestHeader;
@@ -247,6 +299,38 @@ namespace tut {
 		string readResponseBody() {
 			return clientConnectionIO.readAll();
 		}
+
+		void performBenchmarkRequest() {
+			BenchmarkSession &session = benchmarkSession;
+			int initiations = session.initiations;
+			char body[5];
+
+			sendRequest(
+				"GET /hello HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"\r\n");
+			EVENTUALLY(5,
+				result = session.initiations > initiations;
+			);
+
+			readScalarMessage(session.peerFd());
+			writeExact(session.peerFd(),
+				"HTTP/1.1 200 OK\r\n"
+				"Content-Length: 5\r\n\r\n"
+				"hello");
+			session.closePeerFd();
+
+			ensure(containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+			ensure_equals(clientConnectionIO.read(body, sizeof(body)), sizeof(body));
+		}
+
+		void _startCountingAllocations() {
+			startCountingAllocations();
+		}
+
+		void _stopCountingAllocations(unsigned long long *result) {
+			*result = stopCountingAllocations();
+		}
 	};
 
 	DEFINE_TEST_GROUP(Core_ControllerTest);
@@ -408,6 +492,155 @@ namespace tut {
 		ensure_equals(body, "hello");
 	}
 
+	TEST_METHOD(14) {
+		set_test_name("Large fixed response body");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string expectedBody;
+		for (unsigned int i = 0; i < 1024 * 1024; i++) {
+			expectedBody.append(1, (char) ('a' + i % 26));
+		}
+		string response = "HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: " + toString(expectedBody.size()) + "\r\n\r\n"
+			+ expectedBody;
+		TempThread thr(boost::bind(&Core_ControllerTest::sendPeerResponse, this,
+			StaticString(response)));
+
+		string header = readResponseHeader();
+		string body = readResponseBody();
+		ensure("HTTP response OK", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("Body size", body.size(), expectedBody.size());
+		ensure("Body contents", body == expectedBody);
+		#ifdef SERVER_KIT_HAVE_SPLICE
+			if (!context.usingIoUring()) {
+				ensure("The body was spliced", getTotalBytesSpliced() > 0);
+			}
+		#endif
+	}
+
+	TEST_METHOD(15) {
+		set_test_name("Large fixed request body");
+
+		init();
+		useTestSessionObject();
+
+		string body;
+		for (unsigned int i = 0; i < 1024 * 1024; i++) {
+			body.append(1, (char) ('a' + i % 26));
+		}
+
+		connectToServer();
+		sendRequest(
+			"POST /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		TempThread thr(boost::bind(&Core_ControllerTest::sendRequest, this,
+			StaticString(body)));
+
+		// The end of the request body is passed to the app as a half-close event.
+		string peerBody = readAll(testSession.peerFd());
+		ensure_equals("Body size", peerBody.size(), body.size());
+		ensure("Body contents", peerBody == body);
+		#ifdef SERVER_KIT_HAVE_SPLICE
+			if (!context.usingIoUring()) {
+				ensure("The body was spliced", getTotalBytesSpliced() > 0);
+			}
+		#endif
+
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Length: 2\r\n\r\n"
+			"ok");
+		waitUntilSessionClosed();
+		ensure(testSession.isSuccessful());
+	}
+
+	TEST_METHOD(16) {
+		set_test_name("Chunked response body consisting of many small chunks");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		string chunks;
+		for (unsigned int i = 1; i <= 100; i++) {
+			chunks.append(integerToHex(i) + "\r\n" + string(i, 'x') + "\r\n");
+		}
+		chunks.append("0\r\n\r\n");
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Transfer-Encoding: chunked\r\n\r\n"
+			+ chunks);
+
+		string header = readResponseHeader();
+		string body = readResponseBody();
+		ensure("HTTP response OK", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals(body, chunks);
+	}
+
+	TEST_METHOD(17) {
+		set_test_name("Clients that stop sending a spliced request body are "
+			"disconnected after client_body_timeout");
+
+		config["client_body_timeout"] = 1;
+		init();
+		useTestSessionObject();
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		connectToServer();
+		sendRequest(
+			"POST /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Content-Length: 1048576\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		// The first part of the body is read normally, after which the
+		// rest of the body is spliced.
+		sendRequestAndWait(string(16 * 1024, 'x'));
+		sendRequestAndWait(string(64 * 1024, 'x'));
+		#ifdef SERVER_KIT_HAVE_SPLICE
+			if (!context.usingIoUring()) {
+				ensure("The body was spliced", getTotalBytesSpliced() > 0);
+			}
+		#endif
+
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+		ensure_equals("(1)", readAll(clientConnection), "");
+		MonotonicTimeUsec duration = SystemTime::getMonotonicUsec() - startTime;
+		ensure("(2)", duration >= 900000);
+		ensure("(3)", duration <= 3000000);
+	}
+
 
 	/***** Application connection keep-alive *****/
 
@@ -854,4 +1087,84 @@ namespace tut {
 		string header = readResponseHeader();
 		ensure(containsSubstring(header, "HTTP/1.1 502"));
 	}
+
+
+	/***** Connecting to the app *****/
+
+	TEST_METHOD(45) {
+		set_test_name("If the app does not accept the connection right away, "
+			"it retries from the event loop");
+
+		init();
+		useTestSessionObject();
+		testSession.setInitiateRetries(3);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("REQUEST_URI\0/hello\0")));
+	}
+
+	TEST_METHOD(46) {
+		set_test_name("It gives up if the app does not accept the connection "
+			"within app_connect_timeout");
+
+		config["app_connect_timeout"] = 10;
+		init();
+		keepReturningSession(&testSession);
+		testSession.setInitiateRetries(UINT_MAX);
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		ensure_equals(readAll(clientConnection), "");
+		ensure("(the session is closed)", testSession.isClosed());
+		ensure_equals("(no connection was made)", testSession.fd(), -1);
+	}
+
+
+	/***** Benchmarks *****/
+
+	TEST_METHOD(50) {
+		set_test_name("Once warmed up, the request path does not allocate heap memory");
+
+		if (!allocationCountingSupported()) {
+			return;
+		}
+
+		unsigned long long allocations;
+		const unsigned int warmupRequests = 50;
+		const unsigned int requests = 100;
+
+		init();
+		keepReturningSession(&benchmarkSession);
+		connectToServer();
+		// Warm up long enough for the mbuf pool to have grown and for the
+		// turbocache to have decided to bypass this (uncacheable) key.
+		for (unsigned int i = 0; i < warmupRequests; i++) {
+			performBenchmarkRequest();
+		}
+
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_startCountingAllocations,
+			this));
+		for (unsigned int i = 0; i < requests; i++) {
+			performBenchmarkRequest();
+		}
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_stopCountingAllocations,
+			this, &allocations));
+
+		ensure_equals(("Allocations per request: " + toString(allocations / (double) requests)).c_str(),
+			allocations, 0ull);
+	}
 }
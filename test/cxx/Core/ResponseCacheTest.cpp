@@ -2,9 +2,12 @@
 #include <time.h>
 #include <ServerKit/HttpRequest.h>
 #include <MemoryKit/palloc.h>
+#include <MemoryKit/mbuf.h>
 #include <Core/Controller/Request.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/ResponseCache.h>
+#include <Core/Controller/TurboCaching.h>
+#include <Core/SharedResponseCache.h>
 
 using namespace Passenger;
 using namespace Passenger::Core;
@@ -15,6 +18,7 @@ namespace tut {
 	typedef ResponseCache<Request> ResponseCacheType;
 
 	struct Core_ResponseCacheTest {
+		struct MemoryKit::mbuf_pool mbufPool;
 		ResponseCacheType responseCache;
 		Request req;
 		Core::ControllerSchema schema;
@@ -27,10 +31,15 @@ namespace tut {
 			config["multi_app"] = false;
 			config["default_server_name"] = "localhost";
 			config["default_server_port"] = "80";
+			mbufPool.mbuf_block_chunk_size = DEFAULT_MBUF_CHUNK_SIZE;
+			MemoryKit::mbuf_pool_init(&mbufPool);
+			responseCache.initialize(&mbufPool);
 			reset();
 		}
 
 		~Core_ResponseCacheTest() {
+			responseCache.clear();
+			MemoryKit::mbuf_pool_deinit(&mbufPool);
 			psg_destroy_pool(req.pool);
 		}
 
@@ -152,6 +161,28 @@ namespace tut {
 			req.appResponse.bodyType = AppResponse::RBT_CONTENT_LENGTH;
 			req.appResponse.aux.bodyInfo.contentLength = body.size();
 		}
+
+		void resetWithPath(const char *path) {
+			reset();
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, path);
+		}
+
+		bool fetchPath(const char *path) {
+			resetWithPath(path);
+			ensure(responseCache.prepareRequest(this, &req));
+			return responseCache.fetch(&req, time(NULL)).valid();
+		}
+
+		ResponseCacheType::Entry storePath(const char *path, unsigned int bodySize = 5) {
+			resetWithPath(path);
+			initCacheableResponse();
+			initResponseBody(string(bodySize, 'x'));
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsStoring(&req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+			return responseCache.store(&req, time(NULL), 20, bodySize);
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 100);
@@ -571,4 +602,339 @@ namespace tut {
 		ResponseCacheType::Entry entry2(responseCache.fetch(&req, time(NULL)));
 		ensure("(22)", !entry2.valid());
 	}
+
+
+	/***** Capacity management *****/
+
+	TEST_METHOD(70) {
+		set_test_name("When the entry limit is reached, the least recently used entry is evicted");
+		responseCache.initialize(&mbufPool, 2);
+		ensure("(1)", storePath("/a").valid());
+		ensure("(2)", storePath("/b").valid());
+		ensure("(3)", fetchPath("/a"));
+
+		ensure("(4)", !fetchPath("/c"));
+		ensure("(5)", storePath("/c").valid());
+		ensure_equals("(6)", responseCache.getEntryCount(), 2u);
+		ensure_equals("(7)", responseCache.getEvictions(), 1u);
+		ensure("(8)", fetchPath("/a"));
+		ensure("(9)", !fetchPath("/b"));
+		ensure("(10)", fetchPath("/c"));
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("The cache does not use more memory than its budget");
+		size_t blockSize = MemoryKit::mbuf_pool_data_size(&mbufPool) + sizeof(MemoryKit::mbuf_block);
+		responseCache.initialize(&mbufPool, 100, 2 * blockSize);
+		ensure("(1)", storePath("/a").valid());
+		ensure("(2)", storePath("/b").valid());
+		ensure_equals("(3)", responseCache.getMemoryUsage(), 2 * blockSize);
+
+		ensure("(4)", !fetchPath("/c"));
+		ensure("(5)", storePath("/c").valid());
+		ensure_equals("(6)", responseCache.getEntryCount(), 2u);
+		ensure_equals("(7)", responseCache.getMemoryUsage(), 2 * blockSize);
+		ensure("(8)", !fetchPath("/a"));
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("Responses larger than an mbuf block are stored in a block of their own size");
+		unsigned int bodySize = MemoryKit::mbuf_pool_data_size(&mbufPool) * 2;
+		ResponseCacheType::Entry entry(storePath("/a", bodySize));
+		ensure("(1)", entry.valid());
+		ensure_equals("(2)", entry.body->httpBodySize, bodySize);
+		ensure_equals("(3)", responseCache.getMemoryUsage(),
+			entry.body->data.size() + sizeof(MemoryKit::mbuf_block));
+
+		responseCache.clear();
+		ensure_equals("(4)", responseCache.getEntryCount(), 0u);
+		ensure_equals("(5)", responseCache.getMemoryUsage(), 0u);
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("A full cache rejects responses whose keys are requested less often than the eviction candidate");
+		responseCache.initialize(&mbufPool, 1);
+		fetchPath("/a");
+		fetchPath("/a");
+		ensure("(1)", storePath("/a").valid());
+
+		unsigned int stores = responseCache.getStores();
+		ensure("(2)", !storePath("/b").valid());
+		ensure_equals("(3)", responseCache.getRejections(), 1u);
+		ensure_equals("Rejections do not count as failed stores",
+			responseCache.getStores(), stores);
+		ensure("(5)", fetchPath("/a"));
+	}
+
+	TEST_METHOD(74) {
+		set_test_name("Storing a response under an existing key replaces the old entry");
+		responseCache.initialize(&mbufPool, 1);
+		ensure("(1)", storePath("/a", 5).valid());
+		ensure("(2)", storePath("/a", 10).valid());
+		ensure_equals("(3)", responseCache.getEntryCount(), 1u);
+		ensure_equals("(4)", responseCache.getRejections(), 0u);
+
+		resetWithPath("/a");
+		ensure("(5)", responseCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL)));
+		ensure("(6)", entry.valid());
+		ensure_equals("(7)", entry.body->httpBodySize, 10u);
+	}
+
+
+	/***** Shared mode *****/
+
+	TEST_METHOD(80) {
+		set_test_name("In shared mode, a response stored by one thread can be fetched by another");
+		SharedResponseCache sharedCache(2, 100, 1024 * 1024);
+		ResponseCacheType otherCache;
+		otherCache.initialize(&mbufPool);
+		responseCache.useSharedCache(&sharedCache);
+		otherCache.useSharedCache(&sharedCache);
+		responseCache.sharedCacheReaderOnline();
+		otherCache.sharedCacheReaderOnline();
+
+		ResponseCacheType::Entry entry(storePath("/a", 5));
+		ensure("(1)", entry.valid());
+		memset(entry.body->getHttpHeaderData(), 'h', entry.body->httpHeaderSize);
+		memcpy(entry.body->getHttpBodyData(), "hello", 5);
+		ensure_equals("Not visible before being committed", sharedCache.getEntryCount(), 0u);
+		responseCache.commit(entry);
+		ensure_equals("(3)", sharedCache.getEntryCount(), 1u);
+		ensure_equals("(4)", responseCache.getEntryCount(), 0u);
+
+		resetWithPath("/a");
+		ensure("(5)", otherCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry2(otherCache.fetch(&req, time(NULL)));
+		ensure("(6)", entry2.valid());
+		ensure_equals("(7)", StaticString(entry2.body->getHttpBodyData(),
+			entry2.body->httpBodySize), StaticString("hello"));
+		ensure_equals("(8)", otherCache.getHits(), 1u);
+	}
+
+	TEST_METHOD(81) {
+		set_test_name("In shared mode, invalidation by one thread is visible to all threads");
+		SharedResponseCache sharedCache(2, 100, 1024 * 1024);
+		ResponseCacheType otherCache;
+		otherCache.initialize(&mbufPool);
+		responseCache.useSharedCache(&sharedCache);
+		otherCache.useSharedCache(&sharedCache);
+		responseCache.sharedCacheReaderOnline();
+		otherCache.sharedCacheReaderOnline();
+
+		ResponseCacheType::Entry entry(storePath("/"));
+		ensure("(1)", entry.valid());
+		responseCache.commit(entry);
+
+		reset();
+		req.method = HTTP_POST;
+		ensure("(2)", otherCache.prepareRequest(this, &req));
+		ensure("(3)", otherCache.requestAllowsInvalidating(&req));
+		otherCache.invalidate(&req);
+
+		ensure("(4)", !fetchPath("/"));
+		ensure_equals("(5)", sharedCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(82) {
+		set_test_name("Shared records are not freed while an online reader may still access them");
+		SharedResponseCache sharedCache(2, 100, 1024 * 1024);
+		unsigned int reader1 = sharedCache.registerReader();
+		unsigned int reader2 = sharedCache.registerReader();
+		HashedStaticString key("foo");
+
+		sharedCache.insert(sharedCache.createRecord(key, key.hash(), 0, 0, 0, 0));
+		sharedCache.readerOnline(reader1);
+		sharedCache.readerOnline(reader2);
+		ensure("(1)", sharedCache.lookup(key, key.hash()) != NULL);
+
+		sharedCache.remove(key, key.hash());
+		ensure("(2)", sharedCache.lookup(key, key.hash()) == NULL);
+		ensure_equals("(3)", sharedCache.getRetiredCount(), 1u);
+
+		sharedCache.readerOnline(reader1);
+		sharedCache.reclaim();
+		ensure_equals("Reader 2 has not passed a quiescent state yet",
+			sharedCache.getRetiredCount(), 1u);
+
+		sharedCache.readerOffline(reader2);
+		sharedCache.reclaim();
+		ensure_equals("(5)", sharedCache.getRetiredCount(), 0u);
+	}
+
+	TEST_METHOD(83) {
+		set_test_name("The shared cache evicts records to stay within its limits");
+		SharedResponseCache sharedCache(1, SharedResponseCache::SHARD_COUNT, 1024 * 1024);
+		for (unsigned int i = 0; i < 100; i++) {
+			HashedStaticString key(toString(i));
+			sharedCache.insert(sharedCache.createRecord(key, key.hash(), 0, 0, 0, 0));
+		}
+		ensure("(1)", sharedCache.getEntryCount() <= (unsigned int) SharedResponseCache::SHARD_COUNT);
+		ensure_equals("(2)", sharedCache.getEntryCount() + sharedCache.getEvictions(), 100u);
+		ensure_equals("(3)", sharedCache.getRetiredCount(), 0u);
+	}
+
+
+	/***** Stale responses *****/
+
+	TEST_METHOD(90) {
+		set_test_name("Expired entries are retained during their stale-while-revalidate period");
+		resetWithPath("/a");
+		insertAppResponseHeader(createHeader("cache-control",
+			"public,max-age=1,stale-while-revalidate=60"), req.pool);
+		initResponseBody("hello");
+		ensure("(1)", responseCache.prepareRequest(this, &req));
+		ensure("(2)", responseCache.prepareRequestForStoring(&req));
+		ensure("(3)", responseCache.store(&req, time(NULL), 20, 5).valid());
+
+		resetWithPath("/a");
+		ensure("(4)", responseCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL) + 10));
+		ensure("(5)", !entry.valid());
+		ensure_equals("(6)", entry.cacheMissReason, ResponseCacheType::Entry::NOT_FRESH);
+		ensure_equals("(7)", responseCache.getEntryCount(), 1u);
+		ensure("(8)", responseCache.fetchStale(&req, time(NULL) + 10,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+		ensure("No stale-if-error period was given", !responseCache.fetchStale(&req,
+			time(NULL) + 10, ResponseCacheType::STALE_IF_ERROR).valid());
+		ensure("(10)", !responseCache.fetchStale(&req, time(NULL) + 100,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+
+		responseCache.fetch(&req, time(NULL) + 100);
+		ensure_equals("Erased after the stale period", responseCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(91) {
+		set_test_name("Entries may be served during their stale-if-error period");
+		resetWithPath("/a");
+		insertAppResponseHeader(createHeader("cache-control",
+			"public, max-age=1, stale-if-error=60"), req.pool);
+		initResponseBody("hello");
+		ensure("(1)", responseCache.prepareRequest(this, &req));
+		ensure("(2)", responseCache.prepareRequestForStoring(&req));
+		ensure("(3)", responseCache.store(&req, time(NULL), 20, 5).valid());
+
+		resetWithPath("/a");
+		ensure("(4)", responseCache.prepareRequest(this, &req));
+		ensure("(5)", responseCache.fetchStale(&req, time(NULL) + 10,
+			ResponseCacheType::STALE_IF_ERROR).valid());
+		ensure("(6)", !responseCache.fetchStale(&req, time(NULL) + 10,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+	}
+
+	TEST_METHOD(92) {
+		set_test_name("Entries without stale directives are not served stale");
+		storePath("/a");
+		resetWithPath("/a");
+		ensure("(1)", responseCache.prepareRequest(this, &req));
+		ensure("(2)", !responseCache.fetchStale(&req, time(NULL) + 999999,
+			ResponseCacheType::STALE_IF_ERROR).valid());
+	}
+
+	TEST_METHOD(93) {
+		set_test_name("Stale entries can still be served after the periodic TurboCaching state update");
+		TurboCaching<Request> turboCaching;
+		ResponseCacheType &cache = turboCaching.responseCache;
+		turboCaching.initialize(true, &mbufPool);
+		time_t now = time(NULL);
+
+		resetWithPath("/a");
+		insertAppResponseHeader(createHeader("cache-control",
+			"public,max-age=1,stale-while-revalidate=60"), req.pool);
+		initResponseBody("hello");
+		ensure("(1)", cache.prepareRequest(this, &req));
+		ensure("(2)", cache.prepareRequestForStoring(&req));
+		ensure("(3)", cache.store(&req, now, 20, 5).valid());
+
+		turboCaching.updateState(now + TurboCaching<Request>::ENABLED_TIMEOUT + 1);
+		ensure_equals("(4)", cache.getEntryCount(), 1u);
+
+		resetWithPath("/a");
+		ensure("(5)", cache.prepareRequest(this, &req));
+		ensure("(6)", !cache.fetch(&req, now + 10).valid());
+		ensure("(7)", cache.fetchStale(&req, now + 10,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+	}
+
+
+	/***** Per-key statistics *****/
+
+	TEST_METHOD(95) {
+		set_test_name("Fetches and stores are counted per key");
+		HashedStaticString keyA, keyB;
+
+		storePath("/a");
+		keyA = req.cacheKey;
+		fetchPath("/a");
+		fetchPath("/a");
+		fetchPath("/b");
+		keyB = req.cacheKey;
+		responseCache.incStores(&req);
+
+		ResponseCacheKeyStatistics::Counts a = responseCache.getKeyStatistics()
+			.estimate(keyA.hash());
+		ensure_equals("(1)", a.fetches, 2u);
+		ensure_equals("(2)", a.hits, 2u);
+		ensure_equals("(3)", a.stores, 1u);
+		ensure_equals("(4)", a.storeSuccesses, 1u);
+
+		ResponseCacheKeyStatistics::Counts b = responseCache.getKeyStatistics()
+			.estimate(keyB.hash());
+		ensure_equals("(5)", b.fetches, 1u);
+		ensure_equals("(6)", b.hits, 0u);
+		ensure_equals("(7)", b.stores, 1u);
+		ensure_equals("(8)", b.storeSuccesses, 0u);
+	}
+
+	TEST_METHOD(96) {
+		set_test_name("Per-key statistics survive clearing and decay over time");
+		ResponseCacheKeyStatistics stats(16);
+		for (unsigned int i = 0; i < 10; i++) {
+			stats.recordFetch(1234, i % 2 == 0);
+		}
+		ensure_equals("(1)", stats.estimate(1234).fetches, 10u);
+		ensure_equals("(2)", stats.estimate(1234).hits, 5u);
+		stats.decay();
+		ensure_equals("(3)", stats.estimate(1234).fetches, 5u);
+		ensure_equals("(4)", stats.estimate(1234).hits, 2u);
+		ensure_equals("(5)", stats.estimate(5678).fetches, 0u);
+	}
+
+	TEST_METHOD(97) {
+		set_test_name("Only keys with poor statistics are bypassed");
+		TurboCaching<Request> turboCaching;
+		ResponseCacheType &cache = turboCaching.responseCache;
+		turboCaching.initialize(true, &mbufPool);
+
+		resetWithPath("/cacheable");
+		initCacheableResponse();
+		initResponseBody("hello");
+		ensure("(1)", cache.prepareRequest(this, &req));
+		ensure("(2)", cache.prepareRequestForStoring(&req));
+		ensure("(3)", cache.store(&req, time(NULL), 20, 5).valid());
+		HashedStaticString cacheable = req.cacheKey;
+
+		for (unsigned int i = 0; i < TurboCaching<Request>::FETCH_THRESHOLD; i++) {
+			resetWithPath("/cacheable");
+			ensure(cache.prepareRequest(this, &req));
+			cache.fetch(&req, time(NULL));
+			resetWithPath("/uncacheable");
+			ensure(cache.prepareRequest(this, &req));
+			cache.fetch(&req, time(NULL));
+		}
+		HashedStaticString uncacheable = req.cacheKey;
+		ensure("(4)", turboCaching.shouldBypass(uncacheable.hash()));
+		ensure("(5)", !turboCaching.shouldBypass(cacheable.hash()));
+
+		turboCaching.recordBypass(uncacheable);
+		ensure_equals("(6)", turboCaching.bypassedRequests, 1u);
+		Json::Value doc = turboCaching.inspectBypassedKeysAsJson();
+		ensure_equals("(7)", doc.size(), 1u);
+		ensure_equals("(8)", doc[0u]["fetches"].asUInt(),
+			(unsigned int) TurboCaching<Request>::FETCH_THRESHOLD);
+
+		cache.decayKeyStatistics();
+		ensure("Given another chance after the counts have decayed",
+			!turboCaching.shouldBypass(uncacheable.hash()));
+	}
 }
@@ -4,6 +4,10 @@
 #include <oxt/system_calls.hpp>
 #include <boost/bind.hpp>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
 #include <cerrno>
 #include <string>
 
@@ -844,6 +848,51 @@ namespace tut {
 		}
 	}
 
+	/***** Test createTcpServer() *****/
+
+	TEST_METHOD(75) {
+		set_test_name("Multiple SO_REUSEPORT sockets can listen on the same port");
+		#ifdef __linux__
+			FileDescriptor server1(createTcpServer("127.0.0.1", 0, 0,
+				__FILE__, __LINE__, true), __FILE__, __LINE__);
+			struct sockaddr_in addr;
+			socklen_t len = sizeof(addr);
+			ensure_equals(getsockname(server1, (struct sockaddr *) &addr, &len), 0);
+			unsigned short port = ntohs(addr.sin_port);
+
+			FileDescriptor server2(createTcpServer("127.0.0.1", port, 0,
+				__FILE__, __LINE__, true), __FILE__, __LINE__);
+			attachReusePortCpuSteering(server1, 2);
+
+			FileDescriptor client(connectToTcpServer("127.0.0.1", port,
+				__FILE__, __LINE__), __FILE__, __LINE__);
+			struct pollfd fds[2];
+			fds[0].fd = server1;
+			fds[0].events = POLLIN;
+			fds[1].fd = server2;
+			fds[1].events = POLLIN;
+			ensure_equals("One of the sockets receives the connection",
+				poll(fds, 2, 1000), 1);
+		#endif
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("Binding to a port in use fails if not all sockets set SO_REUSEPORT");
+		FileDescriptor server1(createTcpServer("127.0.0.1", 0, 0,
+			__FILE__, __LINE__), __FILE__, __LINE__);
+		struct sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		ensure_equals(getsockname(server1, (struct sockaddr *) &addr, &len), 0);
+
+		try {
+			createTcpServer("127.0.0.1", ntohs(addr.sin_port), 0,
+				__FILE__, __LINE__, true);
+			fail("SystemException expected");
+		} catch (const SystemException &e) {
+			ensure_equals(e.code(), EADDRINUSE);
+		}
+	}
+
 	/***** Test readFileDescriptor() and writeFileDescriptor() *****/
 
 	TEST_METHOD(80) {
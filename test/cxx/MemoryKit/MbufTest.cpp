@@ -264,4 +264,141 @@ namespace tut {
 		ensure_equals("(5)", pool.nfree_mbuf_blockq, 0u);
 		ensure_equals("(6)", pool.nactive_mbuf_blockq, 0u);
 	}
+
+	/***** Slab mode *****/
+
+	TEST_METHOD(30) {
+		set_test_name("mbuf_pool_enable_slabs() preallocates the reserved slabs");
+		unsigned int blocksPerSlab = MBUF_SLAB_SIZE / pool.mbuf_block_chunk_size;
+
+		ensure("(1)", mbuf_pool_enable_slabs(&pool, -1, 1));
+		ensure("(2)", pool.slab_mode);
+		ensure_equals("(3)", pool.nslabs, 1u);
+		ensure_equals("(4)", pool.nfree_mbuf_blockq, blocksPerSlab);
+		ensure_equals("(5)", pool.nactive_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(31) {
+		set_test_name("In slab mode, blocks are carved from aligned slab regions");
+		ensure(mbuf_pool_enable_slabs(&pool, -1, 1));
+
+		struct mbuf_block *block = mbuf_block_get(&pool);
+		char *start = STAILQ_FIRST(&pool.slabs)->start;
+		ensure_equals("(1)", (uintptr_t) start % MBUF_SLAB_SIZE, (uintptr_t) 0);
+		ensure("(2)", block->start >= start);
+		ensure("(3)", block->end <= start + MBUF_SLAB_SIZE);
+		ensure_equals("(4)", pool.nactive_mbuf_blockq, 1u);
+
+		memset(block->start, 'x', block->end - block->start);
+		mbuf_block_unref(block);
+		ensure_equals("(5)", pool.nactive_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(32) {
+		set_test_name("In slab mode, a new slab is allocated when the freelist is exhausted");
+		unsigned int i, blocksPerSlab = MBUF_SLAB_SIZE / pool.mbuf_block_chunk_size;
+		vector<struct mbuf_block *> blocks;
+
+		ensure(mbuf_pool_enable_slabs(&pool, -1, 1));
+		for (i = 0; i < blocksPerSlab + 1; i++) {
+			blocks.push_back(mbuf_block_get(&pool));
+		}
+		ensure_equals("(1)", pool.nslabs, 2u);
+		ensure_equals("(2)", pool.nactive_mbuf_blockq, blocksPerSlab + 1);
+		ensure_equals("(3)", pool.nfree_mbuf_blockq, blocksPerSlab - 1);
+
+		for (i = 0; i < blocks.size(); i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+		ensure_equals("(4)", pool.nfree_mbuf_blockq, 2 * blocksPerSlab);
+	}
+
+	TEST_METHOD(33) {
+		set_test_name("In slab mode, compaction releases free slabs beyond the reserved number");
+		unsigned int i, blocksPerSlab = MBUF_SLAB_SIZE / pool.mbuf_block_chunk_size;
+		vector<struct mbuf_block *> blocks;
+
+		ensure(mbuf_pool_enable_slabs(&pool, -1, 1));
+		for (i = 0; i < 2 * blocksPerSlab + 1; i++) {
+			blocks.push_back(mbuf_block_get(&pool));
+		}
+		ensure_equals("(1)", pool.nslabs, 3u);
+
+		// Free everything except the last block, which lives in the third slab.
+		for (i = 0; i < 2 * blocksPerSlab; i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+		ensure_equals("(2)", mbuf_pool_compact(&pool), 2 * blocksPerSlab);
+		ensure_equals("(3)", pool.nslabs, 1u);
+		ensure_equals("(4)", pool.nfree_mbuf_blockq, blocksPerSlab - 1);
+
+		// The remaining free blocks must all be usable.
+		struct mbuf_block *last = blocks.back();
+		blocks.clear();
+		for (i = 0; i < blocksPerSlab - 1; i++) {
+			blocks.push_back(mbuf_block_get(&pool));
+		}
+		ensure_equals("(5)", pool.nslabs, 1u);
+		ensure_equals("(6)", pool.nfree_mbuf_blockq, 0u);
+		blocks.push_back(last);
+		for (i = 0; i < blocks.size(); i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+
+		// The pool always keeps the reserved number of slabs.
+		ensure_equals("(7)", mbuf_pool_compact(&pool), 0u);
+		ensure_equals("(8)", pool.nslabs, 1u);
+		ensure_equals("(9)", pool.nfree_mbuf_blockq, blocksPerSlab);
+	}
+
+	TEST_METHOD(34) {
+		set_test_name("mbuf_pool_enable_slabs() fails if blocks have already been allocated");
+		mbuf_block_unref(mbuf_block_get(&pool));
+		ensure(!mbuf_pool_enable_slabs(&pool, -1, 1));
+		ensure(!pool.slab_mode);
+	}
+
+	/***** Size classes *****/
+
+	TEST_METHOD(40) {
+		set_test_name("mbuf_pool_for_size() picks the smallest size class that fits");
+		struct mbuf_pool *small = mbuf_pool_for_size(&pool, 100);
+		ensure("(1)", small != &pool);
+		ensure_equals("(2)", small->mbuf_block_chunk_size, (size_t) 512);
+		ensure_equals("(3)", mbuf_pool_for_size(&pool, 100), small);
+		ensure_equals("(4)", mbuf_pool_for_size(&pool, 1000), &pool);
+		ensure_equals("(5)", mbuf_pool_for_size(&pool, mbuf_pool_data_size(&pool)), &pool);
+
+		struct mbuf_pool *large = mbuf_pool_for_size(&pool, mbuf_pool_data_size(&pool) + 1);
+		ensure("(6)", large != &pool);
+		ensure_equals("(7)", large->mbuf_block_chunk_size, (size_t) 16384);
+		ensure_equals("(8)", mbuf_pool_for_size(&pool, 1000000), large);
+	}
+
+	TEST_METHOD(41) {
+		set_test_name("Size class blocks return to their own pool");
+		struct mbuf_pool *small = mbuf_pool_for_size(&pool, 100);
+
+		{
+			mbuf buffer(mbuf_get_for_size(&pool, 100));
+			ensure_equals("(1)", buffer.size(), 512 - MBUF_BLOCK_HSIZE);
+			ensure_equals("(2)", small->nactive_mbuf_blockq, 1u);
+			ensure_equals("(3)", pool.nactive_mbuf_blockq, 0u);
+		}
+		ensure_equals("(4)", small->nactive_mbuf_blockq, 0u);
+		ensure_equals("(5)", small->nfree_mbuf_blockq, 1u);
+		ensure_equals("(6)", pool.nfree_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(42) {
+		set_test_name("mbuf_pool_compact() also compacts the size class pools");
+		mbuf_block_unref(mbuf_block_get(&pool));
+		mbuf_block_unref(mbuf_block_get(mbuf_pool_for_size(&pool, 100)));
+		mbuf_block_unref(mbuf_block_get(mbuf_pool_for_size(&pool, 10000)));
+
+		ensure_equals("(1)", mbuf_pool_compact(&pool), 3u);
+		ensure_equals("(2)", pool.nfree_mbuf_blockq, 0u);
+		ensure_equals("(3)", mbuf_pool_for_size(&pool, 100)->nfree_mbuf_blockq, 0u);
+		ensure_equals("(4)", mbuf_pool_for_size(&pool, 10000)->nfree_mbuf_blockq, 0u);
+	}
 }
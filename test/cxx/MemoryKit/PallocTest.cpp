@@ -439,4 +439,51 @@ namespace tut {
 		ensure("psg_reset_pool fails",
 			!psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE));
 	}
+
+	TEST_METHOD(21) {
+		set_test_name("psg_pool_used_size() includes block and large allocations");
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(1)", psg_pool_block_size(pool), (size_t) PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(2)", psg_pool_used_size(pool), (size_t) 0);
+
+		psg_pnalloc(pool, 100);
+		ensure_equals("(3)", psg_pool_used_size(pool), (size_t) 100);
+		ensure_equals("(4)", pool->nlarge, 0u);
+
+		// The large allocation's bookkeeping is allocated from the pool too.
+		psg_pnalloc(pool, PSG_MAX_ALLOC_FROM_POOL + 1);
+		size_t used = psg_pool_used_size(pool);
+		ensure("(5)", used >= PSG_MAX_ALLOC_FROM_POOL + 101 + sizeof(psg_pool_large_t));
+		ensure("(6)", used < PSG_MAX_ALLOC_FROM_POOL + 101 + sizeof(psg_pool_large_t)
+			+ PSG_ALIGNMENT);
+		ensure_equals("(7)", pool->nlarge, 1u);
+		ensure_equals("(8)", pool->max_alloc_size, (size_t) PSG_MAX_ALLOC_FROM_POOL + 1);
+
+		for (unsigned int i = 0; i < 10; i++) {
+			psg_pnalloc(pool, 2000);
+		}
+		ensure("(9)", pool->data.next != NULL);
+		ensure_equals("(10)", psg_pool_used_size(pool), used + 20000);
+
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(11)", psg_pool_used_size(pool), (size_t) 0);
+		ensure_equals("(12)", pool->nlarge, 0u);
+		ensure_equals("(13)", pool->max_alloc_size, (size_t) 0);
+	}
+
+	TEST_METHOD(22) {
+		set_test_name("Pools larger than the default serve larger objects from their blocks");
+		pool = psg_create_pool(4 * PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(1)", psg_pool_block_size(pool), (size_t) 4 * PSG_DEFAULT_POOL_SIZE);
+
+		char *buf = (char *) psg_pnalloc(pool, 8000);
+		ensure("(2)", buf > (char *) pool);
+		ensure("(3)", buf + 8000 <= pool->data.end);
+		ensure_equals("(4)", pool->nlarge, 0u);
+		ensure_equals<void *>("(5)", pool->large, NULL);
+
+		psg_pnalloc(pool, 4 * PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(6)", pool->nlarge, 1u);
+		ensure("(7)", psg_reset_pool(pool, 4 * PSG_DEFAULT_POOL_SIZE));
+	}
 }
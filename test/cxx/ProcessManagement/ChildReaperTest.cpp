@@ -0,0 +1,133 @@
+#include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <ProcessManagement/ChildReaper.h>
+#include <Utils/Timer.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct ProcessManagement_ChildReaperTest {
+		boost::mutex syncher;
+		boost::condition_variable cond;
+		pid_t exitedPid;
+		int exitStatus;
+		pid_t pid;
+
+		ProcessManagement_ChildReaperTest()
+			: exitedPid(-1),
+			  exitStatus(-2),
+			  pid(-1)
+			{ }
+
+		~ProcessManagement_ChildReaperTest() {
+			if (pid != -1) {
+				kill(pid, SIGKILL);
+				waitpid(pid, NULL, 0);
+			}
+		}
+
+		void startChild(unsigned int sleepTime, int exitCode) {
+			pid = fork();
+			if (pid == 0) {
+				usleep(sleepTime);
+				_exit(exitCode);
+			} else if (pid == -1) {
+				int e = errno;
+				throw SystemException("Cannot fork", e);
+			}
+		}
+
+		void onExit(pid_t pid, int status) {
+			boost::lock_guard<boost::mutex> l(syncher);
+			exitedPid = pid;
+			exitStatus = status;
+			cond.notify_all();
+		}
+
+		bool waitForExit(unsigned int timeout) {
+			boost::unique_lock<boost::mutex> l(syncher);
+			boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time()
+				+ boost::posix_time::milliseconds(timeout);
+			while (exitedPid == -1) {
+				if (!cond.timed_wait(l, deadline)) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	DEFINE_TEST_GROUP(ProcessManagement_ChildReaperTest);
+
+	TEST_METHOD(1) {
+		set_test_name("timedWaitpid() returns as soon as the child process exits");
+		int status;
+		startChild(100000, 3);
+
+		Timer<> timer;
+		ensure_equals(ChildReaper::timedWaitpid(pid, &status, 5000), pid);
+		ensure(timer.elapsed() < 2500);
+		ensure(WIFEXITED(status));
+		ensure_equals(WEXITSTATUS(status), 3);
+		pid = -1;
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("timedWaitpid() returns 0 if the child process doesn't exit in time");
+		startChild(60000000, 0);
+		ensure_equals(ChildReaper::timedWaitpid(pid, NULL, 50), 0);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("reap() reaps the child process in the background and reports its exit status");
+		startChild(50000, 4);
+		ChildReaper::getInstance().reap(pid,
+			boost::bind(&ProcessManagement_ChildReaperTest::onExit, this, _1, _2));
+
+		ensure("The callback is called", waitForExit(5000));
+		ensure_equals(exitedPid, pid);
+		ensure(WIFEXITED(exitStatus));
+		ensure_equals(WEXITSTATUS(exitStatus), 4);
+		ensure("The process has been reaped",
+			waitpid(pid, NULL, WNOHANG) == -1 && errno == ECHILD);
+		pid = -1;
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("notifyOnExit() reports that the process has exited without reaping it");
+		startChild(50000, 0);
+		if (!ChildReaper::getInstance().notifyOnExit(pid,
+			boost::bind(&ProcessManagement_ChildReaperTest::onExit, this, _1, _2)))
+		{
+			// Not supported on this platform.
+			return;
+		}
+
+		ensure("The callback is called", waitForExit(5000));
+		ensure_equals(exitedPid, pid);
+		ensure_equals("The process has not been reaped", waitpid(pid, NULL, WNOHANG), pid);
+		pid = -1;
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("reap() falls back to a blocking waiter thread for processes "
+			"that cannot be watched through a pidfd");
+		startChild(0, 0);
+		waitpid(pid, NULL, 0);
+		// The process no longer exists, so no pidfd can be opened for it.
+		ChildReaper::getInstance().reap(pid,
+			boost::bind(&ProcessManagement_ChildReaperTest::onExit, this, _1, _2));
+
+		ensure("The callback is called", waitForExit(5000));
+		ensure_equals(exitedPid, pid);
+		ensure_equals("The exit status is unknown", exitStatus, -1);
+		ensure_equals("No watch is left behind", ChildReaper::getInstance().getWatchCount(), 0u);
+		pid = -1;
+	}
+}
@@ -19,6 +19,7 @@ namespace tut {
 	struct ServerKit_FileBufferedChannelTest: public ServerKit::Hooks {
 		BackgroundEventLoop bg;
 		ServerKit::Context context;
+		FileBufferedChannelMemoryBudget memoryBudget;
 		FileBufferedChannel channel;
 		boost::mutex syncher;
 		int toConsume;
@@ -114,6 +115,18 @@ namespace tut {
 			channel.feedError(errcode);
 		}
 
+		void createAndFeedChannel(FileBufferedChannel **result) {
+			*result = new FileBufferedChannel(&context);
+			(*result)->setDataCallback(dataCallback);
+			(*result)->setHooks(this);
+			(*result)->feed("hello");
+			(*result)->feed("world");
+		}
+
+		void destroyChannel(FileBufferedChannel *channel) {
+			delete channel;
+		}
+
 		void channelConsumed(int size, bool end) {
 			bg.safe->runLater(boost::bind(&ServerKit_FileBufferedChannelTest::_channelConsumed,
 				this, size, end));
@@ -178,6 +191,17 @@ namespace tut {
 			*result = channel.getBytesBuffered();
 		}
 
+		unsigned int getChannelWriteOperations() {
+			Json::Value doc;
+			bg.safe->runSync(boost::bind(&ServerKit_FileBufferedChannelTest::_inspectChannel,
+				this, &doc));
+			return doc["write_operations"].asUInt();
+		}
+
+		void _inspectChannel(Json::Value *doc) {
+			*doc = channel.inspectAsJson();
+		}
+
 		void channelEnableAutoStartMover(bool enabled) {
 			bg.safe->runSync(boost::bind(&ServerKit_FileBufferedChannelTest::_channelEnableAutoStartMover,
 				this, enabled));
@@ -995,4 +1019,196 @@ namespace tut {
 			ensure_equals(counter, 2u);
 		}
 	}
+
+
+	/***** Moving buffers to disk *****/
+
+	TEST_METHOD(50) {
+		set_test_name("It moves all buffers that are queued up to the file "
+			"in a single write operation");
+
+		toConsume = -1;
+		context.defaultFileBufferedChannelConfig.threshold = 1;
+		context.defaultFileBufferedChannelConfig.delayInFileModeSwitching = 50;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world");
+		feedChannel("!");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE
+				&& getChannelBytesBuffered() == 0;
+		);
+		ensure_equals(getChannelWriterState(), FileBufferedChannel::WS_INACTIVE);
+		ensure_equals(getChannelWriteOperations(), 1u);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = log ==
+				"Data: hello\n"
+				"Data: world!\n";
+		);
+	}
+
+	TEST_METHOD(51) {
+		set_test_name("It writes no more than maxBuffersPerWrite buffers per write operation");
+
+		toConsume = -1;
+		context.defaultFileBufferedChannelConfig.threshold = 1;
+		context.defaultFileBufferedChannelConfig.delayInFileModeSwitching = 50;
+		context.defaultFileBufferedChannelConfig.maxBuffersPerWrite = 2;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world");
+		feedChannel("!");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE
+				&& getChannelBytesBuffered() == 0;
+		);
+		ensure_equals(getChannelWriteOperations(), 2u);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = log ==
+				"Data: hello\n"
+				"Data: world!\n";
+		);
+	}
+
+	TEST_METHOD(52) {
+		set_test_name("It can buffer to an unnamed file");
+
+		toConsume = -1;
+		context.defaultFileBufferedChannelConfig.threshold = 1;
+		context.defaultFileBufferedChannelConfig.fileType = FBC_UNNAMED_FILE;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world!");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE
+				&& getChannelWriterState() == FileBufferedChannel::WS_INACTIVE;
+		);
+		ensure_equals(getChannelBytesBuffered(), 0u);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = log ==
+				"Data: hello\n"
+				"Data: world!\n";
+		);
+	}
+
+	TEST_METHOD(53) {
+		set_test_name("It can buffer to a memfd");
+
+		toConsume = -1;
+		context.defaultFileBufferedChannelConfig.threshold = 1;
+		context.defaultFileBufferedChannelConfig.fileType = FBC_MEMFD;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world!");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE
+				&& getChannelWriterState() == FileBufferedChannel::WS_INACTIVE;
+		);
+		ensure_equals(getChannelBytesBuffered(), 0u);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = log ==
+				"Data: hello\n"
+				"Data: world!\n";
+		);
+	}
+
+
+	/***** Memory budget *****/
+
+	TEST_METHOD(55) {
+		set_test_name("While the memory budget isn't exhausted, it stays in the "
+			"in-memory mode regardless of the threshold");
+
+		toConsume = -1;
+		memoryBudget.limit = 1024;
+		memoryBudget.minThreshold = 1;
+		context.defaultFileBufferedChannelConfig.threshold = 1;
+		context.defaultFileBufferedChannelConfig.memoryBudget = &memoryBudget;
+		startLoop();
+
+		feedChannel("hello");
+		feedChannel("world");
+		EVENTUALLY(5,
+			result = getChannelBytesBuffered() == 5;
+		);
+		ensure_equals(getChannelMode(), FileBufferedChannel::IN_MEMORY_MODE);
+		ensure_equals(memoryBudget.used.load(), 5u);
+
+		channelConsumed(sizeof("hello") - 1, false);
+		EVENTUALLY(5,
+			result = getChannelBytesBuffered() == 0;
+		);
+		ensure_equals(memoryBudget.used.load(), 0u);
+	}
+
+	TEST_METHOD(56) {
+		set_test_name("When the memory budget is exhausted, it switches to the "
+			"in-file mode once it buffers at least minThreshold bytes");
+
+		toConsume = -1;
+		memoryBudget.limit = 4;
+		memoryBudget.minThreshold = 3;
+		context.defaultFileBufferedChannelConfig.memoryBudget = &memoryBudget;
+		startLoop();
+
+		feedChannel("ab");
+		feedChannel("cd");
+		EVENTUALLY(5,
+			result = getChannelBytesBuffered() == 2;
+		);
+		ensure_equals(getChannelMode(), FileBufferedChannel::IN_MEMORY_MODE);
+
+		feedChannel("efgh");
+		EVENTUALLY(5,
+			result = getChannelMode() == FileBufferedChannel::IN_FILE_MODE
+				&& getChannelBytesBuffered() == 0;
+		);
+		ensure_equals("Memory moved to disk is released from the budget",
+			memoryBudget.used.load(), 0u);
+
+		channelConsumed(sizeof("ab") - 1, false);
+		EVENTUALLY(5,
+			LOCK();
+			result = log ==
+				"Data: ab\n"
+				"Data: cdefgh\n";
+		);
+	}
+
+	TEST_METHOD(57) {
+		set_test_name("Destroying the channel releases its buffered data from "
+			"the memory budget");
+
+		toConsume = -1;
+		memoryBudget.limit = 1024;
+		memoryBudget.minThreshold = 1;
+		context.defaultFileBufferedChannelConfig.memoryBudget = &memoryBudget;
+		startLoop();
+
+		FileBufferedChannel *otherChannel = NULL;
+		bg.safe->runSync(boost::bind(&ServerKit_FileBufferedChannelTest::createAndFeedChannel,
+			this, &otherChannel));
+		EVENTUALLY(5,
+			result = memoryBudget.used.load() == 5u;
+		);
+		bg.safe->runSync(boost::bind(&ServerKit_FileBufferedChannelTest::destroyChannel,
+			this, otherChannel));
+		ensure_equals(memoryBudget.used.load(), 0u);
+	}
 }
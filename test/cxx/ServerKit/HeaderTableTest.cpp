@@ -191,4 +191,73 @@ namespace tut {
 
 		ensure_equals<void *>("(3)", table.lookup("Content-Length"), NULL);
 	}
+
+	TEST_METHOD(11) {
+		set_test_name("Every known header name maps to its own ID");
+		for (unsigned int i = 1; i < KNOWN_HEADER_COUNT; i++) {
+			ensure_equals(KNOWN_HEADER_NAMES[i].toString().c_str(),
+				(unsigned int) lookupKnownHeaderId(KNOWN_HEADER_NAMES[i].data(),
+					KNOWN_HEADER_NAMES[i].size()),
+				i);
+		}
+		ensure_equals("(1)", lookupKnownHeaderId("content-length", 14), KNOWN_HEADER_CONTENT_LENGTH);
+		ensure_equals("(2)", lookupKnownHeaderId("Content-Length", 14), KNOWN_HEADER_NONE);
+		ensure_equals("(3)", lookupKnownHeaderId("content-lengthx", 15), KNOWN_HEADER_NONE);
+		ensure_equals("(4)", lookupKnownHeaderId("x-foo", 5), KNOWN_HEADER_NONE);
+		ensure_equals("(5)", lookupKnownHeaderId("", 0), KNOWN_HEADER_NONE);
+	}
+
+	TEST_METHOD(12) {
+		set_test_name("Known headers can be looked up and erased by ID");
+		Header *header = (Header *) psg_palloc(pool, sizeof(Header));
+		psg_lstr_init(&header->key);
+		psg_lstr_init(&header->origKey);
+		psg_lstr_init(&header->val);
+		psg_lstr_append(&header->key, pool, "content-");
+		psg_lstr_append(&header->key, pool, "type");
+		psg_lstr_append(&header->origKey, pool, "Content-Type");
+		psg_lstr_append(&header->val, pool, "text/html");
+		header->hash = HashedStaticString("content-type").hash();
+		insertHeader(header, pool);
+		insertHeader(createHeader("host", "foo.com"), pool);
+		insertHeader(createHeader("x-foo", "bar"), pool);
+
+		ensure_equals("(1)", (int) header->knownId, (int) KNOWN_HEADER_CONTENT_TYPE);
+		ensure("(2)", table.lookupHeader(KNOWN_HEADER_CONTENT_TYPE) == header);
+		ensure("(3)", psg_lstr_cmp(table.lookup(KNOWN_HEADER_HOST), "foo.com"));
+		ensure("(4)", table.lookup(KNOWN_HEADER_HOST) == table.lookup("host"));
+		ensure_equals<void *>("(5)", table.lookup(KNOWN_HEADER_CONTENT_LENGTH), NULL);
+
+		table.erase(KNOWN_HEADER_HOST);
+		ensure_equals("(6)", table.size(), 2u);
+		ensure_equals<void *>("(7)", table.lookup(KNOWN_HEADER_HOST), NULL);
+		ensure_equals<void *>("(8)", table.lookup("host"), NULL);
+		ensure("(9)", psg_lstr_cmp(table.lookup("content-type"), "text/html"));
+		ensure("(10)", psg_lstr_cmp(table.lookup("x-foo"), "bar"));
+
+		table.erase(KNOWN_HEADER_HOST);
+		ensure_equals("(11)", table.size(), 2u);
+
+		table.erase(table.lookupCell("content-type"));
+		ensure_equals<void *>("(12)", table.lookupHeader(KNOWN_HEADER_CONTENT_TYPE), NULL);
+	}
+
+	TEST_METHOD(13) {
+		set_test_name("Lookups by ID remain correct after growing, copying and clearing");
+		insertHeader(createHeader("host", "foo.com"), pool);
+		for (unsigned int i = 0; i < 64; i++) {
+			insertHeader(createHeader(psg_pstrdup(pool, "x-header-" + toString(i)),
+				"value"), pool);
+		}
+		ensure("(1)", table.arraySize() > (unsigned int) HeaderTable::DEFAULT_SIZE);
+		ensure("(2)", psg_lstr_cmp(table.lookup(KNOWN_HEADER_HOST), "foo.com"));
+
+		HeaderTable copy;
+		copy = table;
+		ensure("(3)", psg_lstr_cmp(copy.lookup(KNOWN_HEADER_HOST), "foo.com"));
+
+		table.clear();
+		ensure_equals<void *>("(4)", table.lookup(KNOWN_HEADER_HOST), NULL);
+		ensure("(5)", psg_lstr_cmp(copy.lookup(KNOWN_HEADER_HOST), "foo.com"));
+	}
 }
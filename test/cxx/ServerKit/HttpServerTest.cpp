@@ -20,6 +20,15 @@ using namespace std;
 using namespace oxt;
 
 namespace tut {
+	static unsigned int
+	fnv1aHash(const char *data, size_t size) {
+		unsigned int hash = 2166136261u;
+		for (size_t i = 0; i < size; i++) {
+			hash = (hash ^ (unsigned char) data[i]) * 16777619u;
+		}
+		return hash;
+	}
+
 	class MyRequest: public BaseHttpRequest {
 	public:
 		string body;
@@ -143,6 +152,34 @@ namespace tut {
 			// Continues in onRequestEarlyHalfClose()
 		}
 
+		void testLargeAllocation(MyClient *client, MyRequest *req) {
+			const unsigned int size = 8192;
+			char *buffer = (char *) psg_pnalloc(req->pool, size);
+			memset(buffer, 'x', size);
+			writeSimpleResponse(client, 200, NULL, "Allocated " + toString(size));
+			if (!req->ended()) {
+				endRequest(&client, &req);
+			}
+		}
+
+		/**
+		 * Responds with the size and hash of the path and of the Foo header,
+		 * so that arbitrarily large values can be verified.
+		 */
+		void testDigest(MyClient *client, MyRequest *req) {
+			const LString *path = psg_lstr_make_contiguous(&req->path, req->pool);
+			const LString *foo = psg_lstr_make_contiguous(req->headers.lookup("foo"),
+				req->pool);
+			string body = "Path: " + toString(path->size) + " "
+				+ toString(fnv1aHash(path->start->data, path->size))
+				+ "\nFoo: " + toString(foo->size) + " "
+				+ toString(fnv1aHash(foo->start->data, foo->size));
+			writeSimpleResponse(client, 200, NULL, body);
+			if (!req->ended()) {
+				endRequest(&client, &req);
+			}
+		}
+
 		void testEarlyReadErrorDetection(MyClient *client, MyRequest *req) {
 			req->nextRequestEarlyReadError = ENOSPC;
 			writeSimpleResponse(client, 200, NULL, "OK");
@@ -174,6 +211,10 @@ namespace tut {
 				testHalfClose(client, req);
 			} else if (psg_lstr_cmp(&req->path, "/early_read_error_detection_test")) {
 				testEarlyReadErrorDetection(client, req);
+			} else if (psg_lstr_cmp(&req->path, "/large_allocation_test")) {
+				testLargeAllocation(client, req);
+			} else if (req->headers.lookup("digest-test") != NULL) {
+				testDigest(client, req);
 			} else {
 				testRequest(client, req);
 			}
@@ -287,6 +328,9 @@ namespace tut {
 			  context(bg.safe, bg.libuv_loop)
 		{
 			LoggingKit::setLevel(LoggingKit::WARN);
+			if (getenv("SERVER_KIT_TEST_IO_URING") != NULL) {
+				context.enableIoUring();
+			}
 			serverSocket = createUnixServer("tmp.server");
 			server = boost::make_shared<MyServer>(&context, schema);
 			server->initialize();
@@ -454,6 +498,58 @@ namespace tut {
 			server->shutdown();
 		}
 
+		void setClientTimeouts(unsigned int keepalive, unsigned int header,
+			unsigned int body)
+		{
+			Json::Value updates;
+			updates["client_keepalive_timeout"] = keepalive;
+			updates["client_header_timeout"] = header;
+			updates["client_body_timeout"] = body;
+			startLoop();
+			bg.safe->runSync(boost::bind(&ServerKit_HttpServerTest::_setClientTimeouts,
+				this, updates));
+		}
+
+		void _setClientTimeouts(const Json::Value &updates) {
+			vector<ConfigKit::Error> errors;
+			MyServer::ConfigChangeRequest req;
+			context.timerWheel.setResolution(0.05);
+			ensure("Config valid", server->prepareConfigChange(updates, errors, req));
+			server->commitConfigChange(req);
+		}
+
+		Json::Value getMbufSizeClassesState() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&ServerKit_HttpServerTest::_getMbufSizeClassesState,
+				this, &result));
+			return result;
+		}
+
+		void _getMbufSizeClassesState(Json::Value *result) {
+			*result = context.inspectStateAsJson()["mbuf_pool"]["size_classes"];
+		}
+
+		Json::Value getRequestPoolsState() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&ServerKit_HttpServerTest::_getRequestPoolsState,
+				this, &result));
+			return result;
+		}
+
+		void _getRequestPoolsState(Json::Value *result) {
+			*result = server->inspectStateAsJson()["request_pools"];
+		}
+
+		Json::Value findMbufSizeClass(const Json::Value &sizeClasses, unsigned int chunkSize) {
+			Json::Value::const_iterator it, end = sizeClasses.end();
+			for (it = sizeClasses.begin(); it != end; it++) {
+				if ((*it)["chunk_size"].asUInt() == chunkSize) {
+					return *it;
+				}
+			}
+			return Json::Value();
+		}
+
 		string stripHeaders(const string &str) {
 			string::size_type pos = str.find("\r\n\r\n");
 			if (pos == string::npos) {
@@ -483,7 +579,7 @@ namespace tut {
 		}
 	};
 
-	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 100);
+	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 110);
 
 
 	/***** Valid HTTP header parsing *****/
@@ -617,6 +713,41 @@ namespace tut {
 		ensure(containsSubstring(response, "Contiguous: 1"));
 	}
 
+	TEST_METHOD(6) {
+		set_test_name("Long paths and header values, such as large cookies, "
+			"are parsed correctly when split over multiple parts");
+
+		string path = "/" + string(100, 'p') + "?" + string(100, 'q') + "#f";
+		string value;
+		for (unsigned int i = 0; i < 200; i++) {
+			value.append("cookie" + toString(i) + "=" + string(i % 23, 'v') + "; ");
+		}
+		string request =
+			"GET " + path + " HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Digest-Test: 1\r\n"
+			"Cookie: " + value + "\r\n"
+			"Foo: " + value + "\r\n\r\n";
+
+		// Split the request at varying offsets, so that the 16-byte blocks
+		// that the parser scans cross part boundaries at every position.
+		connectToServer();
+		string::size_type pos = 0;
+		unsigned int size = 1;
+		while (pos < request.size()) {
+			sendRequestAndWait(request.substr(pos, size));
+			pos += size;
+			size = size % 31 + 1;
+		}
+
+		string response = readAll(fd);
+		ensure(containsSubstring(response,
+			"Path: " + toString(path.size()) + " "
+			+ toString(fnv1aHash(path.data(), path.size()))
+			+ "\nFoo: " + toString(value.size()) + " "
+			+ toString(fnv1aHash(value.data(), value.size()))));
+	}
+
 
 	/***** Invalid HTTP header parsing *****/
 
@@ -1615,6 +1746,84 @@ namespace tut {
 	}
 
 
+	/***** Client timeouts *****/
+
+	TEST_METHOD(85) {
+		set_test_name("Idle keep-alive connections are disconnected after "
+			"client_keepalive_timeout");
+
+		setClientTimeouts(1, 0, 0);
+		connectToServer();
+		sendRequest(
+			"GET / HTTP/1.1\r\n"
+			"Connection: keep-alive\r\n\r\n");
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+		string response = readAll(fd);
+		MonotonicTimeUsec duration = SystemTime::getMonotonicUsec() - startTime;
+		ensure("(1)", containsSubstring(response, "Connection: keep-alive"));
+		ensure("(2)", containsSubstring(response, "hello /"));
+		ensure("(3)", duration >= 900000);
+		ensure("(4)", duration <= 3000000);
+	}
+
+	TEST_METHOD(86) {
+		set_test_name("Clients that do not send a complete request header are "
+			"disconnected after client_header_timeout");
+
+		LoggingKit::setLevel(LoggingKit::CRIT);
+		setClientTimeouts(0, 1, 0);
+		connectToServer();
+		sendRequest(
+			"GET / HTTP/1.1\r\n"
+			"Connection: keep-alive\r\n");
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+		string response = readAll(fd);
+		MonotonicTimeUsec duration = SystemTime::getMonotonicUsec() - startTime;
+		ensure_equals("(1)", response, "");
+		ensure("(2)", duration >= 900000);
+		ensure("(3)", duration <= 3000000);
+	}
+
+	TEST_METHOD(87) {
+		set_test_name("Clients that stop sending the request body are "
+			"disconnected after client_body_timeout");
+
+		LoggingKit::setLevel(LoggingKit::CRIT);
+		setClientTimeouts(0, 0, 1);
+		connectToServer();
+		sendRequest(
+			"GET /body_test HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 10\r\n\r\n"
+			"ab");
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+		string response = readAll(fd);
+		MonotonicTimeUsec duration = SystemTime::getMonotonicUsec() - startTime;
+		ensure_equals("(1)", response, "");
+		ensure("(2)", duration >= 900000);
+		ensure("(3)", duration <= 3000000);
+	}
+
+	TEST_METHOD(88) {
+		set_test_name("The body timeout is restarted whenever body data is received");
+
+		setClientTimeouts(0, 0, 1);
+		connectToServer();
+		sendRequest(
+			"GET /body_test HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 4\r\n\r\n");
+		for (int i = 0; i < 3; i++) {
+			sendRequest("a");
+			usleep(600000);
+		}
+		sendRequest("b");
+		string response = readAll(fd);
+		ensure("(1)", containsSubstring(response, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(response, "4 bytes: aaab"));
+	}
+
+
 	/***** Miscellaneous *****/
 
 	TEST_METHOD(90) {
@@ -1730,4 +1939,71 @@ namespace tut {
 			result = getActiveClientCount() == 0;
 		);
 	}
+
+	TEST_METHOD(98) {
+		set_test_name("Small requests are read into small buffers");
+
+		connectToServer();
+		sendRequest(
+			"GET / HTTP/1.1\r\n"
+			"Connection: keep-alive\r\n\r\n");
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+
+		if (!context.usingIoUring()) {
+			Json::Value sizeClass = findMbufSizeClass(getMbufSizeClassesState(), 512);
+			ensure("(2)", !sizeClass.isNull());
+			ensure("(3)", sizeClass["active_blocks"].asUInt() > 0);
+		}
+	}
+
+	TEST_METHOD(99) {
+		set_test_name("Request bodies with a known length are read into buffers that fit them");
+
+		connectToServer();
+		sendRequest(
+			"GET /body_test HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 20000\r\n\r\n");
+		sendRequest(string(20000, 'x'));
+		string response = readAll(fd);
+		ensure("(1)", containsSubstring(response, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(response, "20000 bytes: xxx"));
+
+		if (!context.usingIoUring()) {
+			Json::Value sizeClass = findMbufSizeClass(getMbufSizeClassesState(), 16384);
+			ensure(!sizeClass.isNull());
+		}
+	}
+
+	TEST_METHOD(100) {
+		set_test_name("It keeps statistics about request palloc pool usage");
+
+		for (int i = 0; i < 3; i++) {
+			connectToServer();
+			sendRequest(
+				"GET /large_allocation_test HTTP/1.1\r\n"
+				"Connection: close\r\n\r\n");
+			string response = readAll(fd);
+			ensure("(1)", containsSubstring(response, "Allocated 8192"));
+		}
+
+		EVENTUALLY(5,
+			Json::Value doc = getRequestPoolsState();
+			Json::UInt64 total = 0;
+			for (unsigned int i = 0; i < doc["usage_histogram"].size(); i++) {
+				total += doc["usage_histogram"][i]["count"].asUInt64();
+			}
+			result = total == 3;
+		);
+
+		// Every request allocates an 8 KB buffer. The first one doesn't
+		// fit in a default-sized pool, but after that the pool is sized
+		// to fit it.
+		Json::Value doc = getRequestPoolsState();
+		ensure("(2)", doc["pool_size"]["bytes"].asUInt() > (unsigned int) PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(3)", doc["large_allocations_histogram"][0u]["count"].asUInt(), 2u);
+		ensure_equals("(4)", doc["large_allocations_histogram"][1u]["count"].asUInt(), 1u);
+		ensure("(5)", doc.isMember("average_usage"));
+	}
 }
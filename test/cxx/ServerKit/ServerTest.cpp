@@ -63,6 +63,16 @@ namespace tut {
 			server->listen(serverSocket1);
 		}
 
+		bool initIoUring() {
+			string error;
+			if (context.enableIoUring(&error)) {
+				return true;
+			} else {
+				P_WARN("Skipping test because io_uring is not available: " << error);
+				return false;
+			}
+		}
+
 		template<typename ServerClass>
 		void initWithServerClass() {
 			server = boost::make_shared<ServerClass>(&context, schema, config);
@@ -446,4 +456,73 @@ namespace tut {
 			result = !clientIsConnected(client.get());
 		);
 	}
+
+
+	/***** io_uring I/O engine *****/
+
+	TEST_METHOD(40) {
+		set_test_name("io_uring: accepting new clients on multiple endpoints works");
+
+		if (!initIoUring()) {
+			return;
+		}
+		init();
+		server->listen(serverSocket2);
+		startServer();
+
+		FileDescriptor fd1(connectToServer1());
+		FileDescriptor fd2(connectToServer2());
+		EVENTUALLY(5,
+			result = getActiveClientCount() == 2u;
+		);
+	}
+
+	TEST_METHOD(41) {
+		set_test_name("io_uring: input is made available through client->input");
+
+		if (!initIoUring()) {
+			return;
+		}
+		initWithServerClass<Test25Server>();
+		startServer();
+
+		string data;
+		for (unsigned int i = 0; i < 1024 * 1024; i++) {
+			data.append(1, (char) ('a' + i % 26));
+		}
+
+		FileDescriptor fd(connectToServer1());
+		writeExact(fd, data);
+
+		EVENTUALLY(5,
+			Test25Server *s = (Test25Server *) server.get();
+			boost::lock_guard<boost::mutex> l(s->syncher);
+			result = s->data.size() == data.size();
+		);
+		Test25Server *s = (Test25Server *) server.get();
+		boost::lock_guard<boost::mutex> l(s->syncher);
+		ensure(s->data == data);
+	}
+
+	TEST_METHOD(42) {
+		set_test_name("io_uring: when a client disconnects, client->connected() becomes false");
+
+		if (!initIoUring()) {
+			return;
+		}
+		init();
+		startServer();
+
+		FileDescriptor fd(connectToServer1());
+		EVENTUALLY(5,
+			result = getActiveClientCount() == 1u;
+		);
+
+		ClientRefType client = getActiveClients()[0];
+		ensure(clientIsConnected(client.get()));
+		fd.close();
+		EVENTUALLY(5,
+			result = !clientIsConnected(client.get());
+		);
+	}
 }
@@ -0,0 +1,150 @@
+#include <TestSupport.h>
+#include <ServerKit/TimerWheel.h>
+#include <vector>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_TimerWheelTest {
+		struct ev_loop *loop;
+		TimerWheel *wheel;
+		ev_tstamp startTime;
+		vector<TimerWheel::Timer *> fired;
+		TimerWheel::Timer timers[3];
+
+		ServerKit_TimerWheelTest() {
+			loop = ev_loop_new(EVFLAG_AUTO);
+			wheel = new TimerWheel(loop, 0.1);
+			startTime = ev_now(loop);
+			for (unsigned int i = 0; i < 3; i++) {
+				timers[i].callback = onTimeout;
+				timers[i].userData = this;
+			}
+		}
+
+		~ServerKit_TimerWheelTest() {
+			delete wheel;
+			ev_loop_destroy(loop);
+		}
+
+		static void onTimeout(TimerWheel::Timer *timer) {
+			ServerKit_TimerWheelTest *self =
+				static_cast<ServerKit_TimerWheelTest *>(timer->userData);
+			self->fired.push_back(timer);
+		}
+
+		static void onTimeoutCancelOthers(TimerWheel::Timer *timer) {
+			ServerKit_TimerWheelTest *self =
+				static_cast<ServerKit_TimerWheelTest *>(timer->userData);
+			self->fired.push_back(timer);
+			self->wheel->cancel(&self->timers[1]);
+			self->wheel->schedule(&self->timers[2], 1);
+		}
+
+		void tickAt(ev_tstamp time) {
+			wheel->tick(startTime + time);
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_TimerWheelTest);
+
+	TEST_METHOD(1) {
+		set_test_name("A timer fires once its timeout has passed, but not earlier");
+		wheel->schedule(&timers[0], 1);
+		ensure("(1)", timers[0].armed());
+		ensure_equals("(2)", wheel->size(), 1u);
+
+		tickAt(0.5);
+		tickAt(1.0);
+		ensure_equals("(3)", fired.size(), 0u);
+		tickAt(1.1);
+		ensure_equals("(4)", fired.size(), 1u);
+		ensure("(5)", fired[0] == &timers[0]);
+		ensure("(6)", !timers[0].armed());
+		ensure("(7)", wheel->empty());
+
+		tickAt(5);
+		ensure_equals("(8)", fired.size(), 1u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Cancelled timers do not fire and re-armed timers fire at their new time");
+		wheel->schedule(&timers[0], 1);
+		wheel->schedule(&timers[1], 1);
+		wheel->cancel(&timers[0]);
+		ensure("(1)", !timers[0].armed());
+		ensure_equals("(2)", wheel->size(), 1u);
+
+		tickAt(0.5);
+		wheel->schedule(&timers[1], 1);
+		tickAt(1.1);
+		ensure_equals("(3)", fired.size(), 0u);
+		tickAt(1.6);
+		ensure_equals("(4)", fired.size(), 1u);
+		ensure("(5)", fired[0] == &timers[1]);
+
+		wheel->cancel(&timers[1]);
+		ensure("(6)", wheel->empty());
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Timeouts longer than one revolution of the wheel");
+		// 100 seconds at a resolution of 0.1 is almost two revolutions.
+		wheel->schedule(&timers[0], 100);
+		wheel->schedule(&timers[1], 1);
+
+		for (unsigned int i = 1; i <= 1000; i++) {
+			tickAt(i * 0.1);
+		}
+		ensure_equals("(1)", fired.size(), 1u);
+		ensure("(2)", fired[0] == &timers[1]);
+
+		tickAt(100.1);
+		ensure_equals("(3)", fired.size(), 2u);
+		ensure("(4)", fired[1] == &timers[0]);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Timers expire correctly when the wheel is advanced by "
+			"more than one revolution at once");
+		wheel->schedule(&timers[0], 100);
+		wheel->schedule(&timers[1], 1);
+		wheel->schedule(&timers[2], 300);
+
+		tickAt(70);
+		ensure_equals("(1)", fired.size(), 1u);
+		ensure("(2)", fired[0] == &timers[1]);
+
+		tickAt(150);
+		ensure_equals("(3)", fired.size(), 2u);
+		ensure("(4)", fired[1] == &timers[0]);
+
+		tickAt(299);
+		ensure_equals("(5)", fired.size(), 2u);
+		tickAt(301);
+		ensure_equals("(6)", fired.size(), 3u);
+		ensure("(7)", fired[2] == &timers[2]);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Callbacks may cancel and schedule other timers, "
+			"including ones that expired in the same tick");
+		timers[0].callback = onTimeoutCancelOthers;
+		wheel->schedule(&timers[0], 1);
+		wheel->schedule(&timers[1], 1);
+		wheel->schedule(&timers[2], 1);
+
+		tickAt(1.1);
+		ensure_equals("(1)", fired.size(), 1u);
+		ensure("(2)", fired[0] == &timers[0]);
+		ensure("(3)", !timers[1].armed());
+		ensure("(4)", timers[2].armed());
+		ensure_equals("(5)", wheel->size(), 1u);
+
+		tickAt(2.2);
+		ensure_equals("(6)", fired.size(), 2u);
+		ensure("(7)", fired[1] == &timers[2]);
+	}
+}
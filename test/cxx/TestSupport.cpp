@@ -7,11 +7,118 @@
 #include <fcntl.h>
 #include <pwd.h>
 #include <grp.h>
+#include <cstdlib>
+#ifdef __GLIBC__
+	#include <execinfo.h>
+#endif
 #include <cassert>
 #include <Utils/IOUtils.h>
 #include <Utils/ScopeGuard.h>
 #include <jsoncpp/json.h>
 
+
+/***** Heap allocation counting *****/
+
+#ifdef __GLIBC__
+	static __thread bool allocationCountingEnabled = false;
+	static __thread bool allocationTracingEnabled = false;
+	static __thread unsigned long long allocationCount = 0;
+
+	extern "C" {
+		extern void *__libc_malloc(size_t size);
+		extern void *__libc_calloc(size_t nmemb, size_t size);
+		extern void *__libc_realloc(void *ptr, size_t size);
+		extern void *__libc_memalign(size_t alignment, size_t size);
+		extern void *__libc_valloc(size_t size);
+		extern void *__libc_pvalloc(size_t size);
+	}
+
+	static void
+	countAllocation() {
+		if (OXT_LIKELY(!allocationCountingEnabled)) {
+			return;
+		}
+		allocationCount++;
+		if (allocationTracingEnabled) {
+			// backtrace() may allocate the first time it's called.
+			void *frames[32];
+			int nframes;
+
+			allocationCountingEnabled = false;
+			nframes = backtrace(frames, 32);
+			if (write(STDERR_FILENO, "--- Allocation:\n", sizeof("--- Allocation:\n") - 1) != -1) {
+				backtrace_symbols_fd(frames, nframes, STDERR_FILENO);
+			}
+			allocationCountingEnabled = true;
+		}
+	}
+
+	extern "C" void *
+	malloc(size_t size) {
+		countAllocation();
+		return __libc_malloc(size);
+	}
+
+	extern "C" void *
+	calloc(size_t nmemb, size_t size) {
+		countAllocation();
+		return __libc_calloc(nmemb, size);
+	}
+
+	extern "C" void *
+	realloc(void *ptr, size_t size) {
+		countAllocation();
+		return __libc_realloc(ptr, size);
+	}
+
+	extern "C" void *
+	memalign(size_t alignment, size_t size) {
+		countAllocation();
+		return __libc_memalign(alignment, size);
+	}
+
+	// glibc's aligned_alloc() is an alias of memalign().
+	extern "C" void *
+	aligned_alloc(size_t alignment, size_t size) {
+		countAllocation();
+		return __libc_memalign(alignment, size);
+	}
+
+	extern "C" void *
+	valloc(size_t size) {
+		countAllocation();
+		return __libc_valloc(size);
+	}
+
+	extern "C" void *
+	pvalloc(size_t size) {
+		countAllocation();
+		return __libc_pvalloc(size);
+	}
+
+	extern "C" int
+	posix_memalign(void **memptr, size_t alignment, size_t size) {
+		void *result;
+
+		// The alignment must be a power of two multiple of sizeof(void *).
+		if (alignment % sizeof(void *) != 0
+		 || (alignment & (alignment - 1)) != 0
+		 || alignment == 0)
+		{
+			return EINVAL;
+		}
+
+		countAllocation();
+		result = __libc_memalign(alignment, size);
+		if (result == NULL) {
+			return ENOMEM;
+		} else {
+			*memptr = result;
+			return 0;
+		}
+	}
+#endif
+
 namespace TestSupport {
 
 ResourceLocator *resourceLocator = NULL;
@@ -172,5 +279,48 @@ getPrimaryGroupName(const string &username) {
 	return group->gr_name;
 }
 
+bool
+allocationCountingSupported() {
+	#ifdef __GLIBC__
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+void
+startCountingAllocations() {
+	#ifdef __GLIBC__
+		allocationCount = 0;
+		allocationTracingEnabled = getenv("TRACE_ALLOCATIONS") != NULL;
+		allocationCountingEnabled = true;
+	#endif
+}
+
+unsigned long long
+stopCountingAllocations() {
+	#ifdef __GLIBC__
+		allocationCountingEnabled = false;
+		return allocationCount;
+	#else
+		return 0;
+	#endif
+}
+
+AllocationCountingSuspender::AllocationCountingSuspender() {
+	#ifdef __GLIBC__
+		oldEnabled = allocationCountingEnabled;
+		allocationCountingEnabled = false;
+	#else
+		oldEnabled = false;
+	#endif
+}
+
+AllocationCountingSuspender::~AllocationCountingSuspender() {
+	#ifdef __GLIBC__
+		allocationCountingEnabled = oldEnabled;
+	#endif
+}
+
 
 } // namespace TestSupport
@@ -156,6 +156,26 @@ vector<string> listDir(const string &path);
  */
 string getPrimaryGroupName(const string &username);
 
+/**
+ * Returns whether heap allocation counting is supported on this platform.
+ * It works by interposing malloc() and friends, which we only do on glibc.
+ */
+bool allocationCountingSupported();
+
+/**
+ * Starts counting heap allocations made by the calling thread. Allocations
+ * made by other threads are not counted. If the environment variable
+ * `TRACE_ALLOCATIONS` is set, a backtrace is printed to stderr for every
+ * counted allocation, which helps finding out where they come from.
+ */
+void startCountingAllocations();
+
+/**
+ * Stops counting heap allocations made by the calling thread, and returns
+ * the number of allocations since `startCountingAllocations()`.
+ */
+unsigned long long stopCountingAllocations();
+
 
 /**
  * Class which creates a temporary directory of the given name, and deletes
@@ -267,6 +287,19 @@ public:
 };
 
 
+/**
+ * Temporarily stops counting heap allocations made by the calling thread,
+ * e.g. to exclude test fixtures from a measurement.
+ */
+class AllocationCountingSuspender {
+private:
+	bool oldEnabled;
+public:
+	AllocationCountingSuspender();
+	~AllocationCountingSuspender();
+};
+
+
 class AtomicInt {
 private:
 	mutable boost::mutex lock;
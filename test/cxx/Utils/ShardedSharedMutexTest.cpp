@@ -0,0 +1,144 @@
+#include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <Utils/ShardedSharedMutex.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Utils_ShardedSharedMutexTest {
+		ShardedSharedMutex mutex;
+		boost::mutex syncher;
+		boost::condition_variable cond;
+		bool holding;
+		bool release;
+
+		// Protected by `mutex`.
+		unsigned int counter1;
+		unsigned int counter2;
+		boost::atomic<unsigned int> inconsistencies;
+
+		Utils_ShardedSharedMutexTest()
+			: holding(false),
+			  release(false),
+			  counter1(0),
+			  counter2(0),
+			  inconsistencies(0)
+			{ }
+
+		void holdSharedLock() {
+			boost::shared_lock<ShardedSharedMutex> l(mutex);
+			boost::unique_lock<boost::mutex> l2(syncher);
+			holding = true;
+			cond.notify_all();
+			while (!release) {
+				cond.wait(l2);
+			}
+		}
+
+		void holdExclusiveLock() {
+			boost::unique_lock<ShardedSharedMutex> l(mutex);
+			boost::unique_lock<boost::mutex> l2(syncher);
+			holding = true;
+			cond.notify_all();
+			while (!release) {
+				cond.wait(l2);
+			}
+		}
+
+		void waitUntilHolding() {
+			boost::unique_lock<boost::mutex> l(syncher);
+			while (!holding) {
+				cond.wait(l);
+			}
+		}
+
+		void releaseHolder(boost::thread &thr) {
+			{
+				boost::lock_guard<boost::mutex> l(syncher);
+				release = true;
+				cond.notify_all();
+			}
+			thr.join();
+		}
+
+		void work(unsigned int iterations) {
+			for (unsigned int i = 0; i < iterations; i++) {
+				if (i % 8 == 0) {
+					boost::lock_guard<ShardedSharedMutex> l(mutex);
+					counter1++;
+					counter2++;
+				} else {
+					boost::shared_lock<ShardedSharedMutex> l(mutex);
+					if (counter1 != counter2) {
+						inconsistencies++;
+					}
+				}
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(Utils_ShardedSharedMutexTest);
+
+	TEST_METHOD(1) {
+		set_test_name("An exclusive lock excludes both shared and exclusive locks");
+		boost::thread thr(boost::bind(&Utils_ShardedSharedMutexTest::holdExclusiveLock, this));
+		waitUntilHolding();
+		ensure("(1)", !mutex.try_lock_shared());
+		ensure("(2)", !mutex.try_lock());
+		releaseHolder(thr);
+		ensure("(3)", mutex.try_lock_shared());
+		mutex.unlock_shared();
+		ensure("(4)", mutex.try_lock());
+		mutex.unlock();
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("A shared lock excludes exclusive locks but not other shared locks");
+		boost::thread thr(boost::bind(&Utils_ShardedSharedMutexTest::holdSharedLock, this));
+		waitUntilHolding();
+		ensure("(1)", !mutex.try_lock());
+		ensure("(2)", mutex.try_lock_shared());
+		mutex.unlock_shared();
+		releaseHolder(thr);
+		ensure("(3)", mutex.try_lock());
+		mutex.unlock();
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("lock() waits until all shared locks have been released");
+		boost::thread thr(boost::bind(&Utils_ShardedSharedMutexTest::holdSharedLock, this));
+		waitUntilHolding();
+
+		boost::thread writer(boost::bind(&Utils_ShardedSharedMutexTest::work, this, 1));
+		SHOULD_NEVER_HAPPEN(100,
+			result = counter1 != 0;
+		);
+		releaseHolder(thr);
+		writer.join();
+		ensure_equals(counter1, 1u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Mixed shared and exclusive locking under contention, for various thread counts");
+		unsigned int threadCounts[] = { 1, 2, 4, 8, 16, 64 };
+		const unsigned int iterations = 8000;
+		unsigned int expectedWrites = 0;
+
+		for (unsigned int i = 0; i < sizeof(threadCounts) / sizeof(unsigned int); i++) {
+			boost::thread_group threads;
+			for (unsigned int j = 0; j < threadCounts[i]; j++) {
+				threads.create_thread(boost::bind(&Utils_ShardedSharedMutexTest::work,
+					this, iterations));
+			}
+			threads.join_all();
+			expectedWrites += threadCounts[i] * iterations / 8;
+
+			ensure_equals("Readers never observe a half-finished write",
+				inconsistencies.load(), 0u);
+			ensure_equals("No write is lost", counter1, expectedWrites);
+			ensure_equals(counter2, expectedWrites);
+		}
+	}
+}
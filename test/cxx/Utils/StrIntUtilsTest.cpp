@@ -41,5 +41,25 @@ namespace tut {
 		snprintf(s, 10, "h\xeallo"); // hêllo
 		string result = escapeHTML(s);
 		ensure_equals(result, "h?llo");
+	} TEST_METHOD(5) {
+		set_test_name("convertLowerCase() downcases ASCII letters only");
+		string input, expected;
+		for (unsigned int i = 0; i < 256; i++) {
+			input.append(1, (char) i);
+			if (i >= 'A' && i <= 'Z') {
+				expected.append(1, (char) (i + 'a' - 'A'));
+			} else {
+				expected.append(1, (char) i);
+			}
+		}
+		for (string::size_type len = 0; len <= input.size(); len++) {
+			for (string::size_type offset = 0; offset < 3 && offset <= len; offset++) {
+				string output(len - offset, '\0');
+				convertLowerCase((const unsigned char *) input.data() + offset,
+					(unsigned char *) &output[0], len - offset);
+				ensure_equals(("len=" + toString(len) + " offset=" + toString(offset)).c_str(),
+					output, expected.substr(offset, len - offset));
+			}
+		}
 	}
 }